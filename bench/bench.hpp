@@ -0,0 +1,448 @@
+#ifndef SMATH_BENCH_HPP
+#define SMATH_BENCH_HPP
+/*
+    Micro benchmark harness of smath_bench.
+
+    Every measurement warms up first, then calibrates how many calls make a
+    sample of at least min_sample_time and records samples of that many
+    calls. The reported time is per item (one call may process a whole
+    batch of items), summarized by median, mean, min and percentiles over
+    the samples. Results escape through do_not_optimize so the optimizer
+    cannot drop or hoist the measured work. Where Linux perf counters are
+    available, cycles, instructions, branch and L1 misses per item are
+    counted over the same samples.
+
+    BENCH(name) { ... } registers a group, like TEST in test_tool.hpp; the
+    body calls Bench::run / Bench::map once per measured operation.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCH(group_name)                                                      \
+    static void bench_body_##group_name(smath::bench::Bench &);                \
+    static const bool registered_bench_##group_name = []() {                   \
+        smath::bench::Registry::instance().add(#group_name,                    \
+                                               &bench_body_##group_name);      \
+        return true;                                                           \
+    }();                                                                       \
+    static void bench_body_##group_name(smath::bench::Bench &b)
+
+namespace smath::bench {
+/***************************************
+        Optimization barriers
+***************************************/
+/**
+ * @brief Make the compiler assume value is read (and for a non-const
+ * reference, modified) here, without emitting any instruction.
+ */
+template <class T> inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void *)) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    } else {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+template <class T> inline void do_not_optimize(T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void *)) {
+        asm volatile("" : "+r,m"(value) : : "memory");
+    } else {
+        asm volatile("" : "+m"(value) : : "memory");
+    }
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+/**
+ * @brief Force pending memory writes to be treated as observed.
+ */
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/***************************************
+        Inputs
+***************************************/
+/**
+ * @brief Small deterministic generator so every run sees the same inputs.
+ */
+class Random {
+  private:
+    std::uint64_t state;
+
+  public:
+    explicit Random(std::uint64_t seed = 0x9E3779B97F4A7C15ull) : state(seed) {}
+    std::uint32_t next() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<std::uint32_t>(state >> 33);
+    }
+    /**
+     * @return Uniform value in [low, high).
+     */
+    template <class T> T uniform(T low, T high) {
+        const double unit = static_cast<double>(next()) / 2147483648.0;
+        return static_cast<T>(low + (high - low) * unit);
+    }
+};
+
+/***************************************
+        Hardware counters
+***************************************/
+/*
+    Counters of the calling thread through Linux perf_event_open, user
+    space only: cycles, instructions, branch misses and L1 data cache read
+    misses. They are opened as one group under the first event that opens
+    (normally cycles), so all of them count over exactly the same window
+    and are read together; IPC is never a ratio of two multiplexed
+    estimates. An event the system does not offer (not Linux, a VM or
+    container without a PMU, perf_event_paranoid above 2) stays missing.
+*/
+class PerfCounters {
+  public:
+    enum Event { cycles, instructions, branch_misses, l1_misses, event_count };
+    struct Sample {
+        std::optional<double> value[event_count];
+    };
+    static constexpr const char *names[event_count] = {"cycles", "instructions",
+                                                       "branch_misses", "l1d_read_misses"};
+
+  private:
+    int leader = -1;
+    int fd[event_count] = {-1, -1, -1, -1};
+    // Events in group order, the order a group read returns them.
+    Event order[event_count] = {};
+    std::size_t opened = 0;
+
+  public:
+    PerfCounters() {
+#if defined(__linux__)
+        const std::uint32_t type[event_count] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                                 PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+        const std::uint64_t config[event_count] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+        for (int e = 0; e < event_count; e++) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = type[e];
+            attr.config = config[e];
+            // Members follow the leader, only the leader starts disabled.
+            attr.disabled = leader < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            // Scaled by enabled / running time when the PMU is multiplexed,
+            // the whole group is scheduled at once so one factor fits all.
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fd[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+            if (fd[e] < 0)
+                continue;
+            if (leader < 0)
+                leader = fd[e];
+            order[opened++] = static_cast<Event>(e);
+        }
+#endif
+    }
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    ~PerfCounters() {
+#if defined(__linux__)
+        // Members before the leader.
+        for (int e = event_count - 1; e >= 0; e--) {
+            if (fd[e] >= 0)
+                close(fd[e]);
+        }
+#endif
+    }
+    bool available() const { return leader >= 0; }
+    void start() {
+#if defined(__linux__)
+        if (leader >= 0) {
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+    void stop() {
+#if defined(__linux__)
+        if (leader >= 0)
+            ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+    Sample read_sample() const {
+        Sample sample;
+#if defined(__linux__)
+        // nr, time enabled, time running, then one value per event.
+        std::uint64_t data[3 + event_count] = {};
+        const auto bytes = static_cast<ssize_t>((3 + opened) * sizeof(std::uint64_t));
+        if (leader < 0 || read(leader, data, sizeof(data)) != bytes || data[0] != opened ||
+            data[2] == 0)
+            return sample;
+        const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        for (std::size_t k = 0; k < opened; k++) {
+            sample.value[order[k]] = static_cast<double>(data[3 + k]) * scale;
+        }
+#endif
+        return sample;
+    }
+};
+
+/***************************************
+        Results
+***************************************/
+struct Config {
+    std::chrono::nanoseconds warmup = std::chrono::milliseconds(20);
+    std::chrono::nanoseconds min_sample_time = std::chrono::milliseconds(1);
+    std::size_t samples = 25;
+    std::string filter;
+};
+
+struct Result {
+    std::string name;
+    std::size_t items_per_call = 1;
+    std::uint64_t calls_per_sample = 0;
+    // Nanoseconds per item, one entry per sample, sorted ascending.
+    std::vector<double> ns_per_item;
+    // Counter events per item over all samples, empty where unavailable.
+    std::optional<double> per_item[PerfCounters::event_count];
+
+    double min() const { return ns_per_item.front(); }
+    double mean() const {
+        double sum = 0;
+        for (double ns : ns_per_item)
+            sum += ns;
+        return sum / static_cast<double>(ns_per_item.size());
+    }
+    double stddev() const {
+        const double m = mean();
+        double sum = 0;
+        for (double ns : ns_per_item)
+            sum += (ns - m) * (ns - m);
+        return ns_per_item.size() > 1
+                   ? std::sqrt(sum / static_cast<double>(ns_per_item.size() - 1))
+                   : 0.0;
+    }
+    /**
+     * @return Linearly interpolated percentile, p in [0, 100].
+     */
+    double percentile(double p) const {
+        const double rank = p / 100 * static_cast<double>(ns_per_item.size() - 1);
+        const std::size_t low = static_cast<std::size_t>(rank);
+        const std::size_t high = std::min(low + 1, ns_per_item.size() - 1);
+        return ns_per_item[low] +
+               (ns_per_item[high] - ns_per_item[low]) * (rank - static_cast<double>(low));
+    }
+    double median() const { return percentile(50); }
+    /**
+     * @return Items per second at the median.
+     */
+    double throughput() const { return 1e9 / median(); }
+    /**
+     * @return Instructions per cycle, both counted in the same group.
+     */
+    std::optional<double> ipc() const {
+        const auto &c = per_item[PerfCounters::cycles];
+        const auto &i = per_item[PerfCounters::instructions];
+        if (!c || !i || *c <= 0)
+            return std::nullopt;
+        return *i / *c;
+    }
+};
+
+/***************************************
+        Measurement
+***************************************/
+class Bench {
+  private:
+    using Clock = std::chrono::steady_clock;
+    Config config;
+    std::string group;
+    std::vector<Result> results;
+    PerfCounters counters;
+
+    template <class F> static double time_calls(F &op, std::uint64_t calls) {
+        const Clock::time_point start = Clock::now();
+        for (std::uint64_t i = 0; i < calls; i++) {
+            op();
+        }
+        clobber_memory();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+  public:
+    Bench(const Config &config, std::string group)
+        : config(config), group(std::move(group)) {}
+
+    /**
+     * @brief Measure op, one call processing items items.
+     */
+    template <class F> void run(std::string_view name, std::size_t items, F &&op) {
+        std::string full_name = group + "/" + std::string(name);
+        if (!config.filter.empty() && full_name.find(config.filter) == std::string::npos)
+            return;
+        // Warmup, which also gives the first estimate of a call's cost.
+        std::uint64_t calls = 0;
+        double elapsed = 0;
+        std::uint64_t batch = 1;
+        do {
+            elapsed += time_calls(op, batch);
+            calls += batch;
+            batch *= 2;
+        } while (elapsed < static_cast<double>(config.warmup.count()));
+        const double per_call = elapsed / static_cast<double>(calls);
+        const double target = static_cast<double>(config.min_sample_time.count());
+        Result result;
+        result.name = std::move(full_name);
+        result.items_per_call = items;
+        result.calls_per_sample =
+            std::max<std::uint64_t>(1, static_cast<std::uint64_t>(target / per_call));
+        PerfCounters::Sample total;
+        double counted_items[PerfCounters::event_count] = {};
+        for (std::size_t s = 0; s < config.samples; s++) {
+            counters.start();
+            const double ns = time_calls(op, result.calls_per_sample);
+            counters.stop();
+            const PerfCounters::Sample sample = counters.read_sample();
+            for (int e = 0; e < PerfCounters::event_count; e++) {
+                if (!sample.value[e])
+                    continue;
+                total.value[e] = total.value[e].value_or(0) + *sample.value[e];
+                counted_items[e] += static_cast<double>(result.calls_per_sample * items);
+            }
+            result.ns_per_item.push_back(
+                ns / static_cast<double>(result.calls_per_sample * items));
+        }
+        std::sort(result.ns_per_item.begin(), result.ns_per_item.end());
+        for (int e = 0; e < PerfCounters::event_count; e++) {
+            if (total.value[e])
+                result.per_item[e] = *total.value[e] / counted_items[e];
+        }
+        print(result, counters.available());
+        results.push_back(std::move(result));
+    }
+    /**
+     * @brief Measure f over every input, each result escaping on its own
+     * so calls are not merged across elements.
+     */
+    template <class A, class F>
+    void map(std::string_view name, const std::vector<A> &a, F &&f) {
+        run(name, a.size(), [&] {
+            for (const A &x : a) {
+                auto result = f(x);
+                do_not_optimize(result);
+            }
+        });
+    }
+    template <class A, class B, class F>
+    void map(std::string_view name, const std::vector<A> &a, const std::vector<B> &b,
+             F &&f) {
+        const std::size_t n = std::min(a.size(), b.size());
+        run(name, n, [&] {
+            for (std::size_t i = 0; i < n; i++) {
+                auto result = f(a[i], b[i]);
+                do_not_optimize(result);
+            }
+        });
+    }
+    const std::vector<Result> &get_results() const { return results; }
+
+    /**
+     * @param with_counters Add cycles/op, IPC, branch and L1 misses/op.
+     */
+    static void print_header(bool with_counters) {
+        std::cout << std::left << std::setw(48) << "benchmark" << std::right
+                  << std::setw(11) << "ns/op" << std::setw(11) << "mean"
+                  << std::setw(11) << "min" << std::setw(11) << "p90"
+                  << std::setw(11) << "p99" << std::setw(14) << "Mop/s";
+        if (with_counters) {
+            std::cout << std::setw(11) << "cycles/op" << std::setw(7) << "IPC"
+                      << std::setw(11) << "br-miss/op" << std::setw(11) << "L1-miss/op";
+        }
+        std::cout << "\n";
+    }
+    static void print(const Result &r, bool with_counters) {
+        std::cout << std::left << std::setw(48) << r.name << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(11) << r.median()
+                  << std::setw(11) << r.mean() << std::setw(11) << r.min()
+                  << std::setw(11) << r.percentile(90) << std::setw(11)
+                  << r.percentile(99) << std::setw(14) << std::setprecision(2)
+                  << r.throughput() / 1e6;
+        if (with_counters) {
+            const auto column = [](int width, int precision, std::optional<double> value) {
+                std::cout << std::setw(width);
+                if (value)
+                    std::cout << std::setprecision(precision) << *value;
+                else
+                    std::cout << "-";
+            };
+            column(11, 2, r.per_item[PerfCounters::cycles]);
+            column(7, 2, r.ipc());
+            column(11, 4, r.per_item[PerfCounters::branch_misses]);
+            column(11, 4, r.per_item[PerfCounters::l1_misses]);
+        }
+        std::cout << "\n";
+    }
+};
+
+/***************************************
+        Registry
+***************************************/
+class Registry {
+  private:
+    struct Group {
+        const char *name;
+        void (*body)(Bench &);
+    };
+    std::vector<Group> groups;
+
+  public:
+    static Registry &instance() {
+        static Registry registry;
+        return registry;
+    }
+    void add(const char *name, void (*body)(Bench &)) { groups.push_back({name, body}); }
+    /**
+     * @brief Run every registered group, groups in registration order.
+     */
+    std::vector<Result> run(const Config &config) {
+        std::vector<Result> results;
+        Bench::print_header(PerfCounters().available());
+        for (const Group &group : groups) {
+            Bench bench(config, group.name);
+            group.body(bench);
+            const std::vector<Result> &done = bench.get_results();
+            results.insert(results.end(), done.begin(), done.end());
+        }
+        return results;
+    }
+};
+} // namespace smath::bench
+#endif // SMATH_BENCH_HPP
@@ -0,0 +1,160 @@
+/*
+    smath_bench entry point, build with -DSMATH_BUILD_BENCH=ON.
+
+    smath_bench [--filter=substring] [--samples=N] [--min-time-ms=N]
+                [--warmup-ms=N] [--json=file] [--csv=file] [--label=text]
+    smath_bench --compare=baseline,current [--threshold=percent] [--alpha=p]
+
+    --compare reads two result files (JSON or CSV), prints every benchmark
+    present in both and exits with failure when one is significantly slower
+    or when a benchmark of the baseline is missing from the current file.
+*/
+#include "bench.hpp"
+#include "report.hpp"
+#include "simd.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+#ifndef SMATH_BENCH_FLAGS
+#define SMATH_BENCH_FLAGS "unknown"
+#endif
+
+using namespace smath::bench;
+
+static bool parse_flag(std::string_view arg, std::string_view flag, std::string_view &value) {
+    if (arg.size() <= flag.size() + 1 || arg.substr(0, flag.size()) != flag ||
+        arg[flag.size()] != '=')
+        return false;
+    value = arg.substr(flag.size() + 1);
+    return true;
+}
+
+static std::string simd_level() {
+#if defined(SMATH_AVX2) && defined(SMATH_FMA)
+    return "avx2+fma";
+#elif defined(SMATH_AVX2)
+    return "avx2";
+#elif defined(SMATH_AVX)
+    return "avx";
+#elif defined(SMATH_SSE)
+    return "sse";
+#else
+    return "none";
+#endif
+}
+
+template <class Writer>
+static bool write_file(const std::string &path, const Context &context,
+                       const std::vector<Result> &results, Writer &&writer) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot write " << path << "\n";
+        return false;
+    }
+    writer(out, context, results);
+    return static_cast<bool>(out);
+}
+
+static int run_compare(const std::string &files, double threshold, double alpha) {
+    const std::size_t comma = files.find(',');
+    if (comma == std::string::npos) {
+        std::cerr << "--compare expects baseline,current\n";
+        return EXIT_FAILURE;
+    }
+    try {
+        const ResultFile baseline = read_results(files.substr(0, comma));
+        const ResultFile current = read_results(files.substr(comma + 1));
+        for (const auto &[name, file] : {std::pair{"baseline", &baseline},
+                                         std::pair{"current", &current}}) {
+            const auto label = file->context.find("label");
+            const auto compiler = file->context.find("compiler");
+            const auto cpu = file->context.find("cpu");
+            std::cout << name << ": "
+                      << (label != file->context.end() ? label->second : "") << " | "
+                      << (compiler != file->context.end() ? compiler->second : "?")
+                      << " | " << (cpu != file->context.end() ? cpu->second : "?") << "\n";
+        }
+        const std::vector<Comparison> comparisons =
+            compare(baseline, current, threshold, alpha);
+        print_comparison(std::cout, comparisons);
+        std::size_t slower = 0;
+        std::size_t missing = 0;
+        for (const Comparison &c : comparisons) {
+            slower += c.slower ? 1 : 0;
+            missing += c.missing ? 1 : 0;
+        }
+        std::cout << comparisons.size() - missing << " compared, " << slower
+                  << " significantly slower (threshold " << threshold * 100
+                  << "%, alpha " << alpha << "), " << missing
+                  << " missing from current\n";
+        return slower == 0 && missing == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
+
+int main(int argc, char **argv) {
+    Config config;
+    std::string json_path;
+    std::string csv_path;
+    std::string label;
+    std::string compare_files;
+    double threshold = 0.05;
+    double alpha = 0.01;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        std::string_view value;
+        if (parse_flag(arg, "--filter", value)) {
+            config.filter = std::string(value);
+        } else if (parse_flag(arg, "--samples", value)) {
+            config.samples = std::max<std::size_t>(1, std::strtoul(value.data(), nullptr, 10));
+        } else if (parse_flag(arg, "--min-time-ms", value)) {
+            config.min_sample_time = std::chrono::milliseconds(std::strtol(value.data(), nullptr, 10));
+        } else if (parse_flag(arg, "--warmup-ms", value)) {
+            config.warmup = std::chrono::milliseconds(std::strtol(value.data(), nullptr, 10));
+        } else if (parse_flag(arg, "--json", value)) {
+            json_path = std::string(value);
+        } else if (parse_flag(arg, "--csv", value)) {
+            csv_path = std::string(value);
+        } else if (parse_flag(arg, "--label", value)) {
+            label = std::string(value);
+        } else if (parse_flag(arg, "--compare", value)) {
+            compare_files = std::string(value);
+        } else if (parse_flag(arg, "--threshold", value)) {
+            threshold = std::strtod(value.data(), nullptr) / 100;
+        } else if (parse_flag(arg, "--alpha", value)) {
+            alpha = std::strtod(value.data(), nullptr);
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                      << "Usage: smath_bench [--filter=substring] [--samples=N] "
+                         "[--min-time-ms=N] [--warmup-ms=N] [--json=file] [--csv=file] "
+                         "[--label=text]\n"
+                         "       smath_bench --compare=baseline,current "
+                         "[--threshold=percent] [--alpha=p]\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (!compare_files.empty()) {
+        return run_compare(compare_files, threshold, alpha);
+    }
+    const std::vector<Result> results = Registry::instance().run(config);
+    if (json_path.empty() && csv_path.empty()) {
+        return EXIT_SUCCESS;
+    }
+    const Context context = Context::detect(label, SMATH_BENCH_FLAGS, simd_level());
+    bool written = true;
+    if (!json_path.empty()) {
+        written &= write_file(json_path, context, results, [](auto &o, auto &c, auto &r) {
+            write_json(o, c, r);
+        });
+    }
+    if (!csv_path.empty()) {
+        written &= write_file(csv_path, context, results, [](auto &o, auto &c, auto &r) {
+            write_csv(o, c, r);
+        });
+    }
+    return written ? EXIT_SUCCESS : EXIT_FAILURE;
+}
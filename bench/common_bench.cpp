@@ -0,0 +1,59 @@
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t batch = 256;
+
+std::vector<Vec3f> make_vecs(std::uint64_t seed, float low, float high) {
+    Random random(seed);
+    std::vector<Vec3f> result(batch);
+    for (Vec3f &v : result) {
+        v = Vec3f(random.uniform(low, high), random.uniform(low, high),
+                  random.uniform(low, high));
+    }
+    return result;
+}
+std::vector<float> make_scalars(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<float> result(batch);
+    for (float &s : result) {
+        s = random.uniform(-2.0f, 2.0f);
+    }
+    return result;
+}
+} // namespace
+
+BENCH(common) {
+    const std::vector<float> s = make_scalars(1);
+    const std::vector<Vec3f> a = make_vecs(2, -2.0f, 2.0f);
+    const std::vector<Vec3f> c = make_vecs(3, -2.0f, 2.0f);
+    std::vector<Vec3f> normals;
+    for (const Vec3f &v : c) {
+        normals.push_back(v.normalize_or_zero());
+    }
+    std::vector<Mat4f> m;
+    for (std::size_t i = 0; i < batch; i++) {
+        m.push_back(rotation(s[i], a[i]));
+    }
+    b.map("to_radian", s, [](float x) { return to_radian(x); });
+    b.map("clamp float", s, [](float x) { return clamp(x, -1.0f, 1.0f); });
+    b.map("clamp Vec3f", a, [](const Vec3f &x) { return clamp(x, -1.0f, 1.0f); });
+    b.map("clamp Mat4f", m, [](const Mat4f &x) { return clamp(x, -0.5f, 0.5f); });
+    b.map("saturate Vec3f", a, [](const Vec3f &x) { return saturate(x); });
+    b.map("mix Vec3f", a, c, [](const Vec3f &x, const Vec3f &y) { return mix(x, y, 0.25f); });
+    b.map("mix Mat4f", m, [](const Mat4f &x) { return mix(x, Mat4f::identity(), 0.25f); });
+    b.map("step Vec3f", a, [](const Vec3f &x) { return step(x, 0.0f); });
+    b.map("smooth_step float", s, [](float x) { return smooth_step(-1.0f, 1.0f, x); });
+    b.map("smooth_step Vec3f", a, [](const Vec3f &x) { return smooth_step(-1.0f, 1.0f, x); });
+    b.map("reflect", a, normals, [](const Vec3f &x, const Vec3f &n) { return reflect(x, n); });
+    b.map("refract", a, normals,
+          [](const Vec3f &x, const Vec3f &n) { return refract(x, n, 1.0f, 1.33f); });
+    b.map("absolute Vec3f", a, [](const Vec3f &x) { return absolute(x); });
+    b.map("absolute Mat4f", m, [](const Mat4f &x) { return absolute(x); });
+    b.map("distance (p = 3)", a, c,
+          [](const Vec3f &x, const Vec3f &y) { return distance(x, y, 3.0f); });
+}
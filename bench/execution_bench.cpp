@@ -0,0 +1,53 @@
+/*
+    Parallel scaling of the bulk APIs: the same workload under seq, par and
+    par_unseq, compare the rows of one workload for the speedup.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+template <class F>
+void policies(Bench &b, const std::string &name, std::size_t count, F &&body) {
+    b.run(name + " seq", count, [&] { body(execution::seq); });
+    b.run(name + " par", count, [&] { body(execution::par); });
+    b.run(name + " par_unseq", count, [&] { body(execution::par_unseq); });
+}
+} // namespace
+
+BENCH(execution) {
+    constexpr std::size_t count = 1 << 21;
+    const Mat4f m = translation3(1.0f, -2.0f, 3.0f).cross(rotation(0.4f, Vec3f(0, 1, 1)));
+    std::vector<Vec3f> points(count);
+    for (std::size_t i = 0; i < count; i++) {
+        points[i] = Vec3f(static_cast<float>(i % 101), static_cast<float>(i % 37),
+                          static_cast<float>(i % 7));
+    }
+    std::vector<Vec3f> out(count);
+    const VecArray3f soa{std::span<const Vec3f>(points)};
+    VecArray3f soa_out(count);
+
+    policies(b, "transform_points span", count, [&](auto policy) {
+        transform_points(policy, m, points, out);
+        do_not_optimize(out.data());
+    });
+    policies(b, "transform_points soa", count, [&](auto policy) {
+        transform_points(policy, m, soa, soa_out);
+        do_not_optimize(soa_out);
+    });
+    policies(b, "transform_normals span", count, [&](auto policy) {
+        transform_normals(policy, m, points, out);
+        do_not_optimize(out.data());
+    });
+    policies(b, "VecArray::normalize_or_zero", count, [&](auto policy) {
+        soa_out = soa.normalize_or_zero(policy);
+        do_not_optimize(soa_out);
+    });
+    policies(b, "VecArray::dot", count, [&](auto policy) {
+        std::vector<float> dot = soa.dot(policy, soa_out);
+        do_not_optimize(dot.data());
+    });
+}
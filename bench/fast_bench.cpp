@@ -0,0 +1,125 @@
+/*
+    fast:: approximations against <cmath> and the precise smath paths,
+    element by element and over whole arrays.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <cmath>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t batch = 256;
+
+template <class T> std::vector<T> make_scalars(std::uint64_t seed, T low, T high) {
+    Random random(seed);
+    std::vector<T> result(batch);
+    for (T &s : result) {
+        s = random.uniform<T>(low, high);
+    }
+    return result;
+}
+
+template <class T> void fast_ops(Bench &b, const char *type) {
+    using V = Vec<3, T>;
+    using Q = Quat<T>;
+    const std::vector<T> angles = make_scalars<T>(1, T(-10), T(10));
+    const std::vector<T> unit = make_scalars<T>(2, T(-1), T(1));
+    const std::vector<T> positive = make_scalars<T>(3, T(0.01), T(100));
+    std::vector<V> a;
+    std::vector<V> c;
+    std::vector<Q> qa;
+    std::vector<Q> qc;
+    for (std::size_t i = 0; i < batch; i++) {
+        a.push_back(V(angles[i], unit[i], positive[i]));
+        c.push_back(V(unit[i], positive[i], angles[i]));
+        qa.push_back(Q(unit[i], angles[i], T(1), positive[i]).normalize());
+        qc.push_back(Q(positive[i], unit[i], angles[i], T(-1)).normalize());
+    }
+    const std::string prefix = std::string(type) + " ";
+    b.map(prefix + "std::sin", angles, [](T x) { return std::sin(x); });
+    b.map(prefix + "fast::sin", angles, [](T x) { return fast::sin(x); });
+    b.map(prefix + "std::cos", angles, [](T x) { return std::cos(x); });
+    b.map(prefix + "fast::cos", angles, [](T x) { return fast::cos(x); });
+    b.map(prefix + "fast::sincos", angles, [](T x) { return fast::sincos(x); });
+    b.map(prefix + "std::acos", unit, [](T x) { return std::acos(x); });
+    b.map(prefix + "fast::acos", unit, [](T x) { return fast::acos(x); });
+    b.map(prefix + "std::atan2", unit, angles, [](T y, T x) { return std::atan2(y, x); });
+    b.map(prefix + "fast::atan2", unit, angles, [](T y, T x) { return fast::atan2(y, x); });
+    b.map(prefix + "1 / std::sqrt", positive, [](T x) { return 1 / std::sqrt(x); });
+    b.map(prefix + "fast::rsqrt", positive, [](T x) { return fast::rsqrt(x); });
+
+    b.map(prefix + "Vec3 normalize", a, [](const V &x) { return x.normalize(); });
+    b.map(prefix + "fast::normalize Vec3", a, [](const V &x) { return fast::normalize(x); });
+    b.map(prefix + "Vec3 angle", a, c, [](const V &x, const V &y) { return x.angle(y); });
+    b.map(prefix + "fast::angle Vec3", a, c,
+          [](const V &x, const V &y) { return fast::angle(x, y); });
+    b.map(prefix + "Quat normalize", qa, [](const Q &x) { return x.normalize(); });
+    b.map(prefix + "fast::normalize Quat", qa, [](const Q &x) { return fast::normalize(x); });
+    b.map(prefix + "slerp", qa, qc, [](const Q &x, const Q &y) { return slerp(x, y, T(0.3)); });
+    b.map(prefix + "fast::slerp", qa, qc,
+          [](const Q &x, const Q &y) { return fast::slerp(x, y, T(0.3)); });
+
+    // Whole arrays: the <cmath> loop against the register kernels.
+    std::vector<T> out(batch);
+    b.run(prefix + "std::sin array", batch, [&] {
+        for (std::size_t i = 0; i < batch; i++) {
+            out[i] = std::sin(angles[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run(prefix + "fast::sin array", batch, [&] {
+        fast::sin(angles, std::span<T>(out));
+        do_not_optimize(out.data());
+    });
+    std::vector<T> out_cos(batch);
+    b.run(prefix + "fast::sin + fast::cos array", batch, [&] {
+        fast::sin(angles, std::span<T>(out));
+        fast::cos(angles, std::span<T>(out_cos));
+        do_not_optimize(out.data());
+        do_not_optimize(out_cos.data());
+    });
+    b.run(prefix + "fast::sincos array", batch, [&] {
+        fast::sincos(angles, std::span<T>(out), std::span<T>(out_cos));
+        do_not_optimize(out.data());
+        do_not_optimize(out_cos.data());
+    });
+    b.run(prefix + "std::acos array", batch, [&] {
+        for (std::size_t i = 0; i < batch; i++) {
+            out[i] = std::acos(unit[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run(prefix + "fast::acos array", batch, [&] {
+        fast::acos(unit, std::span<T>(out));
+        do_not_optimize(out.data());
+    });
+    b.run(prefix + "std::atan2 array", batch, [&] {
+        for (std::size_t i = 0; i < batch; i++) {
+            out[i] = std::atan2(unit[i], angles[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run(prefix + "fast::atan2 array", batch, [&] {
+        fast::atan2(unit, angles, std::span<T>(out));
+        do_not_optimize(out.data());
+    });
+    const VecArray<3, T> soa{std::span<const V>(a)};
+    VecArray<3, T> soa_out(batch);
+    b.run(prefix + "VecArray3 normalize_or_zero", batch, [&] {
+        soa_out = soa.normalize_or_zero();
+        do_not_optimize(soa_out);
+    });
+    b.run(prefix + "fast::normalize VecArray3", batch, [&] {
+        soa_out = fast::normalize(soa);
+        do_not_optimize(soa_out);
+    });
+}
+} // namespace
+
+BENCH(fastf) { fast_ops<float>(b, "float"); }
+BENCH(fastd) { fast_ops<double>(b, "double"); }
@@ -0,0 +1,69 @@
+/*
+    Frustum culling of bounding volumes scattered around the camera, about
+    a fifth of them visible, against classifying them one at a time.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <numbers>
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t count = 4096;
+
+struct Scene {
+    Frustumf frustum = Frustumf::from_mat4(
+        perspective(16.0f / 9.0f, std::numbers::pi_v<float> / 3, 0.1f, 200.0f)
+            .cross(look_at(Vec3f(0, 10, 0), Vec3f(0, 0, -100), Vec3f(0, 1, 0))));
+    std::vector<Vec3f> centers;
+    std::vector<float> radii;
+    std::vector<Vec3f> min;
+    std::vector<Vec3f> max;
+
+    Scene() {
+        Random random(13);
+        for (std::size_t i = 0; i < count; i++) {
+            const Vec3f c(random.uniform(-200.0f, 200.0f), random.uniform(-5.0f, 18.0f),
+                          random.uniform(-450.0f, 50.0f));
+            const float r = random.uniform(0.5f, 9.0f);
+            centers.push_back(c);
+            radii.push_back(r);
+            min.push_back(c - Vec3f(r));
+            max.push_back(c + Vec3f(r));
+        }
+    }
+};
+} // namespace
+
+BENCH(frustum) {
+    const Scene scene;
+    const VecArray3f soa{std::span<const Vec3f>(scene.centers)};
+    std::vector<Containment> out(count);
+
+    b.run("classify_sphere loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = scene.frustum.classify_sphere(scene.centers[i], scene.radii[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("classify_spheres span", count, [&] {
+        classify_spheres(scene.frustum, scene.centers, scene.radii, out);
+        do_not_optimize(out.data());
+    });
+    b.run("classify_spheres soa", count, [&] {
+        classify_spheres(scene.frustum, soa, scene.radii, out);
+        do_not_optimize(out.data());
+    });
+    b.run("classify_aabb loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = scene.frustum.classify_aabb(scene.min[i], scene.max[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("classify_aabbs span", count, [&] {
+        classify_aabbs(scene.frustum, scene.min, scene.max, out);
+        do_not_optimize(out.data());
+    });
+}
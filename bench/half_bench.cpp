@@ -0,0 +1,62 @@
+/*
+    Packing to and from 16-bit floats, the bulk kernels against converting
+    one element at a time. ns/op is per Vec4f.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t count = 4096;
+
+std::vector<Vec4f> make_values() {
+    Random random(17);
+    std::vector<Vec4f> result(count);
+    for (Vec4f &v : result) {
+        v = Vec4f(random.uniform(-100.0f, 100.0f), random.uniform(-1.0f, 1.0f),
+                  random.uniform(0.0f, 1e-3f), random.uniform(-60000.0f, 60000.0f));
+    }
+    return result;
+}
+} // namespace
+
+BENCH(half) {
+    const std::vector<Vec4f> values = make_values();
+    std::vector<PackedVec4h> half(count);
+    std::vector<PackedVec4bf> bfloat(count);
+    std::vector<Vec4f> back(count);
+    pack(values, std::span<PackedVec4h>(half));
+    pack(values, std::span<PackedVec4bf>(bfloat));
+
+    b.run("PackedVec4h loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            half[i] = PackedVec4h(values[i]);
+        }
+        do_not_optimize(half.data());
+    });
+    b.run("pack PackedVec4h", count, [&] {
+        pack(values, std::span<PackedVec4h>(half));
+        do_not_optimize(half.data());
+    });
+    b.run("unpack loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            back[i] = half[i].unpack();
+        }
+        do_not_optimize(back.data());
+    });
+    b.run("unpack PackedVec4h", count, [&] {
+        unpack(std::span<const PackedVec4h>(half), back);
+        do_not_optimize(back.data());
+    });
+    b.run("pack PackedVec4bf", count, [&] {
+        pack(values, std::span<PackedVec4bf>(bfloat));
+        do_not_optimize(bfloat.data());
+    });
+    b.run("unpack PackedVec4bf", count, [&] {
+        unpack(std::span<const PackedVec4bf>(bfloat), back);
+        do_not_optimize(back.data());
+    });
+}
@@ -0,0 +1,164 @@
+#include "bench.hpp"
+#include "smath.hpp"
+#include <string>
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t batch = 256;
+
+// Diagonally dominant, so every inverse and solve is well conditioned.
+template <unsigned int N, class T> std::vector<Mat<N, N, T>> make_mats(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<Mat<N, N, T>> result(batch);
+    for (Mat<N, N, T> &m : result) {
+        for (unsigned int i = 0; i < N * N; i++) {
+            m.unchecked(i) = random.uniform<T>(T(-1), T(1));
+        }
+        for (unsigned int i = 0; i < N; i++) {
+            m.unchecked(i * N + i) += T(N + 1);
+        }
+    }
+    return result;
+}
+template <unsigned int N, class T> std::vector<Vec<N, T>> make_vecs(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<Vec<N, T>> result(batch);
+    for (Vec<N, T> &v : result) {
+        for (unsigned int i = 0; i < N; i++) {
+            v.unchecked(i) = random.uniform<T>(T(-4), T(4));
+        }
+    }
+    return result;
+}
+template <class T> std::vector<Mat<4, 4, T>> make_rigid(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<Mat<4, 4, T>> result;
+    for (std::size_t i = 0; i < batch; i++) {
+        const Vec<3, T> axis(random.uniform<T>(T(0.1), T(1)), random.uniform<T>(T(-1), T(1)),
+                             random.uniform<T>(T(-1), T(1)));
+        result.push_back(translation3(random.uniform<T>(T(-5), T(5)), T(1), T(2))
+                             .cross(rotation(random.uniform<T>(T(-3), T(3)), axis)));
+    }
+    return result;
+}
+
+template <unsigned int N, class T> void square_ops(Bench &b, const char *type) {
+    const std::vector<Mat<N, N, T>> a = make_mats<N, T>(1);
+    const std::vector<Mat<N, N, T>> c = make_mats<N, T>(2);
+    const std::vector<Vec<N, T>> v = make_vecs<N, T>(3);
+    const std::string prefix = std::string(type) + " ";
+    using M = Mat<N, N, T>;
+    b.map(prefix + "a + b", a, c, [](const M &x, const M &y) { return x + y; });
+    b.map(prefix + "a * s", a, [](const M &x) { return x * T(3); });
+    b.map(prefix + "a * b (element wise)", a, c, [](const M &x, const M &y) { return x * y; });
+    b.map(prefix + "a += b", a, c, [](M x, const M &y) { return x += y; });
+    b.map(prefix + "cross", a, c, [](const M &x, const M &y) { return x.cross(y); });
+    b.map(prefix + "cross vec", a, v, [](const M &x, const Vec<N, T> &y) { return x.cross(y); });
+    b.map(prefix + "transpose", a, [](const M &x) { return x.transpose(); });
+    b.map(prefix + "determinant", a, [](const M &x) { return x.determinant(); });
+    b.map(prefix + "trace", a, [](const M &x) { return x.trace(); });
+    b.map(prefix + "inverse", a, [](const M &x) { return x.inverse(); });
+    // The path inverse() took before the closed forms.
+    b.map(prefix + "inverse by adjoint", a,
+          [](const M &x) { return (1 / x.determinant()) * x.adjoint(); });
+    b.map(prefix + "adjoint", a, [](const M &x) { return x.adjoint(); });
+    b.map(prefix + "lu", a, [](const M &x) { return x.lu(); });
+    b.map(prefix + "solve", a, v, [](const M &x, const Vec<N, T> &y) { return x.solve(y); });
+    b.map(prefix + "a == b", a, c, [](const M &x, const M &y) { return x == y; });
+}
+
+// The loop Mat::cross ran before the register-blocked kernel.
+template <unsigned int S, class T>
+Mat<S, S, T> loop_cross(const Mat<S, S, T> &a, const Mat<S, S, T> &b) {
+    Mat<S, S, T> result{};
+    for (unsigned int k = 0; k < S; k++) {
+        for (unsigned int m = 0; m < S; m++) {
+            T sum = 0;
+            for (unsigned int n = 0; n < S; n++) {
+                sum += a.unchecked(n * S + m) * b.unchecked(k * S + n);
+            }
+            result.unchecked(k * S + m) = sum;
+        }
+    }
+    return result;
+}
+/**
+ * @brief One item is one floating point operation, Mop/s reads as MFLOP/s.
+ */
+template <unsigned int S, class T> void gemm_ops(Bench &b, const char *type) {
+    constexpr std::size_t count = 16;
+    const std::vector<Mat<S, S, T>> a = make_mats<S, T>(8);
+    const std::vector<Mat<S, S, T>> c = make_mats<S, T>(9);
+    const std::size_t flops = 2 * std::size_t(S) * S * S * count;
+    const std::string prefix = "Mat" + std::to_string(S) + type + " ";
+    b.run(prefix + "cross", flops, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            Mat<S, S, T> result = a[i].cross(c[i]);
+            do_not_optimize(result);
+        }
+    });
+    b.run(prefix + "triple loop", flops, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            Mat<S, S, T> result = loop_cross(a[i], c[i]);
+            do_not_optimize(result);
+        }
+    });
+}
+} // namespace
+
+BENCH(mat2f) { square_ops<2, float>(b, "Mat2f"); }
+BENCH(mat3f) { square_ops<3, float>(b, "Mat3f"); }
+BENCH(mat4f) {
+    square_ops<4, float>(b, "Mat4f");
+    const std::vector<Mat4f> rigid = make_rigid<float>(4);
+    const std::vector<Vec4f> v = make_vecs<4, float>(5);
+    b.map("Mat4f * vec", rigid, v, [](const Mat4f &x, const Vec4f &y) { return x * y; });
+    b.map("Mat4f inverse_affine", rigid, [](const Mat4f &x) { return x.inverse_affine(); });
+    b.map("Mat4f inverse_rigid", rigid, [](const Mat4f &x) { return x.inverse_rigid(); });
+    b.map("Mat4f to_mat3", rigid, [](const Mat4f &x) { return x.to_mat3(); });
+    b.map("Mat4f decompose", rigid, [](const Mat4f &x) { return decompose(x); });
+}
+BENCH(mat4d) {
+    square_ops<4, double>(b, "Mat4d");
+    const std::vector<Mat4d> rigid = make_rigid<double>(4);
+    b.map("Mat4d inverse_affine", rigid, [](const Mat4d &x) { return x.inverse_affine(); });
+    b.map("Mat4d inverse_rigid", rigid, [](const Mat4d &x) { return x.inverse_rigid(); });
+}
+// Past the closed forms, LU with partial pivoting.
+BENCH(mat8d) { square_ops<8, double>(b, "Mat8d"); }
+
+// Register-blocked Mat::cross against the triple loop, per flop.
+BENCH(gemm) {
+    gemm_ops<8, float>(b, "f");
+    gemm_ops<16, float>(b, "f");
+    gemm_ops<24, float>(b, "f");
+    gemm_ops<32, float>(b, "f");
+    gemm_ops<8, double>(b, "d");
+    gemm_ops<16, double>(b, "d");
+    gemm_ops<32, double>(b, "d");
+}
+
+BENCH(mat_factories) {
+    const std::vector<Vec3f> v = make_vecs<3, float>(6);
+    const std::vector<Vec3f> w = make_vecs<3, float>(7);
+    b.map("translation3", v, [](const Vec3f &x) { return translation3(x); });
+    b.map("rotation", v, [](const Vec3f &x) { return rotation(x[0], x); });
+    b.map("euler_x", v, [](const Vec3f &x) { return euler_x(x[0]); });
+    b.map("euler_x * euler_y * euler_z", v, [](const Vec3f &x) {
+        return euler_x(x[0]).cross(euler_y(x[1])).cross(euler_z(x[2]));
+    });
+    b.map("euler_xyz", v, [](const Vec3f &x) { return euler_xyz(x[0], x[1], x[2]); });
+    b.map("scale3", v, [](const Vec3f &x) { return scale3(x[0], x[1], x[2]); });
+    b.map("outer_product", v, w, [](const Vec3f &x, const Vec3f &y) { return outer_product(x, y); });
+    b.map("look_at", v, w,
+          [](const Vec3f &x, const Vec3f &y) { return look_at(x, y, Vec3f(0, 1, 0)); });
+    b.map("perspective", v, [](const Vec3f &x) {
+        return perspective(1.5f, 0.2f * x[0], 0.1f, 100.0f + x[1]);
+    });
+    b.map("orthgraphic", v, [](const Vec3f &x) {
+        return orthgraphic(-x[0], x[0], x[1], -x[1], 0.1f, 100.0f);
+    });
+}
@@ -0,0 +1,79 @@
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t batch = 256;
+
+template <class T> std::vector<Quat<T>> make_quats(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<Quat<T>> result;
+    for (std::size_t i = 0; i < batch; i++) {
+        const Vec<3, T> axis(random.uniform<T>(T(0.1), T(1)), random.uniform<T>(T(-1), T(1)),
+                             random.uniform<T>(T(-1), T(1)));
+        const T half = random.uniform<T>(T(-1.5), T(1.5));
+        result.push_back(Quat<T>(std::cos(half), axis.normalize() * std::sin(half)));
+    }
+    return result;
+}
+
+template <class T> void quat_ops(Bench &b, const char *type) {
+    using Q = Quat<T>;
+    const std::vector<Q> a = make_quats<T>(1);
+    const std::vector<Q> c = make_quats<T>(2);
+    std::vector<Vec<3, T>> v;
+    std::vector<Mat<3, 3, T>> m;
+    for (const Q &q : c) {
+        v.push_back(q.vector() * T(3));
+        m.push_back(q.to_mat3());
+    }
+    const std::string prefix = std::string(type) + " ";
+    b.map(prefix + "a + b", a, c, [](const Q &x, const Q &y) { return x + y; });
+    b.map(prefix + "a * s", a, [](const Q &x) { return x * T(2); });
+    b.map(prefix + "mul", a, c, [](const Q &x, const Q &y) { return x.mul(y); });
+    b.map(prefix + "dot", a, c, [](const Q &x, const Q &y) { return x.dot(y); });
+    b.map(prefix + "conjugate", a, [](const Q &x) { return x.conjugate(); });
+    b.map(prefix + "inverse", a, [](const Q &x) { return x.inverse(); });
+    b.map(prefix + "length", a, [](const Q &x) { return x.length(); });
+    b.map(prefix + "normalize", a, [](const Q &x) { return x.normalize(); });
+    b.map(prefix + "normalize_or_zero", a, [](const Q &x) { return x.normalize_or_zero(); });
+    b.map(prefix + "rotate", a, v, [](const Q &x, const Vec<3, T> &y) { return x.rotate(y); });
+    b.map(prefix + "to_mat3", a, [](const Q &x) { return x.to_mat3(); });
+    b.map(prefix + "to_mat4", a, [](const Q &x) { return x.to_mat4(); });
+    b.map(prefix + "from_mat3", m, [](const Mat<3, 3, T> &x) { return Q::from_mat3(x); });
+    b.map(prefix + "nlerp", a, c, [](const Q &x, const Q &y) { return nlerp(x, y, T(0.3)); });
+    b.map(prefix + "onlerp", a, c, [](const Q &x, const Q &y) { return onlerp(x, y, T(0.3)); });
+    b.map(prefix + "slerp", a, c, [](const Q &x, const Q &y) { return slerp(x, y, T(0.3)); });
+}
+} // namespace
+
+BENCH(quatf) { quat_ops<float>(b, "Quatf"); }
+BENCH(quatd) { quat_ops<double>(b, "Quatd"); }
+
+// Batched blends over whole buffers against the per pair slerp above.
+BENCH(blend) {
+    const std::vector<Quat<float>> a = make_quats<float>(3);
+    const std::vector<Quat<float>> c = make_quats<float>(4);
+    std::vector<Quat<float>> out(batch);
+    b.run("slerp loop", batch, [&] {
+        for (std::size_t i = 0; i < batch; i++) {
+            out[i] = slerp(a[i], c[i], 0.3f);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("slerp batched", batch, [&] {
+        slerp(a, c, 0.3f, out);
+        do_not_optimize(out.data());
+    });
+    b.run("onlerp batched", batch, [&] {
+        onlerp(a, c, 0.3f, out);
+        do_not_optimize(out.data());
+    });
+    b.run("nlerp batched", batch, [&] {
+        nlerp(a, c, 0.3f, out);
+        do_not_optimize(out.data());
+    });
+}
@@ -0,0 +1,580 @@
+#ifndef SMATH_BENCH_REPORT_HPP
+#define SMATH_BENCH_REPORT_HPP
+/*
+    Machine readable smath_bench results and regression comparison.
+
+    A run is written as JSON (a context object and one object per result)
+    or CSV ('# key: value' context lines, a header row, one row per
+    result). Both keep mean, standard deviation and sample count, which is
+    all Welch's t-test needs, so compare() reads either format back and
+    flags a benchmark as slower when its median grew by more than the
+    threshold and the difference of the means is significant, or as
+    missing when the baseline has it and the current run does not. The
+    perf counter events per item are written too when the run had them
+    (omitted in JSON, empty in CSV otherwise); compare() does not use them.
+
+    Everything is computed locally, no network access is involved.
+*/
+#include "bench.hpp"
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace smath::bench {
+/***************************************
+        Context
+***************************************/
+/**
+ * @brief Where a run comes from, written next to the results.
+ */
+struct Context {
+    std::string label;
+    std::string compiler;
+    std::string flags;
+    std::string simd;
+    std::string cpu;
+    unsigned int threads = 0;
+    std::string date;
+
+    /**
+     * @brief Compiler and date of this binary, CPU model from
+     * /proc/cpuinfo (Linux, "unknown" elsewhere).
+     */
+    static Context detect(std::string label, std::string flags, std::string simd) {
+        Context context;
+        context.label = std::move(label);
+        context.flags = std::move(flags);
+        context.simd = std::move(simd);
+#if defined(__clang__)
+        context.compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        context.compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+        context.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+        context.compiler = "unknown";
+#endif
+        context.cpu = "unknown";
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        for (std::string line; std::getline(cpuinfo, line);) {
+            if (line.rfind("model name", 0) == 0) {
+                const std::size_t colon = line.find(':');
+                if (colon != std::string::npos && colon + 2 <= line.size())
+                    context.cpu = line.substr(colon + 2);
+                break;
+            }
+        }
+        context.threads = std::thread::hardware_concurrency();
+        const std::time_t now =
+            std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        context.date = date;
+        return context;
+    }
+};
+
+/**
+ * @brief Summary of one benchmark as stored in a result file.
+ */
+struct Summary {
+    std::string name;
+    double median = 0;
+    double mean = 0;
+    double stddev = 0;
+    double min = 0;
+    double p90 = 0;
+    double p99 = 0;
+    std::size_t samples = 0;
+
+    static Summary of(const Result &r) {
+        return Summary{r.name,  r.median(),        r.mean(),          r.stddev(),
+                       r.min(), r.percentile(90), r.percentile(99), r.ns_per_item.size()};
+    }
+};
+
+/***************************************
+        Writers
+***************************************/
+namespace detail {
+inline std::string json_string(const std::string &text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out + "\"";
+}
+inline std::string csv_field(const std::string &text) {
+    if (text.find_first_of(",\"\n") == std::string::npos)
+        return text;
+    std::string out = "\"";
+    for (char c : text) {
+        out += (c == '"') ? std::string("\"\"") : std::string(1, c);
+    }
+    return out + "\"";
+}
+inline std::vector<std::pair<std::string, std::string>> context_fields(const Context &c) {
+    return {{"label", c.label},  {"compiler", c.compiler},
+            {"flags", c.flags},  {"simd", c.simd},
+            {"cpu", c.cpu},      {"threads", std::to_string(c.threads)},
+            {"date", c.date}};
+}
+} // namespace detail
+
+inline void write_json(std::ostream &o, const Context &context,
+                       const std::vector<Result> &results) {
+    o << std::setprecision(17) << "{\n  \"context\": {";
+    const auto fields = detail::context_fields(context);
+    for (std::size_t i = 0; i < fields.size(); i++) {
+        o << (i ? ", " : "") << detail::json_string(fields[i].first) << ": "
+          << detail::json_string(fields[i].second);
+    }
+    o << "},\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        const Summary s = Summary::of(r);
+        o << (i ? "," : "") << "\n    {\"name\": " << detail::json_string(r.name)
+          << ", \"items_per_call\": " << r.items_per_call
+          << ", \"calls_per_sample\": " << r.calls_per_sample
+          << ", \"samples\": " << s.samples << ", \"median_ns\": " << s.median
+          << ", \"mean_ns\": " << s.mean << ", \"stddev_ns\": " << s.stddev
+          << ", \"min_ns\": " << s.min << ", \"p90_ns\": " << s.p90
+          << ", \"p99_ns\": " << s.p99;
+        for (int e = 0; e < PerfCounters::event_count; e++) {
+            if (r.per_item[e])
+                o << ", \"" << PerfCounters::names[e] << "_per_item\": " << *r.per_item[e];
+        }
+        o << ", \"ns_per_item\": [";
+        for (std::size_t k = 0; k < r.ns_per_item.size(); k++) {
+            o << (k ? ", " : "") << r.ns_per_item[k];
+        }
+        o << "]}";
+    }
+    o << "\n  ]\n}\n";
+}
+
+inline void write_csv(std::ostream &o, const Context &context,
+                      const std::vector<Result> &results) {
+    for (const auto &[key, value] : detail::context_fields(context)) {
+        o << "# " << key << ": " << value << "\n";
+    }
+    o << "name,items_per_call,calls_per_sample,samples,median_ns,mean_ns,stddev_ns,"
+         "min_ns,p90_ns,p99_ns";
+    for (const char *name : PerfCounters::names) {
+        o << "," << name << "_per_item";
+    }
+    o << "\n" << std::setprecision(17);
+    for (const Result &r : results) {
+        const Summary s = Summary::of(r);
+        o << detail::csv_field(r.name) << "," << r.items_per_call << ","
+          << r.calls_per_sample << "," << s.samples << "," << s.median << "," << s.mean
+          << "," << s.stddev << "," << s.min << "," << s.p90 << "," << s.p99;
+        for (const std::optional<double> &value : r.per_item) {
+            o << ",";
+            if (value)
+                o << *value;
+        }
+        o << "\n";
+    }
+}
+
+/***************************************
+        Readers
+***************************************/
+namespace detail {
+/*
+    Just enough JSON for the files written above: objects, arrays, strings,
+    numbers and literals. Objects flatten into "key" / "parent.key" paths.
+*/
+class JsonReader {
+  private:
+    const std::string &text;
+    std::size_t pos = 0;
+
+    [[noreturn]] void fail(const char *what) const {
+        throw std::runtime_error(std::string("Invalid benchmark JSON: ") + what +
+                                 " at offset " + std::to_string(pos));
+    }
+    void skip() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+            pos++;
+    }
+    bool consume(char c) {
+        skip();
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+    std::string string() {
+        if (!consume('"'))
+            fail("expected a string");
+        std::string out;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\' && pos < text.size()) {
+                c = text[pos++];
+                if (c == 'n')
+                    c = '\n';
+                else if (c == 't')
+                    c = '\t';
+                else if (c == 'u' && pos + 4 <= text.size()) {
+                    c = static_cast<char>(std::stoi(text.substr(pos, 4), nullptr, 16));
+                    pos += 4;
+                }
+            }
+            out += c;
+        }
+        if (!consume('"'))
+            fail("unterminated string");
+        return out;
+    }
+
+  public:
+    explicit JsonReader(const std::string &text) : text(text) {}
+
+    /**
+     * @brief Parse one value, calling on_scalar(path, text) for every
+     * string, number or literal and on_object_end(path) after every object.
+     */
+    template <class Scalar, class ObjectEnd>
+    void value(const std::string &path, Scalar &&on_scalar, ObjectEnd &&on_object_end) {
+        skip();
+        if (consume('{')) {
+            if (!consume('}')) {
+                do {
+                    const std::string key = string();
+                    if (!consume(':'))
+                        fail("expected ':'");
+                    value(path.empty() ? key : path + "." + key, on_scalar, on_object_end);
+                } while (consume(','));
+                if (!consume('}'))
+                    fail("expected '}'");
+            }
+            on_object_end(path);
+        } else if (consume('[')) {
+            if (!consume(']')) {
+                do {
+                    value(path, on_scalar, on_object_end);
+                } while (consume(','));
+                if (!consume(']'))
+                    fail("expected ']'");
+            }
+        } else if (pos < text.size() && text[pos] == '"') {
+            on_scalar(path, string());
+        } else {
+            const std::size_t start = pos;
+            while (pos < text.size() && text[pos] != ',' && text[pos] != '}' &&
+                   text[pos] != ']' && !std::isspace(static_cast<unsigned char>(text[pos])))
+                pos++;
+            if (start == pos)
+                fail("expected a value");
+            on_scalar(path, text.substr(start, pos - start));
+        }
+    }
+};
+
+inline std::vector<std::string> split_csv(const std::string &line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); i++) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+inline void set_summary_field(Summary &s, const std::string &key, const std::string &value) {
+    if (key == "name")
+        s.name = value;
+    else if (key == "median_ns")
+        s.median = std::stod(value);
+    else if (key == "mean_ns")
+        s.mean = std::stod(value);
+    else if (key == "stddev_ns")
+        s.stddev = std::stod(value);
+    else if (key == "min_ns")
+        s.min = std::stod(value);
+    else if (key == "p90_ns")
+        s.p90 = std::stod(value);
+    else if (key == "p99_ns")
+        s.p99 = std::stod(value);
+    else if (key == "samples")
+        s.samples = std::stoul(value);
+}
+} // namespace detail
+
+/**
+ * @brief A result file read back: its context fields and summaries.
+ */
+struct ResultFile {
+    std::map<std::string, std::string> context;
+    std::vector<Summary> results;
+};
+
+inline ResultFile parse_json(const std::string &text) {
+    ResultFile file;
+    Summary current;
+    detail::JsonReader reader(text);
+    reader.value(
+        "",
+        [&](const std::string &path, const std::string &value) {
+            if (path.rfind("context.", 0) == 0) {
+                file.context[path.substr(8)] = value;
+            } else if (path.rfind("results.", 0) == 0) {
+                detail::set_summary_field(current, path.substr(8), value);
+            }
+        },
+        [&](const std::string &path) {
+            if (path == "results") {
+                file.results.push_back(current);
+                current = Summary{};
+            }
+        });
+    return file;
+}
+inline ResultFile parse_csv(const std::string &text) {
+    ResultFile file;
+    std::istringstream in(text);
+    std::vector<std::string> header;
+    for (std::string line; std::getline(in, line);) {
+        if (line.empty())
+            continue;
+        if (line.rfind("# ", 0) == 0) {
+            const std::size_t colon = line.find(": ");
+            if (colon != std::string::npos)
+                file.context[line.substr(2, colon - 2)] = line.substr(colon + 2);
+        } else if (header.empty()) {
+            header = detail::split_csv(line);
+        } else {
+            const std::vector<std::string> fields = detail::split_csv(line);
+            Summary s;
+            for (std::size_t i = 0; i < header.size() && i < fields.size(); i++) {
+                detail::set_summary_field(s, header[i], fields[i]);
+            }
+            file.results.push_back(s);
+        }
+    }
+    return file;
+}
+/**
+ * @brief Read a file written by write_json or write_csv, told apart by
+ * its first character.
+ */
+inline ResultFile read_results(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open benchmark results: " + path);
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    const std::size_t first = text.find_first_not_of(" \t\r\n");
+    return (first != std::string::npos && text[first] == '{') ? parse_json(text)
+                                                             : parse_csv(text);
+}
+
+/***************************************
+        Statistics
+***************************************/
+namespace detail {
+// Continued fraction of the regularized incomplete beta (modified Lentz).
+inline double beta_fraction(double a, double b, double x) {
+    constexpr double tiny = 1e-300;
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    d = 1 / (std::abs(d) < tiny ? tiny : d);
+    double h = d;
+    for (int m = 1; m <= 300; m++) {
+        for (int step = 0; step < 2; step++) {
+            const double numerator =
+                step == 0 ? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+                          : -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+            d = 1 + numerator * d;
+            d = 1 / (std::abs(d) < tiny ? tiny : d);
+            c = 1 + numerator / c;
+            c = std::abs(c) < tiny ? tiny : c;
+            h *= d * c;
+            if (step == 1 && std::abs(d * c - 1) < 1e-15)
+                return h;
+        }
+    }
+    return h;
+}
+} // namespace detail
+/**
+ * @return I_x(a, b), the regularized incomplete beta function.
+ */
+inline double incomplete_beta(double a, double b, double x) {
+    if (x <= 0)
+        return 0;
+    if (x >= 1)
+        return 1;
+    const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                  a * std::log(x) + b * std::log1p(-x));
+    if (x < (a + 1) / (a + b + 2))
+        return front * detail::beta_fraction(a, b, x) / a;
+    return 1 - front * detail::beta_fraction(b, a, 1 - x) / b;
+}
+
+struct Welch {
+    double t = 0;
+    double dof = 0;
+    // Two sided, the probability of a difference at least this large when
+    // the means are equal.
+    double p_value = 1;
+};
+/**
+ * @brief Welch's unequal variances t-test of mean b against mean a.
+ */
+inline Welch welch_t_test(double mean_a, double stddev_a, std::size_t n_a, double mean_b,
+                          double stddev_b, std::size_t n_b) {
+    Welch result;
+    if (n_a < 2 || n_b < 2) {
+        return result;
+    }
+    const double va = stddev_a * stddev_a / static_cast<double>(n_a);
+    const double vb = stddev_b * stddev_b / static_cast<double>(n_b);
+    if (va + vb == 0) {
+        result.p_value = (mean_a == mean_b) ? 1 : 0;
+        result.t = (mean_b > mean_a)   ? std::numeric_limits<double>::infinity()
+                   : (mean_b < mean_a) ? -std::numeric_limits<double>::infinity()
+                                       : 0;
+        return result;
+    }
+    result.t = (mean_b - mean_a) / std::sqrt(va + vb);
+    result.dof = (va + vb) * (va + vb) /
+                 (va * va / static_cast<double>(n_a - 1) + vb * vb / static_cast<double>(n_b - 1));
+    result.p_value =
+        incomplete_beta(result.dof / 2, 0.5, result.dof / (result.dof + result.t * result.t));
+    return result;
+}
+
+/***************************************
+        Comparison
+***************************************/
+struct Comparison {
+    std::string name;
+    double baseline_ns = 0;
+    double current_ns = 0;
+    // Relative change of the median, positive is slower.
+    double change = 0;
+    double p_value = 1;
+    bool slower = false;
+    bool faster = false;
+    // In the baseline only, the current run dropped or renamed it.
+    bool missing = false;
+};
+/**
+ * @brief Match benchmarks by name. A change counts when the medians differ
+ * by more than threshold (0.05 = 5%) and Welch's test on the means gives
+ * p < alpha. Benchmarks of the baseline absent from current follow, in
+ * baseline order, marked missing; new ones in current are skipped.
+ */
+inline std::vector<Comparison> compare(const ResultFile &baseline, const ResultFile &current,
+                                       double threshold = 0.05, double alpha = 0.01) {
+    std::map<std::string, const Summary *> by_name;
+    for (const Summary &s : baseline.results) {
+        by_name[s.name] = &s;
+    }
+    std::vector<Comparison> comparisons;
+    for (const Summary &now : current.results) {
+        const auto found = by_name.find(now.name);
+        if (found == by_name.end())
+            continue;
+        const Summary &base = *found->second;
+        Comparison c;
+        c.name = now.name;
+        c.baseline_ns = base.median;
+        c.current_ns = now.median;
+        c.change = base.median > 0 ? now.median / base.median - 1 : 0;
+        c.p_value = welch_t_test(base.mean, base.stddev, base.samples, now.mean, now.stddev,
+                                 now.samples)
+                        .p_value;
+        const bool significant = c.p_value < alpha;
+        c.slower = significant && c.change > threshold;
+        c.faster = significant && c.change < -threshold;
+        comparisons.push_back(c);
+        by_name.erase(found);
+    }
+    for (const Summary &base : baseline.results) {
+        if (!by_name.contains(base.name))
+            continue;
+        Comparison c;
+        c.name = base.name;
+        c.baseline_ns = base.median;
+        c.missing = true;
+        comparisons.push_back(c);
+    }
+    return comparisons;
+}
+inline void print_comparison(std::ostream &o, const std::vector<Comparison> &comparisons) {
+    o << std::left << std::setw(48) << "benchmark" << std::right << std::setw(12)
+      << "base ns/op" << std::setw(12) << "ns/op" << std::setw(10) << "change"
+      << std::setw(11) << "p-value" << "  verdict\n";
+    for (const Comparison &c : comparisons) {
+        if (c.missing) {
+            o << std::left << std::setw(48) << c.name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(12) << c.baseline_ns << std::setw(12)
+              << "-" << std::setw(10) << "-" << std::setw(11) << "-" << std::defaultfloat
+              << "  MISSING\n";
+            continue;
+        }
+        o << std::left << std::setw(48) << c.name << std::right << std::fixed
+          << std::setprecision(3) << std::setw(12) << c.baseline_ns << std::setw(12)
+          << c.current_ns << std::setw(9) << std::setprecision(1) << c.change * 100 << "%"
+          << std::setw(11) << std::scientific << std::setprecision(2) << c.p_value
+          << std::defaultfloat << "  "
+          << (c.slower ? "SLOWER" : c.faster ? "faster" : "~") << "\n";
+    }
+}
+} // namespace smath::bench
+#endif // SMATH_BENCH_REPORT_HPP
@@ -0,0 +1,82 @@
+/*
+    Skinning kernels against blending the Mat4 palette per vertex, on a
+    64-bone rig with four neighbouring influences per vertex.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t count = 4096;
+
+struct Mesh {
+    static constexpr std::uint32_t bone_count = 64;
+    std::vector<Vec<4, std::uint32_t>> bones;
+    std::vector<Vec4f> weights;
+    std::vector<Vec3f> positions;
+    std::vector<Vec3f> normals;
+    std::vector<Mat4f> matrices;
+    std::vector<DualQuatf> dual_quats;
+
+    Mesh() {
+        Random random(5);
+        for (std::size_t i = 0; i < count; i++) {
+            const std::uint32_t b = random.next() % (bone_count - 5);
+            bones.push_back(Vec<4, std::uint32_t>(b, b + 1, b + 2, b + 5));
+            weights.push_back(Vec4f(0.55f, 0.25f, 0.15f, 0.05f));
+            positions.push_back(Vec3f(random.uniform(-1.0f, 1.0f), random.uniform(-1.0f, 1.0f),
+                                      random.uniform(-1.0f, 1.0f)));
+            normals.push_back(Vec3f(0, 1, 0));
+        }
+        for (std::uint32_t b = 0; b < bone_count; b++) {
+            const Mat4f bone = translation3(0.1f * static_cast<float>(b), 0.0f,
+                                            -0.05f * static_cast<float>(b))
+                                   .cross(rotation(0.05f * static_cast<float>(b), Vec3f(1, 0, 1)));
+            matrices.push_back(bone);
+            dual_quats.push_back(DualQuatf::from_mat4(bone));
+        }
+    }
+    SkinStreams<float> streams() const { return {bones, weights, positions, normals}; }
+};
+
+// What users write without the skinning API: blend the Mat4 palette per vertex.
+void skin_by_hand(const Mesh &mesh, std::vector<Vec3f> &positions, std::vector<Vec3f> &normals) {
+    for (std::size_t i = 0; i < count; i++) {
+        Mat4f blended{};
+        for (unsigned int k = 0; k < 4; k++) {
+            blended += mesh.weights[i][k] * mesh.matrices[mesh.bones[i][k]];
+        }
+        const Vec4f p = blended * mesh.positions[i].expand(1.0f);
+        const Vec4f n = blended * mesh.normals[i].expand(0.0f);
+        positions[i] = Vec3f(p[0], p[1], p[2]);
+        normals[i] = Vec3f(n[0], n[1], n[2]).normalize_or_zero();
+    }
+}
+} // namespace
+
+BENCH(skinning) {
+    const Mesh mesh;
+    std::vector<Vec3f> positions(count);
+    std::vector<Vec3f> normals(count);
+
+    b.run("Mat4 per vertex", count, [&] {
+        skin_by_hand(mesh, positions, normals);
+        do_not_optimize(positions.data());
+    });
+    b.run("skin_linear", count, [&] {
+        skin_linear(mesh.matrices, mesh.streams(), {positions, normals});
+        do_not_optimize(positions.data());
+    });
+    b.run("skin_linear par", count, [&] {
+        skin_linear(execution::par, mesh.matrices, mesh.streams(), {positions, normals});
+        do_not_optimize(positions.data());
+    });
+    b.run("skin_dual_quat", count, [&] {
+        skin_dual_quat(mesh.dual_quats, mesh.streams(), {positions, normals});
+        do_not_optimize(positions.data());
+    });
+}
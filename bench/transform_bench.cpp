@@ -0,0 +1,99 @@
+/*
+    Bulk transforms and rotations against the per element loops they
+    replace, one row per vertex layout.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t count = 4096;
+
+std::vector<Vec3f> make_points() {
+    Random random(7);
+    std::vector<Vec3f> result(count);
+    for (Vec3f &p : result) {
+        p = Vec3f(random.uniform(-50.0f, 50.0f), random.uniform(-50.0f, 50.0f),
+                  random.uniform(-50.0f, 50.0f));
+    }
+    return result;
+}
+} // namespace
+
+BENCH(transform) {
+    const Mat4f m = translation3(1.0f, -2.0f, 3.0f).cross(rotation(0.4f, Vec3f(0, 1, 1)));
+    const std::vector<Vec3f> points = make_points();
+    std::vector<Vec3f> out(count);
+    const VecArray3f soa{std::span<const Vec3f>(points)};
+    VecArray3f soa_out(count);
+    const std::vector<PaddedVec3f> padded(points.begin(), points.end());
+    std::vector<PaddedVec3f> padded_out(count);
+
+    b.run("transform_points loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            const Vec4f p = m.cross(points[i].expand(1.0f));
+            out[i] = Vec3f(p[0], p[1], p[2]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("transform_points span", count, [&] {
+        transform_points(m, points, out);
+        do_not_optimize(out.data());
+    });
+    b.run("transform_points soa", count, [&] {
+        transform_points(m, soa, soa_out);
+        do_not_optimize(soa_out);
+    });
+    b.run("transform_points padded", count, [&] {
+        transform_points(m, padded, padded_out);
+        do_not_optimize(padded_out.data());
+    });
+    b.run("transform_vectors span", count, [&] {
+        transform_vectors(m, points, out);
+        do_not_optimize(out.data());
+    });
+    b.run("transform_vectors padded", count, [&] {
+        transform_vectors(m, padded, padded_out);
+        do_not_optimize(padded_out.data());
+    });
+}
+
+BENCH(rotate) {
+    const std::vector<Vec3f> vectors = make_points();
+    std::vector<Quat<float>> rotations(count);
+    Random random(11);
+    for (Quat<float> &q : rotations) {
+        const float half = random.uniform(-1.5f, 1.5f);
+        q = Quat<float>(std::cos(half), Vec3f(0.6f, 0.0f, 0.8f) * std::sin(half));
+    }
+    std::vector<Vec3f> out(count);
+
+    b.run("to_mat3 + cross loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = rotations[i].to_mat3().cross(vectors[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("q v q* loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = rotations[i]
+                         .mul(Quat<float>(0, vectors[i]))
+                         .mul(rotations[i].conjugate())
+                         .vector();
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("rotate loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = rotations[i].rotate(vectors[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("rotate_vectors", count, [&] {
+        rotate_vectors(rotations, vectors, out);
+        do_not_optimize(out.data());
+    });
+}
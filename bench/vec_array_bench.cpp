@@ -0,0 +1,105 @@
+/*
+    VecArray (SoA) operations against the same loop over a std::vector of
+    Vec, ns/op is per element.
+*/
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t count = 4096;
+
+std::vector<Vec3f> make_vecs(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<Vec3f> result(count);
+    for (Vec3f &v : result) {
+        v = Vec3f(random.uniform(-10.0f, 10.0f), random.uniform(-10.0f, 10.0f),
+                  random.uniform(-10.0f, 10.0f));
+    }
+    return result;
+}
+} // namespace
+
+BENCH(vec_array) {
+    const std::vector<Vec3f> a = make_vecs(1);
+    const std::vector<Vec3f> c = make_vecs(2);
+    const VecArray3f soa_a{std::span<const Vec3f>(a)};
+    const VecArray3f soa_c{std::span<const Vec3f>(c)};
+    std::vector<Vec3f> out(count);
+    std::vector<float> scalars(count);
+    VecArray3f soa_out(count);
+
+    b.run("a + b loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = a[i] + c[i];
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("a + b", count, [&] {
+        soa_out = soa_a;
+        soa_out += soa_c;
+        do_not_optimize(soa_out);
+    });
+    b.run("a * s loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = a[i] * 1.5f;
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("a * s", count, [&] {
+        soa_out = soa_a;
+        soa_out *= 1.5f;
+        do_not_optimize(soa_out);
+    });
+    b.run("dot loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            scalars[i] = a[i].dot(c[i]);
+        }
+        do_not_optimize(scalars.data());
+    });
+    b.run("dot", count, [&] {
+        std::vector<float> dot = soa_a.dot(soa_c);
+        do_not_optimize(dot.data());
+    });
+    b.run("length loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            scalars[i] = a[i].length();
+        }
+        do_not_optimize(scalars.data());
+    });
+    b.run("length", count, [&] {
+        std::vector<float> length = soa_a.length();
+        do_not_optimize(length.data());
+    });
+    b.run("cross loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = a[i].cross(c[i]);
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("cross", count, [&] {
+        soa_out = soa_a.cross(soa_c);
+        do_not_optimize(soa_out);
+    });
+    b.run("normalize_or_zero loop", count, [&] {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = a[i].normalize_or_zero();
+        }
+        do_not_optimize(out.data());
+    });
+    b.run("normalize_or_zero", count, [&] {
+        soa_out = soa_a.normalize_or_zero();
+        do_not_optimize(soa_out);
+    });
+    b.run("from AoS", count, [&] {
+        soa_out = VecArray3f{std::span<const Vec3f>(a)};
+        do_not_optimize(soa_out);
+    });
+    b.run("to AoS", count, [&] {
+        soa_a.to_aos(out);
+        do_not_optimize(out.data());
+    });
+}
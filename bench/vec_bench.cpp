@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "smath.hpp"
+#include <vector>
+
+using namespace smath;
+using namespace smath::bench;
+
+namespace {
+constexpr std::size_t batch = 256;
+
+template <unsigned int N, class T> std::vector<Vec<N, T>> make_vecs(std::uint64_t seed) {
+    Random random(seed);
+    std::vector<Vec<N, T>> result(batch);
+    for (Vec<N, T> &v : result) {
+        for (unsigned int i = 0; i < N; i++) {
+            v.unchecked(i) = random.uniform<T>(T(1), T(9));
+        }
+    }
+    return result;
+}
+
+// Every public Vec operation of one element type and size.
+template <unsigned int N, class T> void vec_ops(Bench &b, const char *type) {
+    const std::vector<Vec<N, T>> a = make_vecs<N, T>(1);
+    const std::vector<Vec<N, T>> c = make_vecs<N, T>(2);
+    const std::string prefix = std::string(type) + " ";
+    const T s = T(3);
+    b.map(prefix + "a + b", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x + y; });
+    b.map(prefix + "a - b", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x - y; });
+    b.map(prefix + "a * b", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x * y; });
+    b.map(prefix + "a * s", a, [s](const Vec<N, T> &x) { return x * s; });
+    b.map(prefix + "a / s", a, [s](const Vec<N, T> &x) { return x / s; });
+    b.map(prefix + "-a", a, [](const Vec<N, T> &x) { return -x; });
+    b.map(prefix + "a += b", a, c, [](Vec<N, T> x, const Vec<N, T> &y) { return x += y; });
+    b.map(prefix + "a *= s", a, [s](Vec<N, T> x) { return x *= s; });
+    b.map(prefix + "a /= b", a, c, [](Vec<N, T> x, const Vec<N, T> &y) { return x /= y; });
+    b.map(prefix + "a < b", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x < y; });
+    b.map(prefix + "a == b", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x == y; });
+    b.map(prefix + "lazy a * s + b - a", a, c, [s](const Vec<N, T> &x, const Vec<N, T> &y) {
+        return Vec<N, T>(lazy(x) * s + y - x);
+    });
+    b.map(prefix + "dot", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x.dot(y); });
+    b.map(prefix + "length", a, [](const Vec<N, T> &x) { return x.length(); });
+    b.map(prefix + "length2", a, [](const Vec<N, T> &x) { return x.length2(); });
+    if constexpr (std::is_floating_point_v<T>) {
+        b.map(prefix + "normalize", a, [](const Vec<N, T> &x) { return x.normalize(); });
+        b.map(prefix + "normalize_or_zero", a,
+              [](const Vec<N, T> &x) { return x.normalize_or_zero(); });
+        b.map(prefix + "angle", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x.angle(y); });
+    }
+    if constexpr (N < 32) {
+        b.map(prefix + "expand", a, [](const Vec<N, T> &x) { return x.expand(T(1)); });
+    }
+    b.map(prefix + "combine", a, c,
+          [](const Vec<N, T> &x, const Vec<N, T> &y) { return x.combine(y); });
+    b.map(prefix + "swizzle [0, 1]", a, [](const Vec<N, T> &x) { return x[0, 1]; });
+    b.map(prefix + "swizzle<2, 0, 1, 0>", a,
+          [](const Vec<N, T> &x) { return x.template swizzle<2, 0, 1, 0>(); });
+    b.map(prefix + "swizzle [2, 0, 1, 0]", a, [](const Vec<N, T> &x) { return x[2, 0, 1, 0]; });
+    b.map(prefix + "any", a, [](const Vec<N, T> &x) { return x.any(); });
+    if constexpr (N == 3 && std::is_floating_point_v<T>) {
+        b.map(prefix + "cross", a, c, [](const Vec<N, T> &x, const Vec<N, T> &y) { return x.cross(y); });
+        b.map(prefix + "project", a, c,
+              [](const Vec<N, T> &x, const Vec<N, T> &y) { return x.project(y); });
+        b.map(prefix + "rotate", a, c,
+              [](const Vec<N, T> &x, const Vec<N, T> &y) { return x.rotate(T(0.3), y); });
+    }
+}
+} // namespace
+
+BENCH(vec3f) { vec_ops<3, float>(b, "Vec3f"); }
+BENCH(vec4f) { vec_ops<4, float>(b, "Vec4f"); }
+BENCH(vec3d) { vec_ops<3, double>(b, "Vec3d"); }
+BENCH(vec4d) { vec_ops<4, double>(b, "Vec4d"); }
+// Beyond the SIMD kernels, the generic loops. Vec16u was the old
+// vec_performance_test.
+BENCH(vec16) {
+    vec_ops<16, float>(b, "Vec16f");
+    vec_ops<16, unsigned int>(b, "Vec16u");
+}
@@ -0,0 +1,121 @@
+#ifndef SMATH_AFFINE_HPP
+#define SMATH_AFFINE_HPP
+
+#include "mat.hpp"
+#include "vec.hpp"
+#include <type_traits>
+
+namespace smath {
+/*
+    A Mat4 tagged as an affine transform [A t; 0 1]. The tag picks the cheap
+    inverse automatically:
+    Affine<T>        -> inverse_affine(), closed-form 3x3 inverse of A
+    Affine<T, true>  -> inverse_rigid(), A is a rotation and is transposed
+    The tag is trusted, wrapping a projection matrix gives wrong inverses.
+*/
+template <class T, bool IsRigid = false>
+    requires(std::is_floating_point_v<T>)
+class Affine {
+  private:
+    Mat<4, 4, T> matrix = Mat<4, 4, T>::identity();
+
+  public:
+    static constexpr bool is_rigid = IsRigid;
+
+    /***************************************
+            Constructors
+    ****************************************/
+    constexpr Affine() = default;
+    /**
+     * @brief Wrap a matrix whose bottom row is 0 0 0 1.
+     */
+    constexpr explicit Affine(const Mat<4, 4, T> &matrix) : matrix(matrix) {}
+    /**
+     * @brief Build [linear translation; 0 1].
+     */
+    constexpr Affine(const Mat<3, 3, T> &linear, const Vec<3, T> &translation) {
+        for (unsigned int c = 0; c < 3; c++) {
+            for (unsigned int r = 0; r < 3; r++) {
+                matrix.unchecked(c * 4 + r) = linear.unchecked(c * 3 + r);
+            }
+            matrix.unchecked(12 + c) = translation.unchecked(c);
+        }
+    }
+    // A rigid transform is still affine, the other way around is explicit.
+    constexpr operator Affine<T, false>() const
+        requires(IsRigid)
+    {
+        return Affine<T, false>(matrix);
+    }
+
+    /***************************************
+            Getters
+    ****************************************/
+    constexpr const Mat<4, 4, T> &mat() const { return matrix; }
+    constexpr Mat<3, 3, T> linear() const { return matrix.to_mat3(); }
+    constexpr Vec<3, T> translation() const {
+        return Vec<3, T>(matrix.unchecked(12), matrix.unchecked(13),
+                         matrix.unchecked(14));
+    }
+
+    /***************************************
+            Methods
+    ****************************************/
+    constexpr Affine inverse() const {
+        if constexpr (IsRigid) {
+            return Affine(matrix.inverse_rigid());
+        } else {
+            return Affine(matrix.inverse_affine());
+        }
+    }
+    /**
+     * @return A p + t
+     */
+    constexpr Vec<3, T> transform_point(const Vec<3, T> &point) const {
+        Vec<3, T> result = translation();
+        for (unsigned int c = 0; c < 3; c++) {
+            for (unsigned int r = 0; r < 3; r++) {
+                result.unchecked(r) +=
+                    matrix.unchecked(c * 4 + r) * point.unchecked(c);
+            }
+        }
+        return result;
+    }
+    /**
+     * @return A v, the translation does not apply to directions.
+     */
+    constexpr Vec<3, T> transform_vector(const Vec<3, T> &vector) const {
+        Vec<3, T> result{};
+        for (unsigned int c = 0; c < 3; c++) {
+            for (unsigned int r = 0; r < 3; r++) {
+                result.unchecked(r) +=
+                    matrix.unchecked(c * 4 + r) * vector.unchecked(c);
+            }
+        }
+        return result;
+    }
+
+    /***************************************
+            Operators Overload
+    ****************************************/
+    /**
+     * @brief Composition, b is applied first. Stays in the same tag.
+     */
+    friend constexpr Affine operator*(const Affine &a, const Affine &b) {
+        return Affine(a.matrix.cross(b.matrix));
+    }
+    friend constexpr Vec<4, T> operator*(const Affine &a, const Vec<4, T> &b) {
+        return a.matrix.cross(b);
+    }
+    friend std::ostream &operator<<(std::ostream &o, const Affine &a) {
+        o << a.matrix;
+        return o;
+    }
+};
+template <class T> using Rigid = Affine<T, true>;
+using Affine3f = Affine<float>;
+using Affine3d = Affine<double>;
+using Rigid3f = Rigid<float>;
+using Rigid3d = Rigid<double>;
+} // namespace smath
+#endif // SMATH_AFFINE_HPP
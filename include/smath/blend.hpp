@@ -0,0 +1,201 @@
+#ifndef SMATH_BLEND_HPP
+#define SMATH_BLEND_HPP
+
+#include "config.hpp"
+#include "execution.hpp"
+#include "quat.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    Batched quaternion blending for animation: out[i] = blend(a[i], b[i], t)
+    with one t for every pair or one t per pair.
+
+    The pairs are staged through SoA chunks like the bulk transforms and
+    blended on whole registers. Every mode takes the shortest path and
+    renormalizes its result, t is expected in [0, 1].
+    nlerp  -> normalized lerp, the cheapest, speed varies along the arc
+    onlerp -> nlerp with a corrected t, within 1.5e-3 rad of slerp
+    slerp  -> polynomial acos/sin (fast.hpp), within 1e-6 of std:: slerp
+
+    out may be a or b (in place), but must not otherwise overlap them.
+*/
+namespace detail {
+constexpr std::size_t blend_chunk = 64;
+
+template <class T> constexpr std::size_t blend_grain() {
+    const std::size_t grain = execution::grain(13 * sizeof(T));
+    return std::max(blend_chunk, grain - grain % blend_chunk);
+}
+
+template <simd::Blend Mode, class T>
+void blend_aos(const T *a, const T *b, const T *t, bool per_pair, T *out,
+               std::size_t n) {
+    alignas(64) T sa[4][blend_chunk];
+    alignas(64) T sb[4][blend_chunk];
+    alignas(64) T st[blend_chunk];
+    const T *const a_soa[4] = {sa[0], sa[1], sa[2], sa[3]};
+    const T *const b_soa[4] = {sb[0], sb[1], sb[2], sb[3]};
+    T *const out_soa[4] = {sa[0], sa[1], sa[2], sa[3]};
+    if (!per_pair) {
+        std::fill(st, st + blend_chunk, *t);
+    }
+    for (std::size_t base = 0; base < n; base += blend_chunk) {
+        const std::size_t count = std::min(blend_chunk, n - base);
+        simd::deinterleave4(a + 4 * base, sa[0], sa[1], sa[2], sa[3], count);
+        simd::deinterleave4(b + 4 * base, sb[0], sb[1], sb[2], sb[3], count);
+        simd::blend4<Mode>(a_soa, b_soa, per_pair ? t + base : st, out_soa,
+                           count);
+        simd::interleave4(sa[0], sa[1], sa[2], sa[3], out + 4 * base, count);
+    }
+}
+template <simd::Blend Mode, class Policy, class T>
+void blend_span(Policy &&policy, std::span<const Quat<T>> a,
+                std::span<const Quat<T>> b, std::span<const T> t, bool per_pair,
+                std::span<Quat<T>> out) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Quaternion span size mismatched.");
+    }
+    if (a.size() != out.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    if (per_pair && t.size() != a.size()) {
+        throw std::invalid_argument("Parameter span size mismatched.");
+    }
+    static_assert(sizeof(Quat<T>) == 4 * sizeof(T));
+    const T *packed_a = reinterpret_cast<const T *>(a.data());
+    const T *packed_b = reinterpret_cast<const T *>(b.data());
+    T *packed_out = reinterpret_cast<T *>(out.data());
+    execution::for_each_range(
+        policy, a.size(), blend_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            blend_aos<Mode>(packed_a + 4 * begin, packed_b + 4 * begin,
+                            per_pair ? t.data() + begin : t.data(), per_pair,
+                            packed_out + 4 * begin, end - begin);
+        });
+}
+} // namespace detail
+
+/**
+ * @brief out[i] = nlerp(a[i], b[i], t), t shared by every pair or one per
+ * pair.
+ */
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void nlerp(Policy &&policy, const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           const detail::quat_scalar_t<Quats> &t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::blend_span<simd::Blend::nlerp>(policy, std::span<const Quat<T>>(a),
+                                           std::span<const Quat<T>>(b),
+                                           std::span<const T>(&t, 1), false, out);
+}
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void nlerp(Policy &&policy, const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           std::span<const detail::quat_scalar_t<Quats>> t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::blend_span<simd::Blend::nlerp>(policy, std::span<const Quat<T>>(a),
+                                           std::span<const Quat<T>>(b),
+                                           t, true, out);
+}
+template <QuatRange Quats>
+void nlerp(const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           const detail::quat_scalar_t<Quats> &t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    nlerp(execution::seq, a, b, t, out);
+}
+template <QuatRange Quats>
+void nlerp(const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           std::span<const detail::quat_scalar_t<Quats>> t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    nlerp(execution::seq, a, b, t, out);
+}
+
+/**
+ * @brief out[i] = onlerp(a[i], b[i], t), nlerp with the t correction of
+ * fast::onlerp_t.
+ */
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void onlerp(Policy &&policy, const Quats &a,
+            std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+            const detail::quat_scalar_t<Quats> &t,
+            std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::blend_span<simd::Blend::onlerp>(policy, std::span<const Quat<T>>(a),
+                                            std::span<const Quat<T>>(b),
+                                            std::span<const T>(&t, 1), false, out);
+}
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void onlerp(Policy &&policy, const Quats &a,
+            std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+            std::span<const detail::quat_scalar_t<Quats>> t,
+            std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::blend_span<simd::Blend::onlerp>(policy, std::span<const Quat<T>>(a),
+                                            std::span<const Quat<T>>(b),
+                                            t, true, out);
+}
+template <QuatRange Quats>
+void onlerp(const Quats &a,
+            std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+            const detail::quat_scalar_t<Quats> &t,
+            std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    onlerp(execution::seq, a, b, t, out);
+}
+template <QuatRange Quats>
+void onlerp(const Quats &a,
+            std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+            std::span<const detail::quat_scalar_t<Quats>> t,
+            std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    onlerp(execution::seq, a, b, t, out);
+}
+
+/**
+ * @brief out[i] = slerp(a[i], b[i], t) through polynomial acos/sin, within
+ * 1e-6 of the <cmath> result for unit quaternions.
+ */
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void slerp(Policy &&policy, const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           const detail::quat_scalar_t<Quats> &t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::blend_span<simd::Blend::slerp>(policy, std::span<const Quat<T>>(a),
+                                           std::span<const Quat<T>>(b),
+                                           std::span<const T>(&t, 1), false, out);
+}
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void slerp(Policy &&policy, const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           std::span<const detail::quat_scalar_t<Quats>> t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::blend_span<simd::Blend::slerp>(policy, std::span<const Quat<T>>(a),
+                                           std::span<const Quat<T>>(b),
+                                           t, true, out);
+}
+template <QuatRange Quats>
+void slerp(const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           const detail::quat_scalar_t<Quats> &t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    slerp(execution::seq, a, b, t, out);
+}
+template <QuatRange Quats>
+void slerp(const Quats &a,
+           std::span<const Quat<detail::quat_scalar_t<Quats>>> b,
+           std::span<const detail::quat_scalar_t<Quats>> t,
+           std::span<Quat<detail::quat_scalar_t<Quats>>> out) {
+    slerp(execution::seq, a, b, t, out);
+}
+} // namespace smath
+#endif // SMATH_BLEND_HPP
@@ -2,6 +2,7 @@
 #define SMATH_COMMON_HPP
 
 #include "quat.hpp"
+#include "vec_array.hpp"
 #include <concepts>
 #include <stdexcept>
 #include <type_traits>
@@ -34,9 +35,10 @@ constexpr Vec<N, T> clamp(const Vec<N, T> &target, const Vec<N, T> &lower,
                           const Vec<N, T> &upper) {
     Vec<N, T> result{};
     for (unsigned int i = 0; i < N; i++) {
-        result[i] = (target[i] < lower[i])   ? lower[i]
-                    : (target[i] > upper[i]) ? upper[i]
-                                             : target[i];
+        const T &t = target.unchecked(i);
+        const T &l = lower.unchecked(i);
+        const T &u = upper.unchecked(i);
+        result.unchecked(i) = (t < l) ? l : (t > u) ? u : t;
     }
     return result;
 }
@@ -45,9 +47,8 @@ constexpr Vec<N, T> clamp(const Vec<N, T> &target, const T &lower,
                           const T &upper) {
     Vec<N, T> result{};
     for (unsigned int i = 0; i < N; i++) {
-        result[i] = (target[i] < lower)   ? lower
-                    : (target[i] > upper) ? upper
-                                          : target[i];
+        const T &t = target.unchecked(i);
+        result.unchecked(i) = (t < lower) ? lower : (t > upper) ? upper : t;
     }
     return result;
 }
@@ -57,9 +58,10 @@ constexpr Mat<M, N, T> clamp(const Mat<M, N, T> &target,
                              const Mat<M, N, T> &upper) {
     Mat<M, N, T> result{};
     for (unsigned int i = 0; i < N * M; i++) {
-        result[i] = (target[i] < lower[i])   ? lower[i]
-                    : (target[i] > upper[i]) ? upper[i]
-                                             : target[i];
+        const T &t = target.unchecked(i);
+        const T &l = lower.unchecked(i);
+        const T &u = upper.unchecked(i);
+        result.unchecked(i) = (t < l) ? l : (t > u) ? u : t;
     }
     return result;
 }
@@ -68,9 +70,36 @@ constexpr Mat<M, N, T> clamp(const Mat<M, N, T> &target, const T &lower,
                              const T &upper) {
     Mat<M, N, T> result{};
     for (unsigned int i = 0; i < N * M; i++) {
-        result[i] = (target[i] < lower)   ? lower
-                    : (target[i] > upper) ? upper
-                                          : target[i];
+        const T &t = target.unchecked(i);
+        result.unchecked(i) = (t < lower) ? lower : (t > upper) ? upper : t;
+    }
+    return result;
+}
+template <unsigned int N, class T>
+VecArray<N, T> clamp(const VecArray<N, T> &target, const T &lower,
+                     const T &upper) {
+    VecArray<N, T> result(target.size());
+    for (unsigned int c = 0; c < N; c++) {
+        const T *SMATH_RESTRICT in = target.component(c).data();
+        T *SMATH_RESTRICT out = result.component(c).data();
+        for (std::size_t i = 0; i < target.size(); i++) {
+            out[i] = (in[i] < lower) ? lower : (in[i] > upper) ? upper : in[i];
+        }
+    }
+    return result;
+}
+template <unsigned int N, class T>
+VecArray<N, T> clamp(const VecArray<N, T> &target, const Vec<N, T> &lower,
+                     const Vec<N, T> &upper) {
+    VecArray<N, T> result(target.size());
+    for (unsigned int c = 0; c < N; c++) {
+        const T l = lower.unchecked(c);
+        const T u = upper.unchecked(c);
+        const T *SMATH_RESTRICT in = target.component(c).data();
+        T *SMATH_RESTRICT out = result.component(c).data();
+        for (std::size_t i = 0; i < target.size(); i++) {
+            out[i] = (in[i] < l) ? l : (in[i] > u) ? u : in[i];
+        }
     }
     return result;
 }
@@ -88,9 +117,8 @@ constexpr Vec<N, T> saturate(const Vec<N, T> &target) {
     const T upper = static_cast<T>(1.0f);
     Vec<N, T> result{};
     for (unsigned int i = 0; i < N; i++) {
-        result[i] = (target[i] < lower)   ? lower
-                    : (target[i] > upper) ? upper
-                                          : target[i];
+        const T &t = target.unchecked(i);
+        result.unchecked(i) = (t < lower) ? lower : (t > upper) ? upper : t;
     }
     return result;
 }
@@ -100,13 +128,17 @@ constexpr Mat<M, N, T> saturate(const Mat<M, N, T> &target) {
     const T upper = static_cast<T>(1.0f);
     Mat<M, N, T> result{};
     for (unsigned int i = 0; i < N * M; i++) {
-        result[i] = (target[i] < lower)   ? lower
-                    : (target[i] > upper) ? upper
-                                          : target[i];
+        const T &t = target.unchecked(i);
+        result.unchecked(i) = (t < lower) ? lower : (t > upper) ? upper : t;
     }
     return result;
 }
 
+template <unsigned int N, class T>
+VecArray<N, T> saturate(const VecArray<N, T> &target) {
+    return clamp(target, static_cast<T>(0.0f), static_cast<T>(1.0f));
+}
+
 /***************************************
         Mix (Linear)
 ***************************************/
@@ -119,7 +151,7 @@ constexpr T mix(const T &a, const T &b, const float &mix) {
 template <unsigned int N, class T>
 constexpr Vec<N, T> mix(const Vec<N, T> &a, const Vec<N, T> &b,
                         const float &mix) {
-    return (b - a) * mix + a;
+    return (lazy(b) - a) * mix + a;
 }
 
 template <unsigned int M, unsigned int N, class T>
@@ -128,6 +160,25 @@ constexpr Mat<M, N, T> mix(const Mat<M, N, T> &a, const Mat<M, N, T> &b,
     return (b - a) * mix + a;
 }
 
+template <unsigned int N, class T>
+VecArray<N, T> mix(const VecArray<N, T> &a, const VecArray<N, T> &b,
+                   const float &mix) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("VecArray sizes mismatched.");
+    }
+    const T t = static_cast<T>(mix);
+    VecArray<N, T> result(a.size());
+    for (unsigned int c = 0; c < N; c++) {
+        const T *SMATH_RESTRICT in_a = a.component(c).data();
+        const T *SMATH_RESTRICT in_b = b.component(c).data();
+        T *SMATH_RESTRICT out = result.component(c).data();
+        for (std::size_t i = 0; i < a.size(); i++) {
+            out[i] = (in_b[i] - in_a[i]) * t + in_a[i];
+        }
+    }
+    return result;
+}
+
 /***************************************
         Step
 ***************************************/
@@ -140,8 +191,9 @@ template <unsigned int N, class T>
 constexpr Vec<N, T> step(const Vec<N, T> &value, const T &threshold) {
     Vec<N, T> result{};
     for (unsigned int i = 0; i < N; i++) {
-        result = (value[i] > threshold) ? static_cast<T>(1.0f)
-                                        : static_cast<T>(0.0f);
+        result.unchecked(i) = (value.unchecked(i) > threshold)
+                                  ? static_cast<T>(1.0f)
+                                  : static_cast<T>(0.0f);
     }
     return result;
 }
@@ -150,8 +202,9 @@ constexpr Mat<M, N, T> step(const Mat<M, N, T> &value,
                                    const T &threshold) {
     Mat<M, N, T> result{};
     for (unsigned int i = 0; i < M * N; i++) {
-        result = (value[i] > threshold) ? static_cast<T>(1.0f)
-                                        : static_cast<T>(0.0f);
+        result.unchecked(i) = (value.unchecked(i) > threshold)
+                                  ? static_cast<T>(1.0f)
+                                  : static_cast<T>(0.0f);
     }
     return result;
 }
@@ -177,19 +230,24 @@ constexpr Mat<M,N,T> smooth_step(const T &low, const T &high, const Mat<M,N,T> &
     Reflect + Refract
 ***************************************/
 template<class T>
-Vec<3,T> reflect(const Vec<3,T> incident, const Vec<3,T> normal) {
-    return incident - 2.0f * normal.dot(incident) * normal;
+constexpr Vec<3,T> reflect(const Vec<3,T> incident, const Vec<3,T> normal) {
+    return lazy(incident) - lazy(normal) * (2 * normal.dot(incident));
 }
+/**
+ * @return Refraction of a unit incident through a unit normal with ratio
+ * r = n_0 / n_1, zero-vector on total internal reflection (like GLSL).
+ */
 template<class T>
-Vec<3, T> refract(const Vec<3,T> incident, const Vec<3,T> normal, const T& n_0, const T& n_1) {
-    const T  r = n_0/n_1;
-    auto I_N = incident.dot(normal);
-    return r*incident-(r*(incident.dot(normal)))+std::sqrt(1-(r*r)*(1-(I_N*I_N))*normal);
+Vec<3, T> refract(const Vec<3,T> incident, const Vec<3,T> normal, const T& r) {
+    const T I_N = incident.dot(normal);
+    const T k = 1 - r * r * (1 - I_N * I_N);
+    if (k < 0)
+        return Vec<3, T>{};
+    return lazy(incident) * r - lazy(normal) * (r * I_N + std::sqrt(k));
 }
 template<class T>
-Vec<3, T> refract(const Vec<3,T> incident, const Vec<3,T> normal, const T& r) {
-    auto I_N = incident.dot(normal);
-    return r*incident-(r*(incident.dot(normal)))+std::sqrt(1-(r*r)*(1-(I_N*I_N))*normal);
+Vec<3, T> refract(const Vec<3,T> incident, const Vec<3,T> normal, const T& n_0, const T& n_1) {
+    return refract(incident, normal, n_0 / n_1);
 }
 
 /***************************************
@@ -200,7 +258,7 @@ requires (std::is_arithmetic_v<T>)
 Vec<N,T> absolute(const Vec<N,T>& vec) {
     Vec<N,T> result(vec);
     for (unsigned int i = 0; i < N; i++){
-        result[i] = std::abs(result[i]);
+        result.unchecked(i) = std::abs(result.unchecked(i));
     }
     return result;
 }
@@ -209,7 +267,7 @@ requires (std::is_arithmetic_v<T>)
 Mat<M,N,T> absolute(const Mat<M,N,T>& mat) {
     Mat<M,N,T> result(mat);
     for (unsigned int i = 0; i < M*N; i++){
-        result[i] = static_cast<T>(std::abs(result[i]));
+        result.unchecked(i) = static_cast<T>(std::abs(result.unchecked(i)));
     }
     return result;
 }
@@ -225,7 +283,7 @@ T distance(const Vec<N,T> &a, const Vec<N,T> &b, const float &dimension){
     T temp = static_cast<T>(0.0f);
     using namespace std;
     for(unsigned int i = 0; i < N; i++){
-        temp += (pow(abs(a[i] - b[i]),dimension));
+        temp += (pow(abs(a.unchecked(i) - b.unchecked(i)),dimension));
     }
     return static_cast<T>(pow(temp, 1/dimension));
 }
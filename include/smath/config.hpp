@@ -0,0 +1,58 @@
+#ifndef SMATH_CONFIG_HPP
+#define SMATH_CONFIG_HPP
+
+/*
+    SMATH_CHECKED
+    When non-zero, operator[] of Vec, Mat and Quat throws std::out_of_range on
+    an invalid index. It follows NDEBUG by default (checked in debug builds,
+    unchecked in release builds); define it to 0 or 1 to override.
+    Internal loops always go through the unchecked accessor.
+*/
+#ifndef SMATH_CHECKED
+#ifdef NDEBUG
+#define SMATH_CHECKED 0
+#else
+#define SMATH_CHECKED 1
+#endif
+#endif
+
+/*
+    SMATH_RESTRICT
+    Marks pointers in bulk kernels that never alias each other, so loops over
+    them can be vectorised without runtime overlap checks.
+*/
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define SMATH_RESTRICT __restrict
+#else
+#define SMATH_RESTRICT
+#endif
+
+/*
+    SMATH_SSE, SMATH_AVX, ...
+    Instruction sets the kernels of simd.hpp and fast.hpp may use, detected
+    from the compiler flags. Define SMATH_NO_SIMD before including smath to
+    force every operation back onto the scalar loops.
+*/
+#if !defined(SMATH_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMATH_SSE 1
+#endif
+#if defined(__AVX__)
+#define SMATH_AVX 1
+#endif
+#if defined(__AVX2__)
+#define SMATH_AVX2 1
+#endif
+#if defined(__FMA__)
+#define SMATH_FMA 1
+#endif
+#if defined(__F16C__)
+#define SMATH_F16C 1
+#endif
+#if defined(__AVX512F__)
+#define SMATH_AVX512 1
+#endif
+#endif
+
+#endif // SMATH_CONFIG_HPP
@@ -0,0 +1,167 @@
+#ifndef SMATH_DUAL_QUAT_HPP
+#define SMATH_DUAL_QUAT_HPP
+
+#include "mat.hpp"
+#include "quat.hpp"
+#include "vec.hpp"
+#include <cmath>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    Dual quaternion real + eps dual (eps^2 = 0) for rigid transforms: a unit
+    real part is the rotation r and dual = t r / 2 carries the translation t.
+    Eight scalars instead of a Mat4's sixteen, and weighted sums of unit dual
+    quaternions renormalize into valid rigid transforms (skinning without the
+    candy-wrapper collapse of blended matrices).
+*/
+template <class T>
+    requires(std::is_floating_point_v<T>)
+class DualQuat {
+  private:
+    Quat<T> real_part = Quat<T>::identity();
+    Quat<T> dual_part{};
+
+  public:
+    /***************************************
+            Constructors
+    ****************************************/
+    constexpr DualQuat() = default;
+    constexpr DualQuat(const Quat<T> &real, const Quat<T> &dual)
+        : real_part(real), dual_part(dual) {}
+    /**
+     * @brief Rotation by a unit quaternion followed by a translation.
+     */
+    constexpr DualQuat(const Quat<T> &rotation, const Vec<3, T> &translation)
+        : real_part(rotation),
+          dual_part(Quat<T>(0, translation).mul(rotation) * static_cast<T>(0.5)) {}
+    static constexpr DualQuat identity() { return DualQuat(); }
+    /**
+     * @brief From a rigid Mat4 [R t; 0 1], R through Quat::from_mat3.
+     */
+    static constexpr DualQuat from_mat4(const Mat<4, 4, T> &matrix) {
+        return DualQuat(Quat<T>::from_mat3(matrix.to_mat3()),
+                        Vec<3, T>(matrix.unchecked(12), matrix.unchecked(13),
+                                  matrix.unchecked(14)));
+    }
+
+    /***************************************
+            Getters
+    ****************************************/
+    constexpr const Quat<T> &real() const { return real_part; }
+    constexpr const Quat<T> &dual() const { return dual_part; }
+    constexpr const Quat<T> &rotation() const { return real_part; }
+    /**
+     * @return t = 2 dual real*, for a unit dual quaternion.
+     */
+    constexpr Vec<3, T> translation() const {
+        return dual_part.mul(real_part.conjugate()).vector() * static_cast<T>(2);
+    }
+    /**
+     * @return [R t; 0 1], R through Quat::to_mat3.
+     */
+    constexpr Mat<4, 4, T> to_mat4() const {
+        Mat<4, 4, T> result = real_part.to_mat4();
+        const Vec<3, T> t = translation();
+        for (unsigned int r = 0; r < 3; r++) {
+            result.unchecked(12 + r) = t.unchecked(r);
+        }
+        return result;
+    }
+
+    /***************************************
+            Operations
+    ****************************************/
+    /**
+     * @brief Composition, other is applied first (like Mat::cross).
+     */
+    constexpr DualQuat mul(const DualQuat &other) const {
+        return DualQuat(real_part.mul(other.real_part),
+                        real_part.mul(other.dual_part) +
+                            dual_part.mul(other.real_part));
+    }
+    /**
+     * @brief Quaternion conjugate of both parts.
+     */
+    constexpr DualQuat conjugate() const {
+        return DualQuat(real_part.conjugate(), dual_part.conjugate());
+    }
+    /**
+     * @brief Inverse of a unit dual quaternion, the conjugate of both parts.
+     */
+    constexpr DualQuat inverse() const { return conjugate(); }
+    /**
+     * @return Unit dual quaternion: real scaled to unit length and the dual
+     * part made orthogonal to it. Raise error on a zero real part.
+     */
+    constexpr DualQuat normalize() const {
+        const T length = real_part.length();
+        if (length == 0) {
+            throw std::logic_error("Cannot normalize a zero-dual-quaternion.");
+        }
+        const Quat<T> real = real_part / length;
+        const Quat<T> dual = dual_part / length;
+        return DualQuat(real, dual - real * real.dot(dual));
+    }
+    /**
+     * @return r p r* + t
+     */
+    constexpr Vec<3, T> transform_point(const Vec<3, T> &point) const {
+        return real_part.rotate(point) + translation();
+    }
+    /**
+     * @return r v r*, the translation does not apply to directions.
+     */
+    constexpr Vec<3, T> transform_vector(const Vec<3, T> &vector) const {
+        return real_part.rotate(vector);
+    }
+
+    /***************************************
+            Operators Overload
+    ****************************************/
+    friend constexpr DualQuat operator+(const DualQuat &a, const DualQuat &b) {
+        return DualQuat(a.real_part + b.real_part, a.dual_part + b.dual_part);
+    }
+    friend constexpr DualQuat operator*(const DualQuat &a, const T &b) {
+        return DualQuat(a.real_part * b, a.dual_part * b);
+    }
+    friend constexpr DualQuat operator*(const T &a, const DualQuat &b) {
+        return b * a;
+    }
+    friend constexpr DualQuat operator-(const DualQuat &a) {
+        return DualQuat(-a.real_part, -a.dual_part);
+    }
+    friend constexpr bool operator==(const DualQuat &a, const DualQuat &b) {
+        return static_cast<bool>(a.real_part == b.real_part) &&
+               static_cast<bool>(a.dual_part == b.dual_part);
+    }
+    friend std::ostream &operator<<(std::ostream &o, const DualQuat &q) {
+        o << "DualQuat (" << q.real_part << " + e " << q.dual_part << ")";
+        return o;
+    }
+};
+using DualQuatf = DualQuat<float>;
+using DualQuatd = DualQuat<double>;
+
+/**
+ * @brief Dual quaternion linear blending: sum of weights[i] * q[i], every q
+ * flipped onto the hemisphere of q[0], then normalized.
+ */
+template <class T>
+constexpr DualQuat<T> blend(std::span<const DualQuat<T>> q,
+                            std::span<const T> weights) {
+    if (q.size() != weights.size()) {
+        throw std::invalid_argument("Weight span size mismatched.");
+    }
+    DualQuat<T> sum = DualQuat<T>(Quat<T>(), Quat<T>());
+    for (std::size_t i = 0; i < q.size(); i++) {
+        const T sign = (q[i].real().dot(q[0].real()) < 0) ? -1 : 1;
+        sum = sum + q[i] * (weights[i] * sign);
+    }
+    return sum.normalize();
+}
+} // namespace smath
+#endif // SMATH_DUAL_QUAT_HPP
@@ -0,0 +1,237 @@
+#ifndef SMATH_EXECUTION_HPP
+#define SMATH_EXECUTION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace smath::execution {
+/*
+    Execution policies for the bulk APIs, mirroring std::execution:
+    seq       -> run on the calling thread
+    par       -> split into cache-sized chunks and run them on the pool
+    par_unseq -> an alias of par: the chunk kernels are vectorized under
+                 every policy, so there is no separate unsequenced path
+*/
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+template <class P>
+concept ExecutionPolicy =
+    std::is_same_v<std::remove_cvref_t<P>, sequenced_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, parallel_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, parallel_unsequenced_policy>;
+
+/**
+ * @brief Elements per chunk so that one chunk touches about 256 KiB (a
+ * typical L2 slice) given the bytes read and written per element.
+ */
+constexpr std::size_t grain(std::size_t bytes_per_element) {
+    constexpr std::size_t chunk_bytes = 256 * 1024;
+    return std::max<std::size_t>(1, chunk_bytes / bytes_per_element);
+}
+
+/*
+    Work-stealing thread pool. Every worker owns a deque: it pops its own
+    tasks from the back and, once empty, steals from the front of the
+    others. Tasks submitted from a worker go to its own deque; threads
+    outside the pool have none, so their tasks are spread round-robin over
+    the workers' deques. The thread waiting in parallel_for also runs
+    tasks, so nested calls cannot deadlock.
+*/
+class ThreadPool {
+  private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<unsigned int> next_queue{0};
+    bool stopping = false;
+    // Pool and deque of the current thread when it is a worker.
+    inline static thread_local const ThreadPool *worker_pool = nullptr;
+    inline static thread_local unsigned int worker_queue = 0;
+
+    /**
+     * @return Deque owned by the calling thread, or the next one in
+     * round-robin order for a thread outside this pool.
+     */
+    unsigned int own_queue() {
+        if (worker_pool == this)
+            return worker_queue;
+        return next_queue++ % static_cast<unsigned int>(queues.size());
+    }
+
+    bool pop(unsigned int self, std::function<void()> &task) {
+        {
+            Queue &own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pending--;
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i < queues.size(); i++) {
+            Queue &victim = *queues[(self + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending--;
+                return true;
+            }
+        }
+        return false;
+    }
+    void work(unsigned int self) {
+        worker_pool = this;
+        worker_queue = self;
+        std::function<void()> task;
+        while (true) {
+            if (pop(self, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] { return stopping || pending > 0; });
+            if (stopping && pending == 0)
+                return;
+        }
+    }
+    void push(std::function<void()> task) {
+        // Counted before it is visible, a thief decrements only after
+        // taking it, so pending never wraps below zero.
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            pending++;
+        }
+        {
+            Queue &queue = *queues[own_queue()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+  public:
+    /**
+     * @param threads Number of workers, the caller of parallel_for is not
+     * counted. With zero workers the caller runs every chunk itself.
+     */
+    explicit ThreadPool(unsigned int threads) {
+        for (unsigned int i = 0; i < std::max(1u, threads); i++) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned int i = 0; i < threads; i++) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+    /**
+     * @brief Process wide pool, one worker per hardware thread but the
+     * calling one.
+     */
+    static ThreadPool &instance() {
+        static ThreadPool pool(
+            std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+    unsigned int size() const {
+        return static_cast<unsigned int>(workers.size());
+    }
+
+    /**
+     * @brief Call body(begin, end) over [0, n) in chunks of grain elements
+     * and return once every chunk has run. The first exception thrown by a
+     * chunk is rethrown here.
+     */
+    template <class F>
+    void parallel_for(std::size_t n, std::size_t grain, F &&body) {
+        const std::size_t chunks = (n + grain - 1) / grain;
+        if (chunks <= 1 || workers.empty()) {
+            for (std::size_t begin = 0; begin < n; begin += grain) {
+                body(begin, std::min(n, begin + grain));
+            }
+            return;
+        }
+        struct Batch {
+            std::atomic<std::size_t> remaining;
+            std::mutex mutex;
+            std::exception_ptr error;
+        };
+        auto batch = std::make_shared<Batch>();
+        batch->remaining = chunks;
+        for (std::size_t c = 0; c < chunks; c++) {
+            const std::size_t begin = c * grain;
+            const std::size_t end = std::min(n, begin + grain);
+            push([batch, &body, begin, end] {
+                try {
+                    body(begin, end);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    if (!batch->error)
+                        batch->error = std::current_exception();
+                }
+                batch->remaining--;
+            });
+        }
+        // Help until the batch is drained, then wait for chunks still running.
+        const unsigned int self = own_queue();
+        std::function<void()> task;
+        while (batch->remaining > 0) {
+            if (pop(self, task)) {
+                task();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        if (batch->error)
+            std::rethrow_exception(batch->error);
+    }
+};
+
+/**
+ * @brief Run body(begin, end) over [0, n) according to the policy.
+ */
+template <ExecutionPolicy Policy, class F>
+void for_each_range(Policy &&, std::size_t n, std::size_t grain, F &&body) {
+    if constexpr (std::is_same_v<std::remove_cvref_t<Policy>,
+                                 sequenced_policy>) {
+        if (n > 0)
+            body(std::size_t{0}, n);
+    } else {
+        ThreadPool::instance().parallel_for(n, grain, body);
+    }
+}
+} // namespace smath::execution
+#endif // SMATH_EXECUTION_HPP
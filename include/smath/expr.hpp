@@ -0,0 +1,221 @@
+#ifndef SMATH_EXPR_HPP
+#define SMATH_EXPR_HPP
+
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace smath {
+template <unsigned int N, class T>
+    requires(std::is_arithmetic_v<T> && N <= 32)
+class Vec;
+
+/*
+    Lazy element-wise expressions over Vec.
+
+    lazy(a) * s + b - c builds a small tree of nodes instead of a Vec per
+    operator. Nothing is computed until the tree is assigned to (or used to
+    construct) a Vec, at which point the whole chain runs as one loop.
+
+    Nodes hold references to named Vec operands and copies of temporary
+    ones, so an expression must be materialised before the named operands
+    go out of scope:
+        Vec3f r = lazy(a) * s + b;   // fine
+        auto e = lazy(a) * s + b;    // fine while a and b are alive
+        auto f = lazy(a) + (b + c);  // b + c is copied into f
+*/
+template <class E>
+concept VecExpression = requires(const E &e, unsigned int i) {
+    requires E::is_vec_expression;
+    { E::size } -> std::convertible_to<unsigned int>;
+    { e.eval(i) } -> std::convertible_to<typename E::value_type>;
+};
+
+template <class V> struct is_vec : std::false_type {};
+template <unsigned int N, class T> struct is_vec<Vec<N, T>> : std::true_type {};
+
+template <class X>
+concept VecOperand = VecExpression<X> || is_vec<X>::value;
+
+/***************************************
+        Expression Nodes
+***************************************/
+template <unsigned int N, class T> class VecLeaf {
+  private:
+    const Vec<N, T> &vec;
+
+  public:
+    static constexpr bool is_vec_expression = true;
+    static constexpr unsigned int size = N;
+    using value_type = T;
+
+    constexpr explicit VecLeaf(const Vec<N, T> &vec) : vec(vec) {}
+    constexpr T eval(unsigned int i) const { return vec.unchecked(i); }
+};
+
+/**
+ * @brief Leaf owning its Vec, for temporaries that would not outlive the
+ * expression.
+ */
+template <unsigned int N, class T> class VecValue {
+  private:
+    Vec<N, T> vec;
+
+  public:
+    static constexpr bool is_vec_expression = true;
+    static constexpr unsigned int size = N;
+    using value_type = T;
+
+    constexpr explicit VecValue(const Vec<N, T> &vec) : vec(vec) {}
+    constexpr T eval(unsigned int i) const { return vec.unchecked(i); }
+};
+
+template <VecExpression L, VecExpression R, class Op>
+    requires(L::size == R::size)
+class VecBinary {
+  private:
+    L left;
+    R right;
+
+  public:
+    static constexpr bool is_vec_expression = true;
+    static constexpr unsigned int size = L::size;
+    using value_type =
+        std::common_type_t<typename L::value_type, typename R::value_type>;
+
+    constexpr VecBinary(const L &left, const R &right)
+        : left(left), right(right) {}
+    constexpr value_type eval(unsigned int i) const {
+        return Op{}(left.eval(i), right.eval(i));
+    }
+};
+
+/**
+ * @brief Element-wise operation between an expression and a scalar, the
+ * scalar stays on the side it was written on.
+ */
+template <VecExpression E, class Op, bool ScalarLeft> class VecScalar {
+  private:
+    E expr;
+    typename E::value_type scalar;
+
+  public:
+    static constexpr bool is_vec_expression = true;
+    static constexpr unsigned int size = E::size;
+    using value_type = typename E::value_type;
+
+    constexpr VecScalar(const E &expr, const value_type &scalar)
+        : expr(expr), scalar(scalar) {}
+    constexpr value_type eval(unsigned int i) const {
+        if constexpr (ScalarLeft) {
+            return Op{}(scalar, expr.eval(i));
+        } else {
+            return Op{}(expr.eval(i), scalar);
+        }
+    }
+};
+
+template <VecExpression E> class VecNegate {
+  private:
+    E expr;
+
+  public:
+    static constexpr bool is_vec_expression = true;
+    static constexpr unsigned int size = E::size;
+    using value_type = typename E::value_type;
+
+    constexpr explicit VecNegate(const E &expr) : expr(expr) {}
+    constexpr value_type eval(unsigned int i) const { return -expr.eval(i); }
+};
+
+/***************************************
+        Entry Point
+***************************************/
+/**
+ * @brief Start a lazy expression from a Vec.
+ */
+template <unsigned int N, class T>
+constexpr VecLeaf<N, T> lazy(const Vec<N, T> &vec) {
+    return VecLeaf<N, T>(vec);
+}
+// A temporary would be gone before the expression is evaluated.
+template <unsigned int N, class T>
+VecLeaf<N, T> lazy(const Vec<N, T> &&vec) = delete;
+
+/**
+ * @brief Expressions as they are, named Vecs by reference and temporary
+ * Vecs by value.
+ */
+template <class X>
+    requires VecOperand<std::remove_cvref_t<X>>
+constexpr auto as_expression(X &&x) {
+    using Operand = std::remove_cvref_t<X>;
+    if constexpr (VecExpression<Operand>) {
+        return Operand(x);
+    } else if constexpr (std::is_lvalue_reference_v<X>) {
+        return lazy(x);
+    } else {
+        return VecValue(x);
+    }
+}
+template <class X> using expression_t = decltype(as_expression(std::declval<X>()));
+
+template <class L, class R>
+concept MixedOperands = VecOperand<std::remove_cvref_t<L>> &&
+                        VecOperand<std::remove_cvref_t<R>> &&
+                        (VecExpression<std::remove_cvref_t<L>> ||
+                         VecExpression<std::remove_cvref_t<R>>);
+
+/***************************************
+        Operators
+***************************************/
+// At least one side must already be an expression, Vec op Vec keeps using
+// the eager operators of Vec.
+template <class L, class R>
+    requires MixedOperands<L, R>
+constexpr auto operator+(L &&left, R &&right) {
+    return VecBinary<expression_t<L>, expression_t<R>, std::plus<>>(
+        as_expression(std::forward<L>(left)), as_expression(std::forward<R>(right)));
+}
+template <class L, class R>
+    requires MixedOperands<L, R>
+constexpr auto operator-(L &&left, R &&right) {
+    return VecBinary<expression_t<L>, expression_t<R>, std::minus<>>(
+        as_expression(std::forward<L>(left)), as_expression(std::forward<R>(right)));
+}
+template <class L, class R>
+    requires MixedOperands<L, R>
+constexpr auto operator*(L &&left, R &&right) {
+    return VecBinary<expression_t<L>, expression_t<R>, std::multiplies<>>(
+        as_expression(std::forward<L>(left)), as_expression(std::forward<R>(right)));
+}
+template <class L, class R>
+    requires MixedOperands<L, R>
+constexpr auto operator/(L &&left, R &&right) {
+    return VecBinary<expression_t<L>, expression_t<R>, std::divides<>>(
+        as_expression(std::forward<L>(left)), as_expression(std::forward<R>(right)));
+}
+template <VecExpression E, class S>
+    requires std::is_arithmetic_v<S>
+constexpr auto operator*(const E &expr, const S &scalar) {
+    return VecScalar<E, std::multiplies<>, false>(
+        expr, static_cast<typename E::value_type>(scalar));
+}
+template <VecExpression E, class S>
+    requires std::is_arithmetic_v<S>
+constexpr auto operator*(const S &scalar, const E &expr) {
+    return VecScalar<E, std::multiplies<>, true>(
+        expr, static_cast<typename E::value_type>(scalar));
+}
+template <VecExpression E, class S>
+    requires std::is_arithmetic_v<S>
+constexpr auto operator/(const E &expr, const S &scalar) {
+    return VecScalar<E, std::divides<>, false>(
+        expr, static_cast<typename E::value_type>(scalar));
+}
+template <VecExpression E> constexpr auto operator-(const E &expr) {
+    return VecNegate<E>(expr);
+}
+} // namespace smath
+#endif // SMATH_EXPR_HPP
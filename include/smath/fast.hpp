@@ -0,0 +1,276 @@
+#ifndef SMATH_FAST_HPP
+#define SMATH_FAST_HPP
+
+#include "config.hpp"
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+#if defined(SMATH_SSE)
+#include <immintrin.h>
+#endif
+
+namespace smath {
+// Defined in vec.hpp, next to the precise sincos. fast::sincos returns it.
+template <class T> struct SinCos;
+} // namespace smath
+
+namespace smath::fast {
+/*
+    Polynomial approximations for hot loops, cheaper than <cmath> and
+    evaluable on whole SIMD registers (the kernels in simd.hpp share the
+    coefficients below), with quadrants and octants picked by masks rather
+    than branches. The acos_coefficients polynomial is bounded by its
+    absolute error over [0, 1], measured against <cmath> in double. rsqrt,
+    sin, cos, sincos, acos and atan2 are bounded in ulp of the result
+    against the correctly rounded value.
+    fast::normalize / fast::angle / fast::slerp next to Vec and Quat, and
+    the span overloads in vec_array.hpp, are built on them.
+*/
+namespace detail {
+// acos(x) = sqrt(1 - x) * P(x) on [0, 1], Abramowitz & Stegun 4.4.46.
+inline constexpr double acos_coefficients[] = {
+    1.5707963050,  -0.2145988016, 0.0889789874,  -0.0501743046,
+    0.0308918810,  -0.0170881256, 0.0066700901,  -0.0012624911,
+};
+// onlerp_t correction k = A(d) (t - 1/2)^2 + B(d), fitted by Zeux Kapoulkine.
+inline constexpr double onlerp_a_coefficients[] = {1.0904, -3.2452, 3.55645,
+                                                   -1.43519};
+inline constexpr double onlerp_b_coefficients[] = {0.848013, -1.06021,
+                                                   0.215638};
+
+// Chebyshev-node fits, near minimax, lowest power first. sin(x) = x S(x^2)
+// and cos(x) = C(x^2) on |x| <= pi/4.
+inline constexpr double sin_float_coefficients[] = {
+    0.99999999691770356,
+    -0.16666650673996773,
+    0.0083320357855973099,
+    -0.00019503904250840936,
+};
+inline constexpr double cos_float_coefficients[] = {
+    0.99999999995248942,  -0.49999999614857608,    0.041666616692532825,
+    -0.0013886617999647098, 2.4379831251179921e-05,
+};
+inline constexpr double sin_double_coefficients[] = {
+    1.0,
+    -0.16666666666666616,
+    0.0083333333333203141,
+    -0.00019841269828622172,
+    2.75573133682111e-06,
+    -2.5050715823150763e-08,
+    1.5894674777540782e-10,
+};
+inline constexpr double cos_double_coefficients[] = {
+    0.99999999999999995,     -0.49999999999999251,   0.041666666666472342,
+    -0.0013888888869980925,  2.4801578539233975e-05, -2.7555233979941722e-07,
+    2.0630459553442748e-09,
+};
+// atan(t) = t A(t^2) on |t| <= tan(pi/8).
+inline constexpr double atan_float_coefficients[] = {
+    0.99999998126461112,  -0.33332785771924843, 0.19974082415507661,
+    -0.13848490212269176, 0.079762918067945211,
+};
+inline constexpr double atan_double_coefficients[] = {
+    1.0,                   -0.33333333333333249, 0.19999999999898914,
+    -0.14285714266133159,  0.11111109637866319,  -0.090908525849628728,
+    0.076910555106156864,  -0.066496164561343719, 0.057363452408734895,
+    -0.044833689155422333, 0.022750909545582283,
+};
+// asin(s) = s A(s^2) on |s| <= 1/2, for the double acos.
+inline constexpr double asin_double_coefficients[] = {
+    1.0,
+    0.16666666666666652,
+    0.075000000000200656,
+    0.044642857104032749,
+    0.030381947340845882,
+    0.022372048279558604,
+    0.017355250021790291,
+    0.013929751803238613,
+    0.011874844136535861,
+    0.0078057517233357772,
+    0.016027901549486745,
+    -0.010737225849170308,
+    0.028161213490451944,
+};
+inline constexpr double tan_eighth_pi = 0.41421356237309504880;
+// pi/2 = sum of the parts (Cody & Waite), all but the last have short
+// mantissas so q * part is exact for |q| < 2^16.
+inline constexpr double half_pi_float_parts[] = {
+    1.5703125, 4.8351287841796875e-4, 3.1385570764541625977e-07,
+    6.077100628276710381e-11};
+inline constexpr double half_pi_double_parts[] = {
+    1.57079625129699707031, 7.54978941586159635335e-8, 5.39030285815811905290e-15};
+
+/**
+ * @brief Coefficients for the precision of T, the float set for float and
+ * the double set otherwise.
+ */
+template <class T> struct Tables {
+    static constexpr const auto &sin = sin_double_coefficients;
+    static constexpr const auto &cos = cos_double_coefficients;
+    static constexpr const auto &atan = atan_double_coefficients;
+    static constexpr const auto &half_pi = half_pi_double_parts;
+};
+template <> struct Tables<float> {
+    static constexpr const auto &sin = sin_float_coefficients;
+    static constexpr const auto &cos = cos_float_coefficients;
+    static constexpr const auto &atan = atan_float_coefficients;
+    static constexpr const auto &half_pi = half_pi_float_parts;
+};
+
+template <class T, unsigned int K, std::size_t... I>
+constexpr T horner(const T &x, const double (&coefficients)[K], std::index_sequence<I...>) {
+    T result = static_cast<T>(coefficients[K - 1]);
+    ((result = result * x + static_cast<T>(coefficients[K - 2 - I])), ...);
+    return result;
+}
+/**
+ * @brief Polynomial with the given coefficients (lowest first), unrolled.
+ */
+template <class T, unsigned int K>
+constexpr T horner(const T &x, const double (&coefficients)[K]) {
+    return horner(x, coefficients, std::make_index_sequence<K - 1>());
+}
+/**
+ * @brief condition ? a : b without a jump. Compilers turn data dependent
+ * ternaries into branches, which mispredict on random input.
+ */
+template <class T> constexpr T select(bool condition, const T &a, const T &b) {
+    if constexpr (sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t)) {
+        using Bits = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t,
+                                        std::uint64_t>;
+        const Bits mask = Bits(0) - static_cast<Bits>(condition);
+        return std::bit_cast<T>(static_cast<Bits>((std::bit_cast<Bits>(a) & mask) |
+                                                  (std::bit_cast<Bits>(b) & ~mask)));
+    } else {
+        return condition ? a : b;
+    }
+}
+/**
+ * @return x - q pi/2 in [-pi/4, pi/4], q the nearest integer to x 2/pi.
+ */
+template <std::floating_point T> constexpr T reduce_half_pi(const T &x, long long &q) {
+    const T quarters = x * static_cast<T>(2 / std::numbers::pi);
+    q = static_cast<long long>(quarters + (quarters < 0 ? T(-0.5) : T(0.5)));
+    const T k = static_cast<T>(q);
+    T r = x;
+    for (const double part : Tables<T>::half_pi) {
+        r -= k * static_cast<T>(part);
+    }
+    return r;
+}
+} // namespace detail
+
+/**
+ * @brief sin(x) and cos(x) from one reduction by the nearest multiple of
+ * pi/2 onto [-pi/4, pi/4]. Within 3 ulp up to |x| = 8192 for float and
+ * |x| = 1e5 for double, larger arguments lose bits in the reduction.
+ */
+template <std::floating_point T> constexpr SinCos<T> sincos(const T &x) {
+    long long q = 0;
+    const T r = detail::reduce_half_pi(x, q);
+    const T z = r * r;
+    const T s = r * detail::horner(z, detail::Tables<T>::sin);
+    const T c = detail::horner(z, detail::Tables<T>::cos);
+    const bool odd = (q & 1) != 0;
+    const T sin = detail::select(odd, c, s);
+    const T cos = detail::select(odd, s, c);
+    return {detail::select((q & 2) != 0, -sin, sin),
+            detail::select(((q + 1) & 2) != 0, -cos, cos)};
+}
+/**
+ * @brief sin(x), same reduction and bounds as sincos.
+ */
+template <std::floating_point T> constexpr T sin(const T &x) { return sincos(x).sin; }
+/**
+ * @brief cos(x), same reduction and bounds as sincos.
+ */
+template <std::floating_point T> constexpr T cos(const T &x) { return sincos(x).cos; }
+/**
+ * @brief atan2(y, x) in [-pi, pi], within 3 ulp for float and 4 ulp for
+ * double. Signed zeros are not told apart: atan2(0, x) is 0 for x >= 0 and
+ * pi for x < 0, atan2(0, 0) is 0. Infinite and NaN inputs are not supported.
+ */
+template <std::floating_point T> constexpr T atan2(const T &y, const T &x) {
+    const T ax = x < 0 ? -x : x;
+    const T ay = y < 0 ? -y : y;
+    const T low = ay < ax ? ay : ax;
+    const T high = ay < ax ? ax : ay;
+    // One division either way: past tan(pi/8) atan(l/h) = pi/4 + atan((l-h)/(l+h)).
+    const bool octant = low > static_cast<T>(detail::tan_eighth_pi) * high;
+    const T numerator = detail::select(octant, low - high, low);
+    const T denominator =
+        detail::select(octant, low + high, detail::select(high == 0, T(1), high));
+    const T t = numerator / denominator;
+    T angle = t * detail::horner(t * t, detail::Tables<T>::atan);
+    angle += detail::select(octant, std::numbers::pi_v<T> / 4, T(0));
+    angle = detail::select(ay > ax, std::numbers::pi_v<T> / 2 - angle, angle);
+    angle = detail::select(x < 0, std::numbers::pi_v<T> - angle, angle);
+    return detail::select(y < 0, -angle, angle);
+}
+/**
+ * @brief atan(x), atan2(x, 1).
+ */
+template <std::floating_point T> constexpr T atan(const T &x) {
+    return fast::atan2(x, static_cast<T>(1));
+}
+/**
+ * @brief acos(x) for x in [-1, 1]. Float evaluates sqrt(1 - |x|) P(|x|)
+ * (Abramowitz & Stegun 4.4.46, absolute error < 2.2e-8), within 3 ulp. That
+ * polynomial stops at float precision, double takes pi/2 - asin(|x|) below
+ * 1/2 and 2 asin(sqrt((1 - |x|) / 2)) above, within 3 ulp.
+ */
+template <std::floating_point T> constexpr T acos(const T &x) {
+    const T a = x < 0 ? -x : x;
+    T result = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        result = std::sqrt(1 - a) * detail::horner(a, detail::acos_coefficients);
+    } else {
+        const bool far = a > T(0.5);
+        // A branch: evaluating the square root for every input costs more than a miss.
+        const T s = far ? std::sqrt((1 - a) * T(0.5)) : a;
+        const T asin = s * detail::horner(s * s, detail::asin_double_coefficients);
+        result = detail::select(far, 2 * asin, std::numbers::pi_v<T> / 2 - asin);
+    }
+    return detail::select(x < 0, std::numbers::pi_v<T> - result, result);
+}
+/**
+ * @brief 1 / sqrt(x) for positive normal x. The float one is the rsqrtss
+ * estimate refined by one Newton step, within 5 ulp. For double no estimate
+ * refined to double precision beats the divide, so it is 1 / std::sqrt.
+ * Without SSE, and in constant evaluation, float is also 1 / std::sqrt.
+ */
+template <std::floating_point T> constexpr T rsqrt(const T &x) {
+#if defined(SMATH_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        if !consteval {
+            const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+            return y * (1.5f - 0.5f * x * y * y);
+        }
+    }
+#endif
+    return 1 / std::sqrt(x);
+}
+/**
+ * @brief Above this |a.dot(b)| slerp falls back to nlerp, sin(angle) is too
+ * small to divide by and the two paths agree to float precision.
+ */
+inline constexpr double slerp_threshold = 0.9995;
+/**
+ * @brief Corrected interpolation parameter for onlerp: nlerp with this t
+ * follows slerp within 1.5e-3 radians (see the blend tests). cos_angle
+ * is |a.dot(b)| of the two unit quaternions.
+ */
+template <std::floating_point T>
+constexpr T onlerp_t(const T &cos_angle, const T &t) {
+    const T h = t - static_cast<T>(0.5);
+    const T k = detail::horner(cos_angle, detail::onlerp_a_coefficients) * h * h +
+                detail::horner(cos_angle, detail::onlerp_b_coefficients);
+    return t + t * h * (t - 1) * k;
+}
+} // namespace smath::fast
+#endif // SMATH_FAST_HPP
@@ -0,0 +1,330 @@
+#ifndef SMATH_FRUSTUM_HPP
+#define SMATH_FRUSTUM_HPP
+
+#include "execution.hpp"
+#include "mat.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include "vec_array.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    View frustum as six planes (a, b, c, d) with unit normals pointing
+    inward, so a x + b y + c z + d is the signed distance of a point to the
+    plane, positive inside.
+
+    The planes are extracted from a (view) projection matrix following
+    Gribb & Hartmann: with r0..r3 the rows of M and OpenGL clip space
+    (-w <= x, y, z <= w, what perspective() and orthgraphic() produce)
+    left = r3 + r0, right = r3 - r0, bottom = r3 + r1, top = r3 - r1,
+    near = r3 + r2, far = r3 - r2.
+
+    The batched classification stages spheres and boxes into SoA chunks and
+    tests one register of objects (eight floats on AVX) against all six
+    planes at once.
+*/
+enum class Containment : std::uint8_t { outside = 0, intersecting = 1, inside = 2 };
+inline std::ostream &operator<<(std::ostream &o, Containment c) {
+    o << (c == Containment::outside   ? "outside"
+          : c == Containment::inside ? "inside"
+                                     : "intersecting");
+    return o;
+}
+
+template <class T>
+    requires(std::is_floating_point_v<T>)
+class Frustum {
+  private:
+    std::array<Vec<4, T>, 6> plane_array{};
+
+  public:
+    static constexpr unsigned int left = 0;
+    static constexpr unsigned int right = 1;
+    static constexpr unsigned int bottom = 2;
+    static constexpr unsigned int top = 3;
+    static constexpr unsigned int near_plane = 4;
+    static constexpr unsigned int far_plane = 5;
+
+    /***************************************
+            Constructors
+    ****************************************/
+    constexpr Frustum() = default;
+    /**
+     * @brief Six planes in the order left, right, bottom, top, near, far,
+     * each normalized here.
+     */
+    constexpr explicit Frustum(const std::array<Vec<4, T>, 6> &planes) {
+        for (unsigned int p = 0; p < 6; p++) {
+            const Vec<4, T> &plane = planes[p];
+            const T length = std::sqrt(plane.unchecked(0) * plane.unchecked(0) +
+                                       plane.unchecked(1) * plane.unchecked(1) +
+                                       plane.unchecked(2) * plane.unchecked(2));
+            if (length == 0) {
+                throw std::invalid_argument("Frustum plane normal is zero.");
+            }
+            plane_array[p] = plane / length;
+        }
+    }
+    /**
+     * @brief Planes of projection * view, in the space the view matrix
+     * maps from (world space for perspective(...).cross(look_at(...))).
+     */
+    static constexpr Frustum from_mat4(const Mat<4, 4, T> &matrix) {
+        const auto row = [&](unsigned int r) {
+            return Vec<4, T>(matrix.unchecked(r), matrix.unchecked(4 + r),
+                             matrix.unchecked(8 + r), matrix.unchecked(12 + r));
+        };
+        const Vec<4, T> w = row(3);
+        return Frustum({w + row(0), w - row(0), w + row(1), w - row(1),
+                        w + row(2), w - row(2)});
+    }
+
+    /***************************************
+            Getters
+    ****************************************/
+    constexpr const std::array<Vec<4, T>, 6> &planes() const { return plane_array; }
+    constexpr const Vec<4, T> &plane(unsigned int index) const {
+#if SMATH_CHECKED
+        if (index >= 6) {
+            throw std::out_of_range("Plane index out of bound");
+        }
+#endif
+        return plane_array[index];
+    }
+
+    /***************************************
+            Methods
+    ****************************************/
+    /**
+     * @return Signed distance of point to the plane, positive inside.
+     */
+    constexpr T distance(unsigned int index, const Vec<3, T> &point) const {
+        const Vec<4, T> &p = plane(index);
+        return p.unchecked(0) * point.unchecked(0) + p.unchecked(1) * point.unchecked(1) +
+               p.unchecked(2) * point.unchecked(2) + p.unchecked(3);
+    }
+    constexpr bool contains(const Vec<3, T> &point) const {
+        for (unsigned int p = 0; p < 6; p++) {
+            if (distance(p, point) < 0)
+                return false;
+        }
+        return true;
+    }
+    constexpr Containment classify_sphere(const Vec<3, T> &center, const T &radius) const {
+        bool inside = true;
+        for (unsigned int p = 0; p < 6; p++) {
+            const T d = distance(p, center);
+            if (d < -radius)
+                return Containment::outside;
+            inside = inside && d > radius;
+        }
+        return inside ? Containment::inside : Containment::intersecting;
+    }
+    /**
+     * @brief Box given by its min and max corners. Like every plane based
+     * test, a box near a frustum corner may be reported intersecting while
+     * being outside.
+     */
+    constexpr Containment classify_aabb(const Vec<3, T> &min, const Vec<3, T> &max) const {
+        bool inside = true;
+        for (unsigned int p = 0; p < 6; p++) {
+            const Vec<4, T> &plane = plane_array[p];
+            T d = plane.unchecked(3);
+            T r = 0;
+            for (unsigned int c = 0; c < 3; c++) {
+                const T n = plane.unchecked(c);
+                d += n * (min.unchecked(c) + max.unchecked(c)) * static_cast<T>(0.5);
+                r += (n < 0 ? -n : n) * (max.unchecked(c) - min.unchecked(c)) *
+                     static_cast<T>(0.5);
+            }
+            if (d < -r)
+                return Containment::outside;
+            inside = inside && d > r;
+        }
+        return inside ? Containment::inside : Containment::intersecting;
+    }
+};
+using Frustumf = Frustum<float>;
+using Frustumd = Frustum<double>;
+
+namespace detail {
+constexpr std::size_t cull_chunk = 64;
+
+template <class T> constexpr std::size_t cull_grain() {
+    // Six scalars of box read and one byte written per object.
+    const std::size_t grain = execution::grain(6 * sizeof(T) + 1);
+    return std::max(cull_chunk, grain - grain % cull_chunk);
+}
+template <class T> const T *packed_planes(const Frustum<T> &frustum) {
+    static_assert(sizeof(Vec<4, T>) == 4 * sizeof(T));
+    static_assert(static_cast<std::uint8_t>(Containment::intersecting) == 1);
+    return reinterpret_cast<const T *>(frustum.planes().data());
+}
+inline std::uint8_t *packed_codes(std::span<Containment> out) {
+    static_assert(sizeof(Containment) == 1);
+    return reinterpret_cast<std::uint8_t *>(out.data());
+}
+
+template <class Policy, class T>
+void classify_sphere_span(Policy &&policy, const Frustum<T> &frustum,
+                          std::span<const Vec<3, T>> centers,
+                          std::span<const T> radii, std::span<Containment> out) {
+    if (radii.size() != centers.size()) {
+        throw std::invalid_argument("Radius span size mismatched.");
+    }
+    if (out.size() != centers.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    static_assert(sizeof(Vec<3, T>) == 3 * sizeof(T));
+    const T *planes = packed_planes(frustum);
+    const T *packed_centers = reinterpret_cast<const T *>(centers.data());
+    std::uint8_t *codes = packed_codes(out);
+    execution::for_each_range(
+        policy, centers.size(), cull_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            alignas(64) T x[cull_chunk];
+            alignas(64) T y[cull_chunk];
+            alignas(64) T z[cull_chunk];
+            for (std::size_t base = begin; base < end; base += cull_chunk) {
+                const std::size_t count = std::min(cull_chunk, end - base);
+                simd::deinterleave3(packed_centers + 3 * base, x, y, z, count);
+                simd::classify_spheres(planes, x, y, z, radii.data() + base,
+                                       codes + base, count);
+            }
+        });
+}
+template <class Policy, class T>
+void classify_box_span(Policy &&policy, const Frustum<T> &frustum,
+                       std::span<const Vec<3, T>> min, std::span<const Vec<3, T>> max,
+                       std::span<Containment> out) {
+    if (max.size() != min.size()) {
+        throw std::invalid_argument("AABB span size mismatched.");
+    }
+    if (out.size() != min.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    static_assert(sizeof(Vec<3, T>) == 3 * sizeof(T));
+    const T *planes = packed_planes(frustum);
+    const T *packed_min = reinterpret_cast<const T *>(min.data());
+    const T *packed_max = reinterpret_cast<const T *>(max.data());
+    std::uint8_t *codes = packed_codes(out);
+    execution::for_each_range(
+        policy, min.size(), cull_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            alignas(64) T lo[3][cull_chunk];
+            alignas(64) T hi[3][cull_chunk];
+            const T *const lo_soa[3] = {lo[0], lo[1], lo[2]};
+            const T *const hi_soa[3] = {hi[0], hi[1], hi[2]};
+            for (std::size_t base = begin; base < end; base += cull_chunk) {
+                const std::size_t count = std::min(cull_chunk, end - base);
+                simd::deinterleave3(packed_min + 3 * base, lo[0], lo[1], lo[2], count);
+                simd::deinterleave3(packed_max + 3 * base, hi[0], hi[1], hi[2], count);
+                simd::classify_boxes(planes, lo_soa, hi_soa, codes + base, count);
+            }
+        });
+}
+} // namespace detail
+
+/**
+ * @brief out[i] = frustum.classify_sphere(centers[i], radii[i]).
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void classify_spheres(Policy &&policy, const Frustum<T> &frustum,
+                      std::type_identity_t<std::span<const Vec<3, T>>> centers,
+                      std::type_identity_t<std::span<const T>> radii,
+                      std::span<Containment> out) {
+    detail::classify_sphere_span(policy, frustum, centers, radii, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void classify_spheres(Policy &&policy, const Frustum<T> &frustum,
+                      const VecArray<3, T> &centers,
+                      std::type_identity_t<std::span<const T>> radii,
+                      std::span<Containment> out) {
+    if (radii.size() != centers.size()) {
+        throw std::invalid_argument("Radius span size mismatched.");
+    }
+    if (out.size() != centers.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    const T *planes = detail::packed_planes(frustum);
+    std::uint8_t *codes = detail::packed_codes(out);
+    execution::for_each_range(
+        policy, centers.size(), detail::cull_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            simd::classify_spheres(planes, centers.component(0).data() + begin,
+                                   centers.component(1).data() + begin,
+                                   centers.component(2).data() + begin,
+                                   radii.data() + begin, codes + begin, end - begin);
+        });
+}
+template <class T>
+void classify_spheres(const Frustum<T> &frustum,
+                      std::type_identity_t<std::span<const Vec<3, T>>> centers,
+                      std::type_identity_t<std::span<const T>> radii,
+                      std::span<Containment> out) {
+    classify_spheres(execution::seq, frustum, centers, radii, out);
+}
+template <class T>
+void classify_spheres(const Frustum<T> &frustum, const VecArray<3, T> &centers,
+                      std::type_identity_t<std::span<const T>> radii,
+                      std::span<Containment> out) {
+    classify_spheres(execution::seq, frustum, centers, radii, out);
+}
+
+/**
+ * @brief out[i] = frustum.classify_aabb(min[i], max[i]).
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void classify_aabbs(Policy &&policy, const Frustum<T> &frustum,
+                    std::type_identity_t<std::span<const Vec<3, T>>> min,
+                    std::type_identity_t<std::span<const Vec<3, T>>> max,
+                    std::span<Containment> out) {
+    detail::classify_box_span(policy, frustum, min, max, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void classify_aabbs(Policy &&policy, const Frustum<T> &frustum,
+                    const VecArray<3, T> &min, const VecArray<3, T> &max,
+                    std::span<Containment> out) {
+    if (max.size() != min.size()) {
+        throw std::invalid_argument("AABB span size mismatched.");
+    }
+    if (out.size() != min.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    const T *planes = detail::packed_planes(frustum);
+    std::uint8_t *codes = detail::packed_codes(out);
+    execution::for_each_range(
+        policy, min.size(), detail::cull_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            const T *const lo[3] = {min.component(0).data() + begin,
+                                    min.component(1).data() + begin,
+                                    min.component(2).data() + begin};
+            const T *const hi[3] = {max.component(0).data() + begin,
+                                    max.component(1).data() + begin,
+                                    max.component(2).data() + begin};
+            simd::classify_boxes(planes, lo, hi, codes + begin, end - begin);
+        });
+}
+template <class T>
+void classify_aabbs(const Frustum<T> &frustum,
+                    std::type_identity_t<std::span<const Vec<3, T>>> min,
+                    std::type_identity_t<std::span<const Vec<3, T>>> max,
+                    std::span<Containment> out) {
+    classify_aabbs(execution::seq, frustum, min, max, out);
+}
+template <class T>
+void classify_aabbs(const Frustum<T> &frustum, const VecArray<3, T> &min,
+                    const VecArray<3, T> &max, std::span<Containment> out) {
+    classify_aabbs(execution::seq, frustum, min, max, out);
+}
+} // namespace smath
+#endif // SMATH_FRUSTUM_HPP
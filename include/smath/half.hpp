@@ -0,0 +1,370 @@
+#ifndef SMATH_HALF_HPP
+#define SMATH_HALF_HPP
+
+#include "config.hpp"
+#include "execution.hpp"
+#include "mat.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include "vec_array.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    Storage-only 16-bit floats for bandwidth bound vertex and animation
+    buffers:
+    Half     IEEE binary16 (1-5-10), |x| <= 65504, about 3 decimal digits
+    BFloat16 upper half of a float (1-8-7), float's range, about 2 digits
+    They do no arithmetic of their own: values are widened to float, which
+    is exact, computed on as Vec/Mat<float>, and rounded to nearest even
+    when stored back. PackedVec and PackedMat are the 16-bit counterparts of
+    Vec and Mat; pack / unpack convert whole buffers with F16C (AVX-512 when
+    available) instructions for Half and AVX2 integer rounding for BFloat16.
+*/
+class Half {
+  private:
+    std::uint16_t value = 0;
+
+  public:
+    constexpr Half() = default;
+    explicit constexpr Half(float f) : value(simd::half_from_float(f)) {}
+    static constexpr Half from_bits(std::uint16_t bits) {
+        Half half;
+        half.value = bits;
+        return half;
+    }
+    constexpr std::uint16_t bits() const { return value; }
+    constexpr operator float() const { return simd::half_to_float(value); }
+    friend std::ostream &operator<<(std::ostream &o, const Half &h) {
+        return o << static_cast<float>(h);
+    }
+};
+class BFloat16 {
+  private:
+    std::uint16_t value = 0;
+
+  public:
+    constexpr BFloat16() = default;
+    explicit constexpr BFloat16(float f) : value(simd::bfloat16_from_float(f)) {}
+    static constexpr BFloat16 from_bits(std::uint16_t bits) {
+        BFloat16 bfloat;
+        bfloat.value = bits;
+        return bfloat;
+    }
+    constexpr std::uint16_t bits() const { return value; }
+    constexpr operator float() const { return simd::bfloat16_to_float(value); }
+    friend std::ostream &operator<<(std::ostream &o, const BFloat16 &b) {
+        return o << static_cast<float>(b);
+    }
+};
+template <class H>
+concept Float16 = std::same_as<H, Half> || std::same_as<H, BFloat16>;
+
+/**
+ * @brief N 16-bit components of a Vec<N, float>, tightly packed.
+ */
+template <unsigned int N, Float16 H>
+    requires(N <= 32)
+class PackedVec {
+  private:
+    std::array<H, N> data{};
+
+  public:
+    constexpr PackedVec() = default;
+    explicit constexpr PackedVec(const Vec<N, float> &vec) {
+        for (unsigned int i = 0; i < N; i++) {
+            data[i] = H(vec.unchecked(i));
+        }
+    }
+    constexpr Vec<N, float> unpack() const {
+        Vec<N, float> result;
+        for (unsigned int i = 0; i < N; i++) {
+            result.unchecked(i) = data[i];
+        }
+        return result;
+    }
+    constexpr H &operator[](unsigned int index) {
+#if SMATH_CHECKED
+        if (index >= N)
+            throw std::out_of_range("Index out of bound");
+#endif
+        return data[index];
+    }
+    constexpr const H &operator[](unsigned int index) const {
+#if SMATH_CHECKED
+        if (index >= N)
+            throw std::out_of_range("Index out of bound");
+#endif
+        return data[index];
+    }
+    friend std::ostream &operator<<(std::ostream &o, const PackedVec &v) {
+        return o << "Packed" << v.unpack();
+    }
+};
+/**
+ * @brief M x N 16-bit components of a Mat<M, N, float>, same column-major
+ * order.
+ */
+template <unsigned int M, unsigned int N, Float16 H>
+    requires(M <= 32 && N <= 32)
+class PackedMat {
+  private:
+    std::array<H, M * N> data{};
+
+  public:
+    constexpr PackedMat() = default;
+    explicit constexpr PackedMat(const Mat<M, N, float> &mat) {
+        for (unsigned int i = 0; i < M * N; i++) {
+            data[i] = H(mat.unchecked(i));
+        }
+    }
+    constexpr Mat<M, N, float> unpack() const {
+        Mat<M, N, float> result;
+        for (unsigned int i = 0; i < M * N; i++) {
+            result.unchecked(i) = data[i];
+        }
+        return result;
+    }
+    constexpr H &operator[](unsigned int index) {
+#if SMATH_CHECKED
+        if (index >= M * N)
+            throw std::out_of_range("Index out of bound");
+#endif
+        return data[index];
+    }
+    constexpr const H &operator[](unsigned int index) const {
+#if SMATH_CHECKED
+        if (index >= M * N)
+            throw std::out_of_range("Index out of bound");
+#endif
+        return data[index];
+    }
+    friend std::ostream &operator<<(std::ostream &o, const PackedMat &m) {
+        return o << "Packed" << m.unpack();
+    }
+};
+using PackedVec2h = PackedVec<2, Half>;
+using PackedVec3h = PackedVec<3, Half>;
+using PackedVec4h = PackedVec<4, Half>;
+using PackedVec2bf = PackedVec<2, BFloat16>;
+using PackedVec3bf = PackedVec<3, BFloat16>;
+using PackedVec4bf = PackedVec<4, BFloat16>;
+using PackedMat3h = PackedMat<3, 3, Half>;
+using PackedMat4h = PackedMat<4, 4, Half>;
+using PackedMat3bf = PackedMat<3, 3, BFloat16>;
+using PackedMat4bf = PackedMat<4, 4, BFloat16>;
+
+namespace detail {
+constexpr std::size_t pack_chunk = 64;
+
+template <Float16 H> void pack_range(const float *in, H *out, std::size_t n) {
+    static_assert(sizeof(H) == sizeof(std::uint16_t));
+    std::uint16_t *bits = reinterpret_cast<std::uint16_t *>(out);
+    if constexpr (std::is_same_v<H, Half>) {
+        simd::float_to_half(in, bits, n);
+    } else {
+        simd::float_to_bfloat16(in, bits, n);
+    }
+}
+template <Float16 H> void unpack_range(const H *in, float *out, std::size_t n) {
+    const std::uint16_t *bits = reinterpret_cast<const std::uint16_t *>(in);
+    if constexpr (std::is_same_v<H, Half>) {
+        simd::half_to_float(bits, out, n);
+    } else {
+        simd::bfloat16_to_float(bits, out, n);
+    }
+}
+template <Float16 H, execution::ExecutionPolicy Policy>
+void pack_floats(Policy &&policy, const float *in, H *out, std::size_t n) {
+    execution::for_each_range(
+        policy, n, execution::grain(sizeof(float) + sizeof(H)),
+        [&](std::size_t begin, std::size_t end) {
+            pack_range(in + begin, out + begin, end - begin);
+        });
+}
+template <Float16 H, execution::ExecutionPolicy Policy>
+void unpack_floats(Policy &&policy, const H *in, float *out, std::size_t n) {
+    execution::for_each_range(
+        policy, n, execution::grain(sizeof(float) + sizeof(H)),
+        [&](std::size_t begin, std::size_t end) {
+            unpack_range(in + begin, out + begin, end - begin);
+        });
+}
+inline void check_pack(std::size_t in, std::size_t out) {
+    if (in != out) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+}
+} // namespace detail
+
+/***************************************
+        Bulk conversion
+***************************************/
+/**
+ * @brief out[i] = in[i] rounded to the 16-bit type.
+ */
+template <execution::ExecutionPolicy Policy, Float16 H>
+void pack(Policy &&policy, std::span<const float> in, std::span<H> out) {
+    detail::check_pack(in.size(), out.size());
+    detail::pack_floats(policy, in.data(), out.data(), in.size());
+}
+template <Float16 H> void pack(std::span<const float> in, std::span<H> out) {
+    pack(execution::seq, in, out);
+}
+/**
+ * @brief out[i] = in[i] widened to float, exact.
+ */
+template <execution::ExecutionPolicy Policy, Float16 H>
+void unpack(Policy &&policy, std::span<const H> in, std::span<float> out) {
+    detail::check_pack(in.size(), out.size());
+    detail::unpack_floats(policy, in.data(), out.data(), in.size());
+}
+template <Float16 H> void unpack(std::span<const H> in, std::span<float> out) {
+    unpack(execution::seq, in, out);
+}
+
+template <execution::ExecutionPolicy Policy, unsigned int N, Float16 H>
+void pack(Policy &&policy, std::type_identity_t<std::span<const Vec<N, float>>> in,
+          std::span<PackedVec<N, H>> out) {
+    detail::check_pack(in.size(), out.size());
+    static_assert(sizeof(Vec<N, float>) == N * sizeof(float));
+    static_assert(sizeof(PackedVec<N, H>) == N * sizeof(H));
+    detail::pack_floats(policy, reinterpret_cast<const float *>(in.data()),
+                        reinterpret_cast<H *>(out.data()), N * in.size());
+}
+template <unsigned int N, Float16 H>
+void pack(std::type_identity_t<std::span<const Vec<N, float>>> in,
+          std::span<PackedVec<N, H>> out) {
+    pack(execution::seq, in, out);
+}
+template <execution::ExecutionPolicy Policy, unsigned int N, Float16 H>
+void unpack(Policy &&policy, std::span<const PackedVec<N, H>> in,
+            std::type_identity_t<std::span<Vec<N, float>>> out) {
+    detail::check_pack(in.size(), out.size());
+    detail::unpack_floats(policy, reinterpret_cast<const H *>(in.data()),
+                          reinterpret_cast<float *>(out.data()), N * in.size());
+}
+template <unsigned int N, Float16 H>
+void unpack(std::span<const PackedVec<N, H>> in,
+            std::type_identity_t<std::span<Vec<N, float>>> out) {
+    unpack(execution::seq, in, out);
+}
+
+template <execution::ExecutionPolicy Policy, unsigned int M, unsigned int N, Float16 H>
+void pack(Policy &&policy, std::type_identity_t<std::span<const Mat<M, N, float>>> in,
+          std::span<PackedMat<M, N, H>> out) {
+    detail::check_pack(in.size(), out.size());
+    static_assert(sizeof(Mat<M, N, float>) == M * N * sizeof(float));
+    static_assert(sizeof(PackedMat<M, N, H>) == M * N * sizeof(H));
+    detail::pack_floats(policy, reinterpret_cast<const float *>(in.data()),
+                        reinterpret_cast<H *>(out.data()), M * N * in.size());
+}
+template <unsigned int M, unsigned int N, Float16 H>
+void pack(std::type_identity_t<std::span<const Mat<M, N, float>>> in,
+          std::span<PackedMat<M, N, H>> out) {
+    pack(execution::seq, in, out);
+}
+template <execution::ExecutionPolicy Policy, unsigned int M, unsigned int N, Float16 H>
+void unpack(Policy &&policy, std::span<const PackedMat<M, N, H>> in,
+            std::type_identity_t<std::span<Mat<M, N, float>>> out) {
+    detail::check_pack(in.size(), out.size());
+    detail::unpack_floats(policy, reinterpret_cast<const H *>(in.data()),
+                          reinterpret_cast<float *>(out.data()), M * N * in.size());
+}
+template <unsigned int M, unsigned int N, Float16 H>
+void unpack(std::span<const PackedMat<M, N, H>> in,
+            std::type_identity_t<std::span<Mat<M, N, float>>> out) {
+    unpack(execution::seq, in, out);
+}
+
+/**
+ * @brief Interleave a VecArray into packed AoS elements, staged through
+ * float chunks on the stack.
+ */
+template <execution::ExecutionPolicy Policy, unsigned int N, Float16 H>
+void pack(Policy &&policy, const VecArray<N, float> &in,
+          std::span<PackedVec<N, H>> out) {
+    detail::check_pack(in.size(), out.size());
+    H *packed = reinterpret_cast<H *>(out.data());
+    execution::for_each_range(
+        policy, in.size(),
+        std::max(detail::pack_chunk, execution::grain(N * (sizeof(float) + sizeof(H)))),
+        [&](std::size_t begin, std::size_t end) {
+            alignas(64) float staged[N * detail::pack_chunk];
+            for (std::size_t base = begin; base < end; base += detail::pack_chunk) {
+                const std::size_t count = std::min(detail::pack_chunk, end - base);
+                if constexpr (N == 3) {
+                    simd::interleave3(in.component(0).data() + base,
+                                      in.component(1).data() + base,
+                                      in.component(2).data() + base, staged, count);
+                } else if constexpr (N == 4) {
+                    simd::interleave4(in.component(0).data() + base,
+                                      in.component(1).data() + base,
+                                      in.component(2).data() + base,
+                                      in.component(3).data() + base, staged, count);
+                } else {
+                    for (unsigned int c = 0; c < N; c++) {
+                        const float *component = in.component(c).data() + base;
+                        for (std::size_t i = 0; i < count; i++) {
+                            staged[N * i + c] = component[i];
+                        }
+                    }
+                }
+                detail::pack_range(staged, packed + N * base, N * count);
+            }
+        });
+}
+template <unsigned int N, Float16 H>
+void pack(const VecArray<N, float> &in, std::span<PackedVec<N, H>> out) {
+    pack(execution::seq, in, out);
+}
+/**
+ * @brief Widen packed AoS elements into a VecArray, resized to fit.
+ */
+template <execution::ExecutionPolicy Policy, unsigned int N, Float16 H>
+void unpack(Policy &&policy, std::span<const PackedVec<N, H>> in,
+            VecArray<N, float> &out) {
+    out.resize(in.size());
+    const H *packed = reinterpret_cast<const H *>(in.data());
+    execution::for_each_range(
+        policy, in.size(),
+        std::max(detail::pack_chunk, execution::grain(N * (sizeof(float) + sizeof(H)))),
+        [&](std::size_t begin, std::size_t end) {
+            alignas(64) float staged[N * detail::pack_chunk];
+            for (std::size_t base = begin; base < end; base += detail::pack_chunk) {
+                const std::size_t count = std::min(detail::pack_chunk, end - base);
+                detail::unpack_range(packed + N * base, staged, N * count);
+                if constexpr (N == 3) {
+                    simd::deinterleave3(staged, out.component(0).data() + base,
+                                        out.component(1).data() + base,
+                                        out.component(2).data() + base, count);
+                } else if constexpr (N == 4) {
+                    simd::deinterleave4(staged, out.component(0).data() + base,
+                                        out.component(1).data() + base,
+                                        out.component(2).data() + base,
+                                        out.component(3).data() + base, count);
+                } else {
+                    for (unsigned int c = 0; c < N; c++) {
+                        float *component = out.component(c).data() + base;
+                        for (std::size_t i = 0; i < count; i++) {
+                            component[i] = staged[N * i + c];
+                        }
+                    }
+                }
+            }
+        });
+}
+template <unsigned int N, Float16 H>
+void unpack(std::span<const PackedVec<N, H>> in, VecArray<N, float> &out) {
+    unpack(execution::seq, in, out);
+}
+} // namespace smath
+#endif // SMATH_HALF_HPP
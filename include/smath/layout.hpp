@@ -0,0 +1,151 @@
+#ifndef SMATH_LAYOUT_HPP
+#define SMATH_LAYOUT_HPP
+
+#include "config.hpp"
+#include "mat.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    Opt-in layouts for buffers fed to aligned SIMD loads or copied straight
+    into graphics buffers. Vec and Mat keep the natural alignment of T, so
+    existing arrays and file formats stay tightly packed.
+
+    AlignedVec / AlignedMat are Vec / Mat with a stronger alignas, by
+    default the smallest power of two holding the value, at most a cache
+    line: an element then never straddles two cache lines (AlignedVec3f
+    takes 16 bytes, AlignedMat4f exactly one 64 byte line). They convert
+    implicitly from Vec / Mat and are used as one wherever a Vec / Mat is
+    expected.
+
+    PaddedVec3 holds a Vec3 in four lanes with the fourth always zero, the
+    layout of a GLSL std140 vec3, so the fourth lane can be loaded and
+    computed on without masking.
+
+    All of them, like Vec, Mat and Quat themselves, are standard layout and
+    trivially copyable (see BufferLayout), so arrays of them can be
+    memcpy'd to the GPU as they are.
+*/
+template <class V>
+concept BufferLayout = std::is_standard_layout_v<V> && std::is_trivially_copyable_v<V>;
+
+namespace detail {
+constexpr std::size_t layout_alignment(std::size_t bytes) {
+    return std::min<std::size_t>(64, std::bit_ceil(bytes));
+}
+} // namespace detail
+
+template <unsigned int N, class T,
+          std::size_t Align = detail::layout_alignment(N * sizeof(T))>
+    requires(std::has_single_bit(Align) && Align >= alignof(Vec<N, T>))
+class alignas(Align) AlignedVec : public Vec<N, T> {
+  public:
+    using Vec<N, T>::Vec;
+    constexpr AlignedVec() = default;
+    constexpr AlignedVec(const Vec<N, T> &vec) : Vec<N, T>(vec) {}
+};
+
+template <unsigned int M, unsigned int N, class T,
+          std::size_t Align = detail::layout_alignment(M * N * sizeof(T))>
+    requires(std::has_single_bit(Align) && Align >= alignof(Mat<M, N, T>))
+class alignas(Align) AlignedMat : public Mat<M, N, T> {
+  public:
+    using Mat<M, N, T>::Mat;
+    constexpr AlignedMat() = default;
+    constexpr AlignedMat(const Mat<M, N, T> &mat) : Mat<M, N, T>(mat) {}
+};
+
+/**
+ * @brief Vec3 stored as (x, y, z, 0), aligned to its four lanes.
+ */
+template <class T>
+    requires(std::is_arithmetic_v<T>)
+class alignas(detail::layout_alignment(4 * sizeof(T))) PaddedVec3 {
+  private:
+    Vec<4, T> lanes{};
+
+  public:
+    constexpr PaddedVec3() = default;
+    constexpr PaddedVec3(T x, T y, T z) : lanes(x, y, z, static_cast<T>(0)) {}
+    constexpr PaddedVec3(const Vec<3, T> &vec)
+        : lanes(vec.unchecked(0), vec.unchecked(1), vec.unchecked(2), static_cast<T>(0)) {}
+    constexpr operator Vec<3, T>() const { return xyz(); }
+    constexpr Vec<3, T> xyz() const {
+        return Vec<3, T>(lanes.unchecked(0), lanes.unchecked(1), lanes.unchecked(2));
+    }
+    /**
+     * @return All four lanes, the last one zero.
+     */
+    constexpr const Vec<4, T> &padded() const { return lanes; }
+    /**
+     * @brief Access to x, y and z, the pad lane is not reachable.
+     */
+    constexpr T &operator[](int i) {
+#if SMATH_CHECKED
+        if (i < 0 || i > 2)
+            throw std::out_of_range("Index out of bound");
+#endif
+        return lanes.unchecked(static_cast<unsigned int>(i));
+    }
+    constexpr const T &operator[](int i) const {
+#if SMATH_CHECKED
+        if (i < 0 || i > 2)
+            throw std::out_of_range("Index out of bound");
+#endif
+        return lanes.unchecked(static_cast<unsigned int>(i));
+    }
+    /**
+     * @brief Read without bounds checks, i == 3 reads the zero pad. There is
+     * no writable overload, which would let the pad lane be overwritten.
+     */
+    constexpr const T &unchecked(unsigned int i) const { return lanes.unchecked(i); }
+
+    friend constexpr bool operator==(const PaddedVec3 &a, const PaddedVec3 &b) {
+        return static_cast<bool>(a.lanes == b.lanes);
+    }
+    friend std::ostream &operator<<(std::ostream &o, const PaddedVec3 &v) {
+        return o << "Padded" << v.xyz();
+    }
+};
+
+using AlignedVec2f = AlignedVec<2, float>;
+using AlignedVec3f = AlignedVec<3, float>;
+using AlignedVec4f = AlignedVec<4, float>;
+using AlignedVec2d = AlignedVec<2, double>;
+using AlignedVec3d = AlignedVec<3, double>;
+using AlignedVec4d = AlignedVec<4, double>;
+using AlignedMat3f = AlignedMat<3, 3, float>;
+using AlignedMat4f = AlignedMat<4, 4, float>;
+using AlignedMat3d = AlignedMat<3, 3, double>;
+using AlignedMat4d = AlignedMat<4, 4, double>;
+using PaddedVec3f = PaddedVec3<float>;
+using PaddedVec3d = PaddedVec3<double>;
+
+/***************************************
+        Layout guarantees
+***************************************/
+static_assert(BufferLayout<Vec<3, float>> && BufferLayout<Vec<4, double>>);
+static_assert(BufferLayout<Mat<4, 4, float>> && BufferLayout<Mat<3, 3, double>>);
+static_assert(sizeof(Vec<3, float>) == 12 && alignof(Vec<3, float>) == alignof(float));
+static_assert(sizeof(Mat<4, 4, float>) == 64);
+
+static_assert(BufferLayout<AlignedVec3f> && BufferLayout<AlignedVec4d>);
+static_assert(BufferLayout<AlignedMat4f> && BufferLayout<AlignedMat4d>);
+static_assert(sizeof(AlignedVec3f) == 16 && alignof(AlignedVec3f) == 16);
+static_assert(sizeof(AlignedVec4f) == 16 && alignof(AlignedVec4f) == 16);
+static_assert(sizeof(AlignedVec3d) == 32 && alignof(AlignedVec3d) == 32);
+static_assert(sizeof(AlignedVec4d) == 32 && alignof(AlignedVec4d) == 32);
+static_assert(sizeof(AlignedMat4f) == 64 && alignof(AlignedMat4f) == 64);
+static_assert(sizeof(AlignedMat4d) == 128 && alignof(AlignedMat4d) == 64);
+
+static_assert(BufferLayout<PaddedVec3f> && BufferLayout<PaddedVec3d>);
+static_assert(sizeof(PaddedVec3f) == 16 && alignof(PaddedVec3f) == 16);
+static_assert(sizeof(PaddedVec3d) == 32 && alignof(PaddedVec3d) == 32);
+} // namespace smath
+#endif // SMATH_LAYOUT_HPP
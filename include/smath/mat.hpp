@@ -1,10 +1,11 @@
 #ifndef SMATH_MAT_HPP
 #define SMATH_MAT_HPP
 
+#include "config.hpp"
 #include "vec.hpp"
+#include <array>
 #include <cmath>
 #include <concepts>
-#include <cstring>
 #include <initializer_list>
 #include <iostream>
 #include <ostream>
@@ -13,6 +14,10 @@
 #include <type_traits>
 
 namespace smath {
+template <unsigned int N, class T>
+    requires(std::is_floating_point_v<T> && N <= 32)
+struct LU;
+
 /*
     M := row, N := column
     Mat is a column major matrix
@@ -25,19 +30,108 @@ class Mat {
   private:
     T data[M * N]{};
 
+    /**
+     * @brief The six 2x2 determinants of rows 0/1 and of rows 2/3, taken
+     * over the column pairs 01, 02, 03, 12, 13, 23.
+     */
+    constexpr std::array<std::array<T, 6>, 2> minors4() const
+        requires(M == 4 && N == 4)
+    {
+        const auto pair = [this](unsigned int r, unsigned int i,
+                                 unsigned int j) {
+            return data[i * 4 + r] * data[j * 4 + r + 1] -
+                   data[i * 4 + r + 1] * data[j * 4 + r];
+        };
+        return {{{pair(0, 0, 1), pair(0, 0, 2), pair(0, 0, 3), pair(0, 1, 2),
+                  pair(0, 1, 3), pair(0, 2, 3)},
+                 {pair(2, 0, 1), pair(2, 0, 2), pair(2, 0, 3), pair(2, 1, 2),
+                  pair(2, 1, 3), pair(2, 2, 3)}}};
+    }
+    /**
+     * @brief Assemble [linear -linear*t; 0 1] with t the translation of this.
+     */
+    constexpr Mat<4, 4, T> from_linear_inverse(const Mat<3, 3, T> &linear) const
+        requires(M == 4 && N == 4)
+    {
+        Mat<4, 4, T> result{};
+        for (unsigned int c = 0; c < 3; c++) {
+            for (unsigned int r = 0; r < 3; r++) {
+                result.data[c * 4 + r] = linear.unchecked(c * 3 + r);
+            }
+        }
+        // Each row of -linear * t in one expression, not accumulated in memory.
+        for (unsigned int r = 0; r < 3; r++) {
+            result.data[12 + r] = -(linear.unchecked(r) * data[12] +
+                                    linear.unchecked(3 + r) * data[13] +
+                                    linear.unchecked(6 + r) * data[14]);
+        }
+        result.data[15] = 1;
+        return result;
+    }
+    constexpr Mat<3, 3, T> inverse3() const
+        requires(M == 3 && N == 3)
+    {
+        // The cofactor matrix read row by row is the column major adjugate.
+        const T c0 = data[4] * data[8] - data[7] * data[5];
+        const T c1 = data[7] * data[2] - data[1] * data[8];
+        const T c2 = data[1] * data[5] - data[4] * data[2];
+        const T c3 = data[6] * data[5] - data[3] * data[8];
+        const T c4 = data[0] * data[8] - data[6] * data[2];
+        const T c5 = data[3] * data[2] - data[0] * data[5];
+        const T c6 = data[3] * data[7] - data[6] * data[4];
+        const T c7 = data[6] * data[1] - data[0] * data[7];
+        const T c8 = data[0] * data[4] - data[3] * data[1];
+        const T inv_det = 1 / (data[0] * c0 + data[3] * c1 + data[6] * c2);
+        return Mat<3, 3, T>(c0 * inv_det, c1 * inv_det, c2 * inv_det, c3 * inv_det,
+                            c4 * inv_det, c5 * inv_det, c6 * inv_det, c7 * inv_det,
+                            c8 * inv_det);
+    }
+    constexpr Mat<4, 4, T> inverse4() const
+        requires(M == 4 && N == 4)
+    {
+        const auto [s, c] = minors4();
+        const auto a = [this](unsigned int r, unsigned int col) {
+            return data[col * 4 + r];
+        };
+        const T inv_det = 1 / (s[0] * c[5] - s[1] * c[4] + s[2] * c[3] +
+                               s[3] * c[2] - s[4] * c[1] + s[5] * c[0]);
+        Mat<4, 4, T> result{};
+        T *out = result.data;
+        out[0] = a(1, 1) * c[5] - a(1, 2) * c[4] + a(1, 3) * c[3];
+        out[1] = -a(1, 0) * c[5] + a(1, 2) * c[2] - a(1, 3) * c[1];
+        out[2] = a(1, 0) * c[4] - a(1, 1) * c[2] + a(1, 3) * c[0];
+        out[3] = -a(1, 0) * c[3] + a(1, 1) * c[1] - a(1, 2) * c[0];
+        out[4] = -a(0, 1) * c[5] + a(0, 2) * c[4] - a(0, 3) * c[3];
+        out[5] = a(0, 0) * c[5] - a(0, 2) * c[2] + a(0, 3) * c[1];
+        out[6] = -a(0, 0) * c[4] + a(0, 1) * c[2] - a(0, 3) * c[0];
+        out[7] = a(0, 0) * c[3] - a(0, 1) * c[1] + a(0, 2) * c[0];
+        out[8] = a(3, 1) * s[5] - a(3, 2) * s[4] + a(3, 3) * s[3];
+        out[9] = -a(3, 0) * s[5] + a(3, 2) * s[2] - a(3, 3) * s[1];
+        out[10] = a(3, 0) * s[4] - a(3, 1) * s[2] + a(3, 3) * s[0];
+        out[11] = -a(3, 0) * s[3] + a(3, 1) * s[1] - a(3, 2) * s[0];
+        out[12] = -a(2, 1) * s[5] + a(2, 2) * s[4] - a(2, 3) * s[3];
+        out[13] = a(2, 0) * s[5] - a(2, 2) * s[2] + a(2, 3) * s[1];
+        out[14] = -a(2, 0) * s[4] + a(2, 1) * s[2] - a(2, 3) * s[0];
+        out[15] = a(2, 0) * s[3] - a(2, 1) * s[1] + a(2, 2) * s[0];
+        for (unsigned int i = 0; i < 16; i++) {
+            out[i] *= inv_det;
+        }
+        return result;
+    }
+
   public:
     /***************************************
         Constructors
     ****************************************/
-    Mat() : data{} {}
-    Mat(T value) {
+    constexpr Mat() : data{} {}
+    constexpr Mat(T value) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
                 data[n * M + m] = value;
             }
         }
     }
-    static Mat<M, M, T> identity() {
+    static constexpr Mat<M, M, T> identity() {
         Mat<M, M, T> i = {};
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
@@ -47,7 +141,7 @@ class Mat {
         }
         return i;
     }
-    static Mat<M, N, T> full(const T &value) {
+    static constexpr Mat<M, N, T> full(const T &value) {
         Mat<M, N, T> result = {};
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
@@ -59,18 +153,22 @@ class Mat {
     template <class... Us>
         requires((sizeof...(Us) == M * N) &&
                  (std::convertible_to<Us, T> && ...))
-    Mat(Us... args) : data{static_cast<T>(args)...} {}
+    constexpr Mat(Us... args) : data{static_cast<T>(args)...} {}
     // Copy constructor
     Mat(const Mat &other) = default;
-    Mat(const Vec<M, T> &vec) {
-        std::memcpy(this->data, &(vec.data[0]), M * sizeof(T));
+    constexpr Mat(const Vec<M, T> &vec) {
+        for (unsigned int m = 0; m < M; m++) {
+            data[m] = vec.unchecked(m);
+        }
     }
     // Move constructor
     Mat(Mat &&other) noexcept = default;
-    Mat(const Vec<M, T> &&vec) noexcept {
+    constexpr Mat(const Vec<M, T> &&vec) noexcept {
         if (N != 1)
             throw std::invalid_argument("Invalid Matrix initialisation.");
-        std::memcpy(this->data, &(vec.data[0]), M * sizeof(T));
+        for (unsigned int m = 0; m < M; m++) {
+            data[m] = vec.unchecked(m);
+        }
     }
     // Copy assignment
     Mat<M, N, T> &operator=(const Mat<M, N, T> &other) = default;
@@ -78,21 +176,25 @@ class Mat {
     Mat<M, N, T> &operator=(Mat<M, N, T> &&other) noexcept = default;
 
     // Initializer List
-    Mat(std::initializer_list<T> values) {
+    constexpr Mat(std::initializer_list<T> values) {
         if (values.size()!=M*N){
             throw std::invalid_argument("Initalizer list size does not fit matrix size.");
         }
-        std::memcpy(data, values.begin(), values.size()*sizeof(T));
+        unsigned int i = 0;
+        for (const T &value : values) {
+            data[i++] = value;
+        }
     }
-    Mat(std::initializer_list<Vec<M,T>> vecs){
+    constexpr Mat(std::initializer_list<Vec<M,T>> vecs){
         if (vecs.size()!=N){
             throw std::invalid_argument("Initalizer list size does not fit matrix column number.");
         }
-        const Vec<M,T> *base_address = vecs.begin();
-        for (unsigned int i = 0; i<N; i++){
-            std::memcpy(&data[i*M],
-                        (base_address+i),
-                        sizeof(T)*M);
+        unsigned int n = 0;
+        for (const Vec<M, T> &vec : vecs) {
+            for (unsigned int m = 0; m < M; m++) {
+                data[n * M + m] = vec.unchecked(m);
+            }
+            n++;
         }
     }
 
@@ -104,18 +206,29 @@ class Mat {
      * @brief Get the column of the matrix by index.
      * @param index of type unsigned int.
      */
-    T &operator[](unsigned int index) {
+    constexpr T &operator[](unsigned int index) {
+#if SMATH_CHECKED
         if (index >= M * N) {
             throw std::out_of_range("Index out of bound");
         }
+#endif
         return data[index];
     }
-    const T &operator[](unsigned int index) const {
+    constexpr const T &operator[](unsigned int index) const {
+#if SMATH_CHECKED
         if (index >= M * N) {
             throw std::out_of_range("Index out of bound");
         }
+#endif
         return data[index];
     }
+    /**
+     * @brief Element access without bounds checking, regardless of
+     * SMATH_CHECKED.
+     * @param index of type unsigned int.
+     */
+    constexpr T &unchecked(unsigned int index) { return data[index]; }
+    constexpr const T &unchecked(unsigned int index) const { return data[index]; }
     /**
      * @return String representation of matrix.
      */
@@ -152,28 +265,49 @@ class Mat {
     }
 
     template <unsigned int K>
-    Mat<M, K, T> cross(const Mat<N, K, T> &other) const {
+    constexpr Mat<M, K, T> cross(const Mat<N, K, T> &other) const {
         Mat<M, K, T> result{};
+        if constexpr (M == 4 && N == 4 && K == 4 && simd::accelerated<4, T>) {
+            if !consteval {
+                simd::mul4x4(data, &other.unchecked(0), &result.unchecked(0));
+                return result;
+            }
+        } else if constexpr (simd::gemm_accelerated<M, N, K, T>) {
+            if !consteval {
+                simd::gemm<M, N, K>(data, &other.unchecked(0),
+                                    &result.unchecked(0));
+                return result;
+            }
+        }
         for (unsigned int k = 0; k < K; k++) {
             for (unsigned int m = 0; m < M; m++) {
                 T temp = 0;
                 for (unsigned int n = 0; n < N; n++) {
-                    temp += (*this)[n * M + m] * other[k * N + n];
+                    temp += data[n * M + m] * other.unchecked(k * N + n);
                 }
-                result[k * M + m] = temp;
+                result.unchecked(k * M + m) = temp;
             }
         }
         return result;
     }
 
-    Vec<M, T> cross(const Vec<M, T> &other) const {
+    /**
+     * @brief Matrix-vector product, the columns weighted by other.
+     */
+    constexpr Vec<M, T> cross(const Vec<N, T> &other) const {
         Vec<M, T> result{};
-        for (unsigned int m = 0; m < M; m++) {
-            T temp = 0;
-            for (unsigned int n = 0; n < N; n++) {
-                temp += (*this)[n * M + m] * result[n];
+        if constexpr (M == 4 && N == 4 && simd::accelerated<4, T>) {
+            if !consteval {
+                simd::mul4x4_vec(data, &other.unchecked(0),
+                                 &result.unchecked(0));
+                return result;
+            }
+        }
+        for (unsigned int n = 0; n < N; n++) {
+            const T weight = other.unchecked(n);
+            for (unsigned int m = 0; m < M; m++) {
+                result.unchecked(m) += data[n * M + m] * weight;
             }
-            result[m] = temp;
         }
         return result;
     }
@@ -181,11 +315,11 @@ class Mat {
     /**
      * @return A new transposed version of matrix.
      */
-    Mat<N, M, T> transpose() const {
+    constexpr Mat<N, M, T> transpose() const {
         Mat<N, M, T> copy{};
         for (unsigned int m = 0; m < M; m++) {
             for (unsigned int n = 0; n < N; n++) {
-                copy[m * N + n] = (*this)[n * M + m];
+                copy.unchecked(m * N + n) = data[n * M + m];
             }
         }
         return copy;
@@ -193,13 +327,13 @@ class Mat {
     /**
      * @return A new adjoint version of matrix.
      */
-    Mat<M, N, T> adjoint() const {
+    constexpr Mat<M, N, T> adjoint() const {
         Mat<M, N, T> cofactor{};
 
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
                 const int sign = ((n + m) % 2) ? -1 : 1;
-                cofactor[M * n + m] =
+                cofactor.data[M * n + m] =
                     sign * this->subMatrixAt(n, m).determinant();
             }
         }
@@ -207,12 +341,84 @@ class Mat {
     }
     /**
      * @return A new inverse version of matrix.
+     * @note 2x2, 3x3 and 4x4 use closed forms that share their cofactor
+     * terms with the determinant, larger sizes go through lu().
+     * @throw std::domain_error when a matrix larger than 4x4 is singular.
+     */
+    constexpr Mat<M, N, T> inverse() const
+        requires(M == N)
+    {
+        if constexpr (M == 2) {
+            const T inv_det = 1 / (data[0] * data[3] - data[2] * data[1]);
+            return Mat<2, 2, T>{data[3] * inv_det, -data[1] * inv_det,
+                                -data[2] * inv_det, data[0] * inv_det};
+        } else if constexpr (M == 3) {
+            return inverse3();
+        } else if constexpr (M == 4) {
+#if defined(SMATH_SSE)
+            if constexpr (std::is_same_v<T, float>) {
+                if !consteval {
+                    Mat<4, 4, T> result{};
+                    simd::inverse4(data, result.data);
+                    return result;
+                }
+            }
+#endif
+            return inverse4();
+        } else {
+            const auto inverse = lu().inverse();
+            Mat<M, N, T> result{};
+            for (unsigned int i = 0; i < M * N; i++) {
+                result.data[i] = static_cast<T>(inverse.unchecked(i));
+            }
+            return result;
+        }
+    }
+    /**
+     * @brief Inverse of an affine transform [A t; 0 1], that is
+     * [inverse(A) -inverse(A)t; 0 1]. The bottom row is not read.
      */
-    Mat<M, N, T> inverse() const { return (1 / determinant()) * adjoint(); }
+    constexpr Mat<4, 4, T> inverse_affine() const
+        requires(M == 4 && N == 4)
+    {
+        return from_linear_inverse(to_mat3().inverse());
+    }
+    /**
+     * @brief Inverse of a rotation followed by a translation [R t; 0 1],
+     * that is [transpose(R) -transpose(R)t; 0 1]. R must be orthonormal.
+     */
+    constexpr Mat<4, 4, T> inverse_rigid() const
+        requires(M == 4 && N == 4)
+    {
+        return from_linear_inverse(to_mat3().transpose());
+    }
+    /**
+     * @brief LU factorization with partial pivoting, PA = LU. Integer
+     * matrices are factorized in double.
+     */
+    constexpr auto lu() const
+        requires(M == N)
+    {
+        using F = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+        Mat<M, N, F> factors{};
+        for (unsigned int i = 0; i < M * N; i++) {
+            factors.unchecked(i) = static_cast<F>(data[i]);
+        }
+        return LU<N, F>(factors);
+    }
+    /**
+     * @brief Solve Ax = b for x.
+     * @throw std::domain_error when the matrix is singular.
+     */
+    constexpr auto solve(const Vec<M, T> &b) const
+        requires(M == N)
+    {
+        return lu().solve(b);
+    }
     /**
      * @return Sub-matrix without the column c and row r.
      */
-    Mat<M - 1, N - 1, T> subMatrixAt(unsigned int c, unsigned int r) const {
+    constexpr Mat<M - 1, N - 1, T> subMatrixAt(unsigned int c, unsigned int r) const {
         if constexpr (M <= 1 || N <= 1) {
             throw std::invalid_argument(
                 "Invalid Argument: Matrix is too small");
@@ -224,14 +430,14 @@ class Mat {
         for (unsigned int n = 0; n < N - 1; n++) {
             for (unsigned int m = 0; m < M - 1; m++) {
                 if (m >= r && n >= c) {
-                    sub_matrix[n * (M - 1) + m] =
-                        (*this)[(n + 1) * M + (m + 1)];
+                    sub_matrix.unchecked(n * (M - 1) + m) =
+                        data[(n + 1) * M + (m + 1)];
                 } else if (m >= r) {
-                    sub_matrix[n * (M - 1) + m] = (*this)[(n)*M + (m + 1)];
+                    sub_matrix.unchecked(n * (M - 1) + m) = data[(n)*M + (m + 1)];
                 } else if (n >= c) {
-                    sub_matrix[n * (M - 1) + m] = (*this)[(n + 1) * M + m];
+                    sub_matrix.unchecked(n * (M - 1) + m) = data[(n + 1) * M + m];
                 } else {
-                    sub_matrix[n * (M - 1) + m] = (*this)[(n)*M + (m)];
+                    sub_matrix.unchecked(n * (M - 1) + m) = data[(n)*M + (m)];
                 }
             }
         }
@@ -240,7 +446,7 @@ class Mat {
     /**
      * @brief Simply shrink the 4x4 matrix into 3x3 via discarding values.
      */
-    Mat<3, 3, T> to_mat3() const 
+    constexpr Mat<3, 3, T> to_mat3() const 
     requires(M==4 && N==4)
     {
         return Mat<3,3,T>{
@@ -249,14 +455,14 @@ class Mat {
             data[8],data[9],data[10]
         };
     }
-    Mat<4, 4, T> to_homogeneous() const
+    constexpr Mat<4, 4, T> to_homogeneous() const
         requires(M == 3 && N == 3)
     {
         Mat<4, 4, T> result{};
         for (unsigned int m = 0; m < 3; m++) {
             for (unsigned int n = 0; n < 3; n++) {
 
-                result[m * 4 + n] = data[m * M + n];
+                result.unchecked(m * 4 + n) = data[m * M + n];
             }
         }
         result[15] = static_cast<T>(1.0f);
@@ -270,36 +476,37 @@ class Mat {
      * @brief Get the determinant of the corresponding matrix.
      * @return T the type of data store in the matrix.
      */
-    T determinant() const {
-        if constexpr (M != N) {
-            return std::range_error(
-                "Range Error: Matrix is not a square matrix!");
-        }
+    constexpr T determinant() const
+        requires(M == N)
+    {
         // If the matrix is 1x1, return the value
-        else if constexpr (M == 1) {
+        if constexpr (M == 1) {
             return data[0];
         } else if constexpr (M == 2) {
             // Nothing else just to save template slot
             return data[0] * data[3] - data[1] * data[2];
+        } else if constexpr (M == 3) {
+            return data[0] * (data[4] * data[8] - data[7] * data[5]) +
+                   data[3] * (data[7] * data[2] - data[1] * data[8]) +
+                   data[6] * (data[1] * data[5] - data[4] * data[2]);
+        } else if constexpr (M == 4) {
+            const auto [s, c] = minors4();
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] -
+                   s[4] * c[1] + s[5] * c[0];
         } else {
-            T sum = 0;
-            for (unsigned int n = 0; n < N; n++) {
-                // Refer to determinant method, + - + - + for a 5x5 matrix
-                Mat<M - 1, N - 1, T> sub = this->subMatrixAt(n, 0);
-                T det = sub.determinant();
-                if (n % 2 == 0) {
-                    sum += (*this)[M * n] * det;
-                } else {
-                    sum -= (*this)[M * n] * det;
-                }
+            const auto det = lu().determinant();
+            if constexpr (std::is_integral_v<T>) {
+                // Through long long, so unsigned T wraps like the closed forms.
+                return static_cast<T>(static_cast<long long>(det < 0 ? det - 0.5 : det + 0.5));
+            } else {
+                return det;
             }
-            return sum;
         }
     }
     /**
      * @brief Compute the sum along the matrix diagonal.
      */
-    T trace() const
+    constexpr T trace() const
         requires(M == N)
     {
         T result = static_cast<T>(0.0f);
@@ -310,21 +517,21 @@ class Mat {
     }
 
 
-    bool all() const{
+    constexpr bool all() const{
         for (unsigned int i = 0; i<M*N; i++){
             if(!data[i])
                 return false;
         }
         return true;
     }
-    bool any() const{
+    constexpr bool any() const{
         for (unsigned int i = 0; i<M*N; i++){
             if(data[i])
                 return true;
         }
         return false;
     }
-    bool none() const{
+    constexpr bool none() const{
         return !any();
     }
 
@@ -337,14 +544,14 @@ class Mat {
      * Vec to be able to convert to bool.
      * @return True if and only if all vector elements are True.
      */
-    explicit operator bool() const {
+    explicit constexpr operator bool() const {
         for (unsigned int i = 0; i < N * M; i++) {
-            if (!(*this)[i])
+            if (!data[i])
                 return false;
         }
         return true;
     }
-    friend Mat<M, N, T> operator+(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, T> operator+(const Mat<M, N, T> &a,
                                   const Mat<M, N, T> &b) {
         Mat<M, N, T> result = Mat<M, N, T>();
         for (unsigned int n = 0; n < N; n++) {
@@ -354,7 +561,7 @@ class Mat {
         }
         return result;
     }
-    friend Mat<M, N, T> operator-(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, T> operator-(const Mat<M, N, T> &a,
                                   const Mat<M, N, T> &b) {
         Mat<M, N, T> result = Mat<M, N, T>();
         for (unsigned int n = 0; n < N; n++) {
@@ -364,178 +571,193 @@ class Mat {
         }
         return result;
     }
-    friend Mat<M, N, T> operator*(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, T> operator*(const Mat<M, N, T> &a,
                                   const Mat<M, N, T> &b) {
         Mat<M, N, T> result = Mat<M, N, T>(a);
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                result[n * M + m] *= b[n * M + m];
+                result.data[n * M + m] *= b.data[n * M + m];
             }
         }
         return result;
     }
 
-    friend Mat<M, N, T> operator*(const T &a, const Mat<M, N, T> &b) {
+    /**
+     * @brief Matrix-vector product, same as a.cross(b).
+     */
+    friend constexpr Vec<M, T> operator*(const Mat<M, N, T> &a,
+                                         const Vec<N, T> &b) {
+        return a.cross(b);
+    }
+    friend constexpr Mat<M, N, T> operator*(const T &a, const Mat<M, N, T> &b) {
         Mat<M, N, T> result = b;
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                result[n * M + m] *= a;
+                result.data[n * M + m] *= a;
             }
         }
         return result;
     }
-    friend Mat<M, N, T> operator*(const Mat<M, N, T> a, const T &b) {
+    friend constexpr Mat<M, N, T> operator*(const Mat<M, N, T> a, const T &b) {
         Mat<M, N, T> result = a;
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                result[n * M + m] *= b;
+                result.data[n * M + m] *= b;
             }
         }
         return result;
     }
-    friend Mat<M, N, T> operator/(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, T> operator/(const Mat<M, N, T> &a,
                                   const Mat<M, N, T> &b) {
         Mat<M, N, T> result = Mat<M, N, T>(a);
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                result[n * M + m] /= b[n * M + m];
+                result.data[n * M + m] /= b.data[n * M + m];
             }
         }
         return result;
     }
-    friend Mat<M, N, T> operator/(const Mat<M, N, T> a, const T &b) {
+    friend constexpr Mat<M, N, T> operator/(const Mat<M, N, T> a, const T &b) {
         return a * (1 / b);
     }
-    friend Mat<M, N, T> operator%(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, T> operator%(const Mat<M, N, T> &a,
                                   const Mat<M, N, int> &b) {
         Mat<M, N, T> result = Mat<M, N, T>(a);
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                result[n * M + m] %= b[n * M + m];
+                result.data[n * M + m] %= b.unchecked(n * M + m);
             }
         }
         return result;
     }
-    friend Mat<M, N, T> operator%(const Mat<M, N, T> a, const int &b) {
+    friend constexpr Mat<M, N, T> operator%(const Mat<M, N, T> a, const int &b) {
         Mat<M, N, T> result = a;
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                result[n * M + m] %= b;
+                result.data[n * M + m] %= b;
             }
         }
         return result;
     }
-    Mat<M, N, T> &operator+=(const Mat<M, N, T> &other) {
+    constexpr Mat<M, N, T> &operator+=(const Mat<M, N, T> &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] += other[n * M + m];
+                data[n * M + m] += other.data[n * M + m];
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator-=(const Mat<M, N, T> &other) {
+    constexpr Mat<M, N, T> &operator-=(const Mat<M, N, T> &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] -= other[n * M + m];
+                data[n * M + m] -= other.data[n * M + m];
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator*=(const Mat<M, N, T> &other) {
+    constexpr Mat<M, N, T> &operator*=(const Mat<M, N, T> &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] *= other[n * M + m];
+                data[n * M + m] *= other.data[n * M + m];
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator*=(const T &other) {
+    constexpr Mat<M, N, T> &operator*=(const T &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] *= other;
+                data[n * M + m] *= other;
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator/=(const Mat<M, N, T> &other) {
+    constexpr Mat<M, N, T> &operator/=(const Mat<M, N, T> &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] /= other[n * M + m];
+                data[n * M + m] /= other.data[n * M + m];
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator/=(const T &other) {
+    constexpr Mat<M, N, T> &operator/=(const T &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] /= other;
+                data[n * M + m] /= other;
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator%=(const Mat<M, N, T> &other) {
+    constexpr Mat<M, N, T> &operator%=(const Mat<M, N, T> &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] %= other[n * M + m];
+                data[n * M + m] %= other.data[n * M + m];
             }
         }
+        return *this;
     }
-    Mat<M, N, T> &operator%=(const T &other) {
+    constexpr Mat<M, N, T> &operator%=(const T &other) {
         for (unsigned int n = 0; n < N; n++) {
             for (unsigned int m = 0; m < M; m++) {
-                (*this)[n * M + m] %= other;
+                data[n * M + m] %= other;
             }
         }
+        return *this;
     }
     /***************************************
             Relational Operators
     ****************************************/
-    friend Mat<M, N, unsigned int> operator==(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, unsigned int> operator==(const Mat<M, N, T> &a,
                                               const Mat<M, N, T> &b) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i] == b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] == b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Mat<M, N, unsigned int> operator!=(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, unsigned int> operator!=(const Mat<M, N, T> &a,
                                               const Mat<M, N, T> &b) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i] != b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] != b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Mat<M, N, unsigned int> operator<(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, unsigned int> operator<(const Mat<M, N, T> &a,
                                              const Mat<M, N, T> &b) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i] < b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] < b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Mat<M, N, unsigned int> operator>(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, unsigned int> operator>(const Mat<M, N, T> &a,
                                              const Mat<M, N, T> &b) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i] > b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] > b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Mat<M, N, unsigned int> operator<=(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, unsigned int> operator<=(const Mat<M, N, T> &a,
                                               const Mat<M, N, T> &b) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i] <= b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] <= b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Mat<M, N, unsigned int> operator>=(const Mat<M, N, T> &a,
+    friend constexpr Mat<M, N, unsigned int> operator>=(const Mat<M, N, T> &a,
                                               const Mat<M, N, T> &b) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i] >= b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] >= b.data[i]) ? 1 : 0;
         }
         return result;
     }
     friend bool operator!(const Mat<M, N, T> &a) {
         Mat<M, N, unsigned int> result{};
         for (unsigned int i = 0; i < M * N; i++) {
-            result[i] = (a[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i]) ? 1 : 0;
         }
         return result;
     }
@@ -544,6 +766,156 @@ class Mat {
         return o;
     }
 };
+/*
+    LU factorization with partial pivoting of a square matrix, PA = LU.
+    L (unit diagonal, not stored) and U share one matrix: L strictly below
+    the diagonal, U on and above it. Row i of PA is row pivot[i] of A.
+*/
+template <unsigned int N, class T>
+    requires(std::is_floating_point_v<T> && N <= 32)
+struct LU {
+    Mat<N, N, T> factors{};
+    std::array<unsigned int, N> pivot{};
+    // +1 or -1, the sign of the permutation.
+    int parity = 1;
+    bool singular = false;
+
+    /**
+     * @brief Factorize a in place, column by column.
+     */
+    constexpr explicit LU(const Mat<N, N, T> &a) : factors(a) {
+        for (unsigned int i = 0; i < N; i++) {
+            pivot[i] = i;
+        }
+        for (unsigned int k = 0; k < N; k++) {
+            unsigned int p = k;
+            T max = abs(at(k, k));
+            for (unsigned int r = k + 1; r < N; r++) {
+                if (abs(at(r, k)) > max) {
+                    max = abs(at(r, k));
+                    p = r;
+                }
+            }
+            if (max == 0) {
+                singular = true;
+                continue;
+            }
+            if (p != k) {
+                for (unsigned int c = 0; c < N; c++) {
+                    const T tmp = at(k, c);
+                    at(k, c) = at(p, c);
+                    at(p, c) = tmp;
+                }
+                const unsigned int tmp = pivot[k];
+                pivot[k] = pivot[p];
+                pivot[p] = tmp;
+                parity = -parity;
+            }
+            const T inv_pivot = 1 / at(k, k);
+            for (unsigned int r = k + 1; r < N; r++) {
+                at(r, k) *= inv_pivot;
+            }
+            // Rank-1 update of the trailing block, walking down columns.
+            for (unsigned int c = k + 1; c < N; c++) {
+                const T f = at(k, c);
+                for (unsigned int r = k + 1; r < N; r++) {
+                    at(r, c) -= at(r, k) * f;
+                }
+            }
+        }
+    }
+
+    constexpr T determinant() const {
+        if (singular)
+            return static_cast<T>(0);
+        T det = static_cast<T>(parity);
+        for (unsigned int i = 0; i < N; i++) {
+            det *= at(i, i);
+        }
+        return det;
+    }
+    /**
+     * @throw std::domain_error when the matrix is singular.
+     */
+    template <class U> constexpr Vec<N, T> solve(const Vec<N, U> &b) const {
+        check_singular();
+        Vec<N, T> x{};
+        for (unsigned int i = 0; i < N; i++) {
+            x.unchecked(i) = static_cast<T>(b.unchecked(pivot[i]));
+        }
+        substitute(&x.unchecked(0));
+        return x;
+    }
+    /**
+     * @throw std::domain_error when the matrix is singular.
+     */
+    constexpr Mat<N, N, T> inverse() const {
+        check_singular();
+        Mat<N, N, T> result{};
+        for (unsigned int c = 0; c < N; c++) {
+            for (unsigned int i = 0; i < N; i++) {
+                result.unchecked(c * N + i) = (pivot[i] == c) ? 1 : 0;
+            }
+            substitute(&result.unchecked(c * N));
+        }
+        return result;
+    }
+    /**
+     * @return Unit lower triangular factor.
+     */
+    constexpr Mat<N, N, T> lower() const {
+        Mat<N, N, T> result{};
+        for (unsigned int c = 0; c < N; c++) {
+            result.unchecked(c * N + c) = 1;
+            for (unsigned int r = c + 1; r < N; r++) {
+                result.unchecked(c * N + r) = at(r, c);
+            }
+        }
+        return result;
+    }
+    /**
+     * @return Upper triangular factor.
+     */
+    constexpr Mat<N, N, T> upper() const {
+        Mat<N, N, T> result{};
+        for (unsigned int c = 0; c < N; c++) {
+            for (unsigned int r = 0; r <= c; r++) {
+                result.unchecked(c * N + r) = at(r, c);
+            }
+        }
+        return result;
+    }
+
+  private:
+    static constexpr T abs(const T &value) { return value < 0 ? -value : value; }
+    constexpr T &at(unsigned int r, unsigned int c) {
+        return factors.unchecked(c * N + r);
+    }
+    constexpr const T &at(unsigned int r, unsigned int c) const {
+        return factors.unchecked(c * N + r);
+    }
+    constexpr void check_singular() const {
+        if (singular)
+            throw std::domain_error("Matrix is singular.");
+    }
+    /**
+     * @brief Forward then backward substitution of one permuted column.
+     */
+    constexpr void substitute(T *x) const {
+        for (unsigned int c = 0; c < N; c++) {
+            for (unsigned int r = c + 1; r < N; r++) {
+                x[r] -= at(r, c) * x[c];
+            }
+        }
+        for (unsigned int c = N; c-- > 0;) {
+            x[c] /= at(c, c);
+            for (unsigned int r = 0; r < c; r++) {
+                x[r] -= at(r, c) * x[c];
+            }
+        }
+    }
+};
+
 using Mat4u = Mat<4, 4, unsigned int>;
 using Mat3u = Mat<3, 3, unsigned int>;
 using Mat2u = Mat<2, 2, unsigned int>;
@@ -562,59 +934,87 @@ using Mat1d = Mat<1, 1, double>;
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<2, 2, T> euler(const T &radian) {
-    using namespace std;
-    return Mat<2, 2, T>{cos(radian), sin(radian), -sin(radian), cos(radian)};
+constexpr Mat<2, 2, T> euler(const T &radian) {
+    const auto [s, c] = sincos(radian);
+    return Mat<2, 2, T>{c, s, -s, c};
 }
 /**
  * @brief Short-cut for 3D euler rotation about x-axis.
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<3, 3, T> euler_x(const T &radian) {
-    using namespace std;
-    return Mat<3, 3, T>{
-        1, 0, 0, 0, cos(radian), sin(radian), 0, -sin(radian), cos(radian)};
+constexpr Mat<3, 3, T> euler_x(const T &radian) {
+    const auto [s, c] = sincos(radian);
+    return Mat<3, 3, T>{1, 0, 0, 0, c, s, 0, -s, c};
 }
 /**
  * @brief Short-cut for 3D euler rotation about y-axis.
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<3, 3, T> euler_y(const T &radian) {
-    using namespace std;
-    return Mat<3, 3, T>{cos(radian), 0, -sin(radian), 0, 1, 0,
-                        sin(radian), 0, cos(radian)};
+constexpr Mat<3, 3, T> euler_y(const T &radian) {
+    const auto [s, c] = sincos(radian);
+    return Mat<3, 3, T>{c, 0, -s, 0, 1, 0, s, 0, c};
 }
 /**
  * @brief Short-cut for 3D euler rotation about z-axis.
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<3, 3, T> euler_z(const T &radian) {
-    using namespace std;
+constexpr Mat<3, 3, T> euler_z(const T &radian) {
+    const auto [s, c] = sincos(radian);
+    return Mat<3, 3, T>{c, s, 0, -s, c, 0, 0, 0, 1};
+}
+/**
+ * @brief euler_x(x).cross(euler_y(y)).cross(euler_z(z)) written out, the
+ * z rotation is applied to a vector first.
+ */
+template <class T>
+    requires(std::is_arithmetic_v<T>)
+constexpr Mat<3, 3, T> euler_xyz(const T &x, const T &y, const T &z) {
+    const auto [sx, cx] = sincos(x);
+    const auto [sy, cy] = sincos(y);
+    const auto [sz, cz] = sincos(z);
+    return Mat<3, 3, T>{
+        cy * cz,  cx * sz + sx * sy * cz, sx * sz - cx * sy * cz,
+        -cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz,
+        sy,       -sx * cy,               cx * cy};
+}
+/**
+ * @brief euler_z(z).cross(euler_y(y)).cross(euler_x(x)) written out, the
+ * x rotation is applied to a vector first.
+ */
+template <class T>
+    requires(std::is_arithmetic_v<T>)
+constexpr Mat<3, 3, T> euler_zyx(const T &x, const T &y, const T &z) {
+    const auto [sx, cx] = sincos(x);
+    const auto [sy, cy] = sincos(y);
+    const auto [sz, cz] = sincos(z);
     return Mat<3, 3, T>{
-        cos(radian), sin(radian), 0, -sin(radian), cos(radian), 0, 0, 0, 1};
+        cz * cy,                sz * cy,                -sy,
+        cz * sy * sx - sz * cx, sz * sy * sx + cz * cx, cy * sx,
+        cz * sy * cx + sz * sx, sz * sy * cx - cz * sx, cy * cx};
 }
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<4,4,T> rotation(const T& radian, const Vec<3,T>& axis = {1,0,0}){
+constexpr Mat<4,4,T> rotation(const T& radian, const Vec<3,T>& axis = {1,0,0}){
     const auto unit = axis.normalize();
-    using namespace std;
+    const auto [s, c] = sincos(radian);
+    const T t = 1 - c;
     Mat<4, 4, T> rotation = {
-        (unit[0] * unit[0])*(1 - cos(radian)) + cos(radian),
-        (unit[0] * unit[1])*(1 - cos(radian)) + unit[2] * sin(radian),
-        (unit[0] * unit[2])*(1 - cos(radian)) - unit[1] * sin(radian),
+        (unit[0] * unit[0])*t + c,
+        (unit[0] * unit[1])*t + unit[2] * s,
+        (unit[0] * unit[2])*t - unit[1] * s,
         0,
 
-        (unit[0] * unit[1])*(1 - cos(radian)) - unit[2] * sin(radian),
-        (unit[1] * unit[1])*(1 - cos(radian)) + cos(radian),
-        (unit[1] * unit[2])*(1 - cos(radian)) + unit[0] * sin(radian),
+        (unit[0] * unit[1])*t - unit[2] * s,
+        (unit[1] * unit[1])*t + c,
+        (unit[1] * unit[2])*t + unit[0] * s,
         0,
 
-        (unit[0] * unit[2])*(1 - cos(radian)) + unit[1] * sin(radian),
-        (unit[1] * unit[2])*(1 - cos(radian)) - unit[0] * sin(radian),
-        (unit[2] * unit[2])*(1 - cos(radian)) + cos(radian),
+        (unit[0] * unit[2])*t + unit[1] * s,
+        (unit[1] * unit[2])*t - unit[0] * s,
+        (unit[2] * unit[2])*t + c,
         0,
 
         0,
@@ -628,14 +1028,14 @@ Mat<4,4,T> rotation(const T& radian, const Vec<3,T>& axis = {1,0,0}){
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<3, 3, T> translation2(const T &x, const T &y) {
+constexpr Mat<3, 3, T> translation2(const T &x, const T &y) {
     return Mat<3, 3, T>{
         1, 0, 0, 0, 1, 0, x, y, 1,
     };
 }
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<3, 3, T> translation2(const Vec<2,T> &translation) {
+constexpr Mat<3, 3, T> translation2(const Vec<2,T> &translation) {
     return Mat<3, 3, T>{
         1, 0, 0, 0, 1, 0, translation[0], translation[1], 1,
     };
@@ -645,12 +1045,12 @@ Mat<3, 3, T> translation2(const Vec<2,T> &translation) {
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<4, 4, T> translation3(const T &x, const T &y, const T &z) {
+constexpr Mat<4, 4, T> translation3(const T &x, const T &y, const T &z) {
     return Mat<4, 4, T>{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, x, y, z, 1};
 }
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<4, 4, T> translation3(const Vec<3,T> &translation) {
+constexpr Mat<4, 4, T> translation3(const Vec<3,T> &translation) {
     return Mat<4, 4, T>{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, translation[0], translation[1], translation[2], 1};
 }
 
@@ -659,7 +1059,7 @@ Mat<4, 4, T> translation3(const Vec<3,T> &translation) {
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<2, 2, T> scale2(const T &x, const T &y) {
+constexpr Mat<2, 2, T> scale2(const T &x, const T &y) {
     return Mat<2, 2, T>{x, 0, 0, y};
 }
 /**
@@ -667,20 +1067,24 @@ Mat<2, 2, T> scale2(const T &x, const T &y) {
  */
 template <class T>
     requires(std::is_arithmetic_v<T>)
-Mat<3, 3, T> scale3(const T &x, const T &y, const T &z) {
+constexpr Mat<3, 3, T> scale3(const T &x, const T &y, const T &z) {
     return Mat<3, 3, T>{x, 0, 0, 0, y, 0, 0, 0, z};
 }
 /**
  * @return Calculate the outer product of vectors.
  */
 template <unsigned int N, class T>
-Mat<N, N, T> outer_product(const Vec<N, T> left, const Vec<N, T> right) {
-    Mat<N, 1, T> l{left};
-    Mat<1, N, T> r{right};
-    return l.cross(r.transpose());
+constexpr Mat<N, N, T> outer_product(const Vec<N, T> left, const Vec<N, T> right) {
+    Mat<N, N, T> result{};
+    for (unsigned int c = 0; c < N; c++) {
+        for (unsigned int r = 0; r < N; r++) {
+            result.unchecked(c * N + r) = left.unchecked(r) * right.unchecked(c);
+        }
+    }
+    return result;
 }
 template <class T>
-std::array<Mat<4,4,T>, 3> decompose(const Mat<4,4,T> mat){
+constexpr std::array<Mat<4,4,T>, 3> decompose(const Mat<4,4,T> mat){
     Mat<4,4,T> translation = Mat<4,4,T>::identity();
     Mat<4,4,T> scale = Mat<4,4,T>::identity();
     Mat<4,4,T> copy{mat};
@@ -708,7 +1112,7 @@ std::array<Mat<4,4,T>, 3> decompose(const Mat<4,4,T> mat){
  * @return Essentially Generate View matrix.
  */
 template <class T>
-Mat<4, 4, T> look_at(const Vec<3, T> &eye, const Vec<3, T> &target,
+constexpr Mat<4, 4, T> look_at(const Vec<3, T> &eye, const Vec<3, T> &target,
                      const Vec<3, T> &up) {
     const Vec<3, T> forward = (target - eye).normalize_or_zero();
     const Vec<3, T> right =
@@ -731,7 +1135,7 @@ Mat<4, 4, T> look_at(const Vec<3, T> &eye, const Vec<3, T> &target,
  */
 template <class T>
     requires(std::is_arithmetic<T>::value)
-Mat<4, 4, T> perspective(const T &aspect_ratio, const T &fov, const T &near,
+constexpr Mat<4, 4, T> perspective(const T &aspect_ratio, const T &fov, const T &near,
                          const T &far) {
     return Mat<4, 4, T>{1 / (aspect_ratio * std::tan(fov / 2)),
                         0,
@@ -757,7 +1161,7 @@ Mat<4, 4, T> perspective(const T &aspect_ratio, const T &fov, const T &near,
  * distance from the camera.
  */
 template <class T>
-Mat<4, 4, T> perspective(const T &left, const T &right, const T &top,
+constexpr Mat<4, 4, T> perspective(const T &left, const T &right, const T &top,
                          const T &bottom, const T &near, const T &far) {
     return Mat<4, 4, T>{(2 * near) / (right - left),
                         0,
@@ -783,7 +1187,7 @@ Mat<4, 4, T> perspective(const T &left, const T &right, const T &top,
  * camera.
  */
 template <class T>
-Mat<4, 4, T> orthgraphic(const T &left, const T &right, const T &top,
+constexpr Mat<4, 4, T> orthgraphic(const T &left, const T &right, const T &top,
                          const T &bottom, const T &near, const T &far) {
     return Mat<4, 4, T>{2 / (right - left),
                         0,
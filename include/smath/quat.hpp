@@ -1,10 +1,13 @@
 #ifndef SMATH_QUAT_HPP
 #define SMATH_QUAT_HPP
 
+#include "fast.hpp"
 #include "mat.hpp"
 #include <cmath>
 #include <concepts>
 #include <initializer_list>
+#include <ranges>
+#include <stdexcept>
 #include <string>
 namespace smath {
 template <class T>
@@ -17,10 +20,10 @@ class Quat {
     /***************************************
             Constructors
     ****************************************/
-    Quat() : data{} {}
-    Quat(const T &q0, const T &q1, const T &q2, const T &q3)
+    constexpr Quat() : data{} {}
+    constexpr Quat(const T &q0, const T &q1, const T &q2, const T &q3)
         : data{q0, q1, q2, q3} {}
-    Quat(const T &real, const Vec<3, T> &imaginary)
+    constexpr Quat(const T &real, const Vec<3, T> &imaginary)
         : data{real, imaginary[0], imaginary[1], imaginary[2]} {}
     // Copy constructor
     Quat(const Quat &other) = default;
@@ -31,11 +34,17 @@ class Quat {
     // Move assignment
     Quat &operator= (Quat && other) = default;
     // Initializer list
-    Quat(std::initializer_list<T> values) {
-        std::memcpy(data, values.begin(), sizeof(T)*4);
+    constexpr Quat(std::initializer_list<T> values) : data{} {
+        if (values.size() != 4) {
+            throw std::invalid_argument("Number of values mismatched quaternion size.");
+        }
+        unsigned int i = 0;
+        for (const T &value : values) {
+            data[i++] = value;
+        }
     }
 
-    static Quat<T> identity() {
+    static constexpr Quat<T> identity() {
         return Quat<T>{1.0f,0.0f,0.0f,0.0f};
 
     }
@@ -48,9 +57,11 @@ class Quat {
      * @param i zero-based index
      * @return data[i]
      */
-    T &operator[](int i) {
+    constexpr T &operator[](int i) {
+#if SMATH_CHECKED
         if (i < 0 || i > 3)
             throw std::out_of_range("Index out of bound");
+#endif
         return data[i];
     }
     /**
@@ -58,21 +69,37 @@ class Quat {
      * @param i zero-based index
      * @return data[i]
      */
-    const T &operator[](int i) const {
+    constexpr const T &operator[](int i) const {
+#if SMATH_CHECKED
         if (i < 0 || i > 3)
             throw std::out_of_range("Index out of bound");
+#endif
         return data[i];
     }
+    /**
+     * @brief Element access without bounds checking, regardless of
+     * SMATH_CHECKED.
+     * @param i zero-based index
+     * @return data[i]
+     */
+    constexpr T &unchecked(unsigned int i) { return data[i]; }
+    /**
+     * @brief Element access without bounds checking, regardless of
+     * SMATH_CHECKED.
+     * @param i zero-based index
+     * @return data[i]
+     */
+    constexpr const T &unchecked(unsigned int i) const { return data[i]; }
     /**
      * @return scalar components
      */
-    const T scalar() const {
+    constexpr const T scalar() const {
         return data[0];
     }
     /**
      * @return imaginary components
      */
-    const Vec<3,T> vector() const {
+    constexpr const Vec<3,T> vector() const {
         return Vec<3,T>{data[1], data[2], data[3]};
     }
     /**
@@ -104,25 +131,25 @@ class Quat {
     /***************************************
            Operations
     ****************************************/
-    Quat<T> mul(const Quat<T> &other) const{
+    constexpr Quat<T> mul(const Quat<T> &other) const{
         return Quat<T>{
-            data[0]*other[0]-data[1]*other[1]-data[2]*other[2]-data[3]*other[3],
-            data[0]*other[1]+data[1]*other[0]+data[2]*other[3]-data[3]*other[2],
-            data[0]*other[2]+data[2]*other[0]+data[3]*other[1]-data[1]*other[3],
-            data[0]*other[3]+data[3]*other[0]+data[1]*other[2]-data[2]*other[1]
+            data[0]*other.data[0]-data[1]*other.data[1]-data[2]*other.data[2]-data[3]*other.data[3],
+            data[0]*other.data[1]+data[1]*other.data[0]+data[2]*other.data[3]-data[3]*other.data[2],
+            data[0]*other.data[2]+data[2]*other.data[0]+data[3]*other.data[1]-data[1]*other.data[3],
+            data[0]*other.data[3]+data[3]*other.data[0]+data[1]*other.data[2]-data[2]*other.data[1]
         };
     }
-    T dot(const Quat<T> &other) const{
-        return data[0]*other[0]+data[1]*other[1]+data[2]*other[2]+data[3]*other[3];
+    constexpr T dot(const Quat<T> &other) const{
+        return data[0]*other.data[0]+data[1]*other.data[1]+data[2]*other.data[2]+data[3]*other.data[3];
     }
-    Quat<T> conjugate() const {
+    constexpr Quat<T> conjugate() const {
         return Quat{data[0], -data[1], -data[2], -data[3]};
     }
     /**
      * @return Normalized Quaternion of the operand. Raise error when
      * encounter a zero-quaternion
      */
-    Quat<T> normalize() const {
+    constexpr Quat<T> normalize() const {
         T divisor = length();
         if(divisor==0){
             throw std::logic_error("Cannot normalize a zero-quaternion.");
@@ -133,7 +160,7 @@ class Quat {
      * @return Normalized Quaternion of the operand. Return zero-quaternion when
      * encounter a zero-quaternion
      */
-    Quat<T> normalize_or_zero() const {
+    constexpr Quat<T> normalize_or_zero() const {
         T divisor = length();
         if(divisor==0){
             return {0,0,0,0};
@@ -144,7 +171,7 @@ class Quat {
      * @return Normalized Quaternion of the operand. Return default-quaternion when
      * encounter a zero-quaternion
      */
-    Quat<T> normalize_or_one() const {
+    constexpr Quat<T> normalize_or_one() const {
         T divisor = length();
         if(divisor==0){
             return {1,0,0,0};
@@ -154,89 +181,140 @@ class Quat {
     /**
      * @return length of the Quaternion.
      */
-    T length() const {
+    constexpr T length() const {
         return std::sqrt(length2());
     }
     /**
      * @return squared length of the Quaternion.
      */
-    T length2() const {
+    constexpr T length2() const {
         return data[0] * data[0] + data[1] * data[1] + data[2] * data[2] +
                data[3] * data[3];
     }
     Quat<T> inverse() const { return this->conjugate() / this->length2(); }
+    /**
+     * @brief Rotate a vector by a unit quaternion, q v q* expanded to
+     * t = 2 (u x v), v' = v + w t + u x t with u the imaginary part. The
+     * quaternion is not re-normalized, use to_mat3() for non-unit ones.
+     */
+    constexpr Vec<3, T> rotate(const Vec<3, T> &v) const {
+        const T tx = 2 * (data[2] * v.unchecked(2) - data[3] * v.unchecked(1));
+        const T ty = 2 * (data[3] * v.unchecked(0) - data[1] * v.unchecked(2));
+        const T tz = 2 * (data[1] * v.unchecked(1) - data[2] * v.unchecked(0));
+        return Vec<3, T>{v.unchecked(0) + data[0] * tx + (data[2] * tz - data[3] * ty),
+                         v.unchecked(1) + data[0] * ty + (data[3] * tx - data[1] * tz),
+                         v.unchecked(2) + data[0] * tz + (data[1] * ty - data[2] * tx)};
+    }
     /**
      * @brief Convert Quaternion into Mat3x3
      */
-    Mat<3, 3, T> to_mat3() const {
+    constexpr Mat<3, 3, T> to_mat3() const {
         auto q = this->normalize_or_one();
-        return Mat<3, 3, T>{static_cast<T>(2.0f) * (q[0] * q[0] + q[1] * q[1] - static_cast<T>(0.5)),
-                            static_cast<T>(2.0f) * (q[0] * q[3] + q[1] * q[2]),
-                            static_cast<T>(2.0f) * (q[1] * q[3] - q[0] * q[2]),
-                            static_cast<T>(2.0f) * (q[1] * q[2] - q[0] * q[3]),
-                            static_cast<T>(2.0f) * (q[0] * q[0] + q[2] * q[2] - static_cast<T>(0.5)),
-                            static_cast<T>(2.0f) * (q[0] * q[1] + q[2] * q[3]),
-                            static_cast<T>(2.0f) * (q[0] * q[2] + q[1] * q[3]),
-                            static_cast<T>(2.0f) * (q[2] * q[3] + q[0] * q[1]),
-                            static_cast<T>(2.0f) * (q[0] * q[0] + q[3] * q[3] - static_cast<T>(0.5))};
+        return Mat<3, 3, T>{static_cast<T>(2.0f) * (q.data[0] * q.data[0] + q.data[1] * q.data[1] - static_cast<T>(0.5)),
+                            static_cast<T>(2.0f) * (q.data[0] * q.data[3] + q.data[1] * q.data[2]),
+                            static_cast<T>(2.0f) * (q.data[1] * q.data[3] - q.data[0] * q.data[2]),
+                            static_cast<T>(2.0f) * (q.data[1] * q.data[2] - q.data[0] * q.data[3]),
+                            static_cast<T>(2.0f) * (q.data[0] * q.data[0] + q.data[2] * q.data[2] - static_cast<T>(0.5)),
+                            static_cast<T>(2.0f) * (q.data[0] * q.data[1] + q.data[2] * q.data[3]),
+                            static_cast<T>(2.0f) * (q.data[0] * q.data[2] + q.data[1] * q.data[3]),
+                            static_cast<T>(2.0f) * (q.data[2] * q.data[3] - q.data[0] * q.data[1]),
+                            static_cast<T>(2.0f) * (q.data[0] * q.data[0] + q.data[3] * q.data[3] - static_cast<T>(0.5))};
     }
     /**
      * @brief Convert Quaternion into Mat4x4
      */
-    Mat<4, 4, T> to_mat4() const {
+    constexpr Mat<4, 4, T> to_mat4() const {
         return to_mat3().to_homogeneous();
     }
     /**
      * @brief Convert an Eular rotation matrix to Quaternion. Using method
      * described in "Accurate Computation of Quaternions from Rotation Matrices" in January 2019.
+     * The magnitudes come from the diagonal, the signs from the off-diagonal
+     * differences (or, for half turns where those vanish, from the sums
+     * relative to the largest component). The scalar part is non-negative.
      */
-    Quat<T> from_mat3(const Mat<3, 3, T>& matrix, const T& threshold = 0) const {
+    static constexpr Quat<T> from_mat3(const Mat<3, 3, T>& matrix, const T& threshold = 0) {
+        using std::sqrt;
         const Mat<3, 3, T> &m = matrix;
+        const T half = static_cast<T>(0.5);
         const T q_0 = (m[0] + m[4] + m[8] > threshold)
-                          ? (1 / 2) * sqrt(1 + m[0] + m[4] + m[8])
-                          : (1 / 2) * sqrt(((m[5] - m[7]) * (m[5] - m[7]) +
-                                            (m[6] - m[2]) * (m[6] - m[2]) +
-                                            (m[1] - m[3]) * (m[1] - m[3])) /
-                                           (3 - m[0] - m[4] - m[8]));
+                          ? half * sqrt(1 + m[0] + m[4] + m[8])
+                          : half * sqrt(((m[5] - m[7]) * (m[5] - m[7]) +
+                                         (m[6] - m[2]) * (m[6] - m[2]) +
+                                         (m[1] - m[3]) * (m[1] - m[3])) /
+                                        (3 - m[0] - m[4] - m[8]));
         const T q_1 = (m[0] - m[4] - m[8] > threshold)
-                          ? (1 / 2) * sqrt(1 + m[0] - m[4] - m[8])
-                          : (1 / 2) * sqrt(((m[5] - m[7]) * (m[5] - m[7]) +
-                                            (m[3] + m[1]) * (m[3] + m[1]) +
-                                            (m[2] + m[6]) * (m[2] + m[6])) /
-                                           (3 - m[0] + m[4] + m[8]));
+                          ? half * sqrt(1 + m[0] - m[4] - m[8])
+                          : half * sqrt(((m[5] - m[7]) * (m[5] - m[7]) +
+                                         (m[3] + m[1]) * (m[3] + m[1]) +
+                                         (m[2] + m[6]) * (m[2] + m[6])) /
+                                        (3 - m[0] + m[4] + m[8]));
         const T q_2 = (-m[0] + m[4] - m[8] > threshold)
-                          ? (1 / 2) * sqrt(1 - m[0] + m[4] - m[8])
-                          : (1 / 2) * sqrt(((m[6] - m[2]) * (m[6] - m[2]) +
-                                            (m[3] + m[1]) * (m[3] + m[1]) +
-                                            (m[7] + m[5]) * (m[7] + m[5])) /
-                                           (3 + m[0] - m[4] + m[8]));
+                          ? half * sqrt(1 - m[0] + m[4] - m[8])
+                          : half * sqrt(((m[6] - m[2]) * (m[6] - m[2]) +
+                                         (m[3] + m[1]) * (m[3] + m[1]) +
+                                         (m[7] + m[5]) * (m[7] + m[5])) /
+                                        (3 + m[0] - m[4] + m[8]));
         const T q_3 = (-m[0] - m[4] + m[8] > threshold)
-                          ? (1 / 2) * sqrt(1 - m[0] - m[4] + m[8])
-                          : (1 / 2) * sqrt(((m[1] - m[3]) * (m[1] - m[3]) +
-                                            (m[6] + m[2]) * (m[6] + m[2]) +
-                                            (m[5] + m[7]) * (m[5] + m[7])) /
-                                           (3 + m[0] + m[4] - m[8]));
-        ;
-        return Quat<T>{q_0, q_1, q_2, q_3};
-    }
-    Quat<T> from_mat4(const Mat<4, 4, T>& mat) const {
+                          ? half * sqrt(1 - m[0] - m[4] + m[8])
+                          : half * sqrt(((m[1] - m[3]) * (m[1] - m[3]) +
+                                         (m[6] + m[2]) * (m[6] + m[2]) +
+                                         (m[5] + m[7]) * (m[5] + m[7])) /
+                                        (3 + m[0] + m[4] - m[8]));
+        // q0 * qi ~ differences, qi * qj ~ sums.
+        const T difference[3] = {m[5] - m[7], m[6] - m[2], m[1] - m[3]};
+        const T sum[3][3] = {{0, m[1] + m[3], m[2] + m[6]},
+                             {m[1] + m[3], 0, m[5] + m[7]},
+                             {m[2] + m[6], m[5] + m[7], 0}};
+        T q[4] = {q_0, q_1, q_2, q_3};
+        unsigned int largest = 1;
+        for (unsigned int i = 2; i < 4; i++) {
+            if (q[i] > q[largest])
+                largest = i;
+        }
+        if (q_0 >= q[largest]) {
+            for (unsigned int i = 1; i < 4; i++) {
+                q[i] = (difference[i - 1] < 0) ? -q[i] : q[i];
+            }
+        } else {
+            for (unsigned int i = 1; i < 4; i++) {
+                if (i != largest && sum[largest - 1][i - 1] < 0)
+                    q[i] = -q[i];
+            }
+            if (difference[largest - 1] < 0) {
+                for (unsigned int i = 1; i < 4; i++) {
+                    q[i] = -q[i];
+                }
+            }
+        }
+        return Quat<T>{q[0], q[1], q[2], q[3]};
+    }
+    static constexpr Quat<T> from_mat4(const Mat<4, 4, T>& mat) {
         return from_mat3(mat.to_mat3());
     }
-    bool all() const{
+    /**
+     * @brief Rotation by radian around axis, right-handed as rotation().
+     * axis need not be unit length, it is normalized.
+     */
+    static constexpr Quat<T> from_axis_angle(const T &radian, const Vec<3, T> &axis) {
+        const auto [s, c] = sincos(radian / 2);
+        return Quat<T>(c, axis.normalize() * s);
+    }
+    constexpr bool all() const{
         for (unsigned int i = 0; i<4; i++){
             if(!data[i])
                 return false;
         }
         return true;
     }
-    bool any() const{
+    constexpr bool any() const{
         for (unsigned int i = 0; i<4; i++){
             if(data[i])
                 return true;
         }
         return false;
     }
-    bool none() const{
+    constexpr bool none() const{
         return !any();
     }
     /***************************************
@@ -247,9 +325,9 @@ class Quat {
      * @brief Custom boolean casting for quaternion. This require the element in the Quat to be able to convert to bool.
      * @return True if and only if all vector elements are True.
      */
-    explicit operator bool() const {
+    explicit constexpr operator bool() const {
         for (unsigned int i = 0; i < 4; i++) {
-            if (!(*this)[i])
+            if (!data[i])
                 return false;
         }
         return true;
@@ -257,104 +335,104 @@ class Quat {
     /**
      * @brief Unary - operator, simply flip all element.
      */
-    friend Quat<T> operator-(const Quat<T> &a) {
+    friend constexpr Quat<T> operator-(const Quat<T> &a) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = -a[i];
+            result.data[i] = -a.data[i];
         }
         return result;
     }
 
-    friend Quat<T> operator+(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<T> operator+(const Quat<T> &a, const Quat<T> &b) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = a[i] + b[i];
+            result.data[i] = a.data[i] + b.data[i];
         }
         return result;
     };
-    friend Quat<T> operator-(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<T> operator-(const Quat<T> &a, const Quat<T> &b) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = a[i] - b[i];
+            result.data[i] = a.data[i] - b.data[i];
         }
         return result;
     }
-    friend Quat<T> operator*(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<T> operator*(const Quat<T> &a, const Quat<T> &b) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = a[i] * b[i];
+            result.data[i] = a.data[i] * b.data[i];
         }
         return result;
     }
-    friend Quat<T> operator*(const Quat<T> &a, const T &b) {
+    friend constexpr Quat<T> operator*(const Quat<T> &a, const T &b) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = a[i] * b;
+            result.data[i] = a.data[i] * b;
         }
         return result;
     }
-    friend Quat<T> operator*(const T &a, const Quat<T> &b) {
+    friend constexpr Quat<T> operator*(const T &a, const Quat<T> &b) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = a * b[i];
+            result.data[i] = a * b.data[i];
         }
         return result;
     }
-    friend Quat<T> operator/(const Quat<T> &a, const T &b) {
+    friend constexpr Quat<T> operator/(const Quat<T> &a, const T &b) {
         return a * (1 / b);
     }
-    friend Quat<T> operator%(const Quat<T> &a, const T &b) {
+    friend constexpr Quat<T> operator%(const Quat<T> &a, const T &b) {
         Quat<T> result{};
         for (unsigned int i = 0; i < 4; i++) {
-            result[i] = a[i] % b;
+            result.data[i] = a.data[i] % b;
         }
         return result;
     }
-    Quat<T> &operator+=(const Quat<T> &other) {
+    constexpr Quat<T> &operator+=(const Quat<T> &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] += other[i];
+            data[i] += other.data[i];
         }
         return *this;
     };
-    Quat<T> &operator-=(const Quat<T> &other) {
+    constexpr Quat<T> &operator-=(const Quat<T> &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] -= other[i];
+            data[i] -= other.data[i];
         }
         return *this;
     };
-    Quat<T> &operator*=(const Quat<T> &other) {
+    constexpr Quat<T> &operator*=(const Quat<T> &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] *= other[i];
+            data[i] *= other.data[i];
         }
         return *this;
     };
-    Quat<T> &operator*=(const T &other) {
+    constexpr Quat<T> &operator*=(const T &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] *= other;
+            data[i] *= other;
         }
         return *this;
     };
-    Quat<T> &operator/=(const Quat<T> &other) {
+    constexpr Quat<T> &operator/=(const Quat<T> &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] /= other[i];
+            data[i] /= other.data[i];
         }
         return *this;
     };
-    Quat<T> &operator/=(const T &other) {
+    constexpr Quat<T> &operator/=(const T &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] /= other;
+            data[i] /= other;
         }
         return *this;
     };
-    Quat<T> &operator%=(const Quat<T> &other) {
+    constexpr Quat<T> &operator%=(const Quat<T> &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] %= other[i];
+            data[i] %= other.data[i];
         }
         return *this;
     };
-    Quat<T> &operator%=(const T &other) {
+    constexpr Quat<T> &operator%=(const T &other) {
         for (unsigned int i = 0; i < 4; i++) {
-            (*this)[i] %= other;
+            data[i] %= other;
         }
         return *this;
     };
@@ -362,52 +440,52 @@ class Quat {
     /***************************************
             Relational Operators
     ****************************************/
-    friend Quat<unsigned int> operator==(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<unsigned int> operator==(const Quat<T> &a, const Quat<T> &b) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i] == b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] == b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Quat<unsigned int> operator!=(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<unsigned int> operator!=(const Quat<T> &a, const Quat<T> &b) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i] != b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] != b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Quat<unsigned int> operator<(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<unsigned int> operator<(const Quat<T> &a, const Quat<T> &b) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i] < b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] < b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Quat<unsigned int> operator>(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<unsigned int> operator>(const Quat<T> &a, const Quat<T> &b) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i] > b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] > b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Quat<unsigned int> operator<=(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<unsigned int> operator<=(const Quat<T> &a, const Quat<T> &b) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i] <= b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] <= b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Quat<unsigned int> operator>=(const Quat<T> &a, const Quat<T> &b) {
+    friend constexpr Quat<unsigned int> operator>=(const Quat<T> &a, const Quat<T> &b) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i] >= b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] >= b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Quat<unsigned int> operator!(const Quat<T> &a) {
+    friend constexpr Quat<unsigned int> operator!(const Quat<T> &a) {
         Quat<unsigned int> result{};
         for (unsigned int i = 0; i <4; i++) {
-            result[i] = (a[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i]) ? 1 : 0;
         }
         return result;
     }
@@ -416,11 +494,82 @@ class Quat {
         return o;
     }
 };
-template<class T>
-Quat<T> slerp(const Quat<T> &a, const Quat<T> &b, const T& t){
+/**
+ * @brief Normalized linear interpolation along the shortest path.
+ */
+template <class T>
+constexpr Quat<T> nlerp(const Quat<T> &a, const Quat<T> &b, const T &t) {
+    const Quat<T> end = (a.dot(b) < 0) ? -b : b;
+    return (a * (1 - t) + end * t).normalize_or_one();
+}
+/**
+ * @brief nlerp with t corrected by fast::onlerp_t, close to slerp at the
+ * cost of nlerp.
+ */
+template <class T>
+constexpr Quat<T> onlerp(const Quat<T> &a, const Quat<T> &b, const T &t) {
+    const T d = a.dot(b);
+    const T corrected = fast::onlerp_t(d < 0 ? -d : d, t);
+    const Quat<T> end = (d < 0) ? -b : b;
+    return (a * (1 - corrected) + end * corrected).normalize_or_one();
+}
+/**
+ * @brief Spherical linear interpolation of unit quaternions along the
+ * shortest path.
+ */
+template <class T>
+constexpr Quat<T> slerp(const Quat<T> &a, const Quat<T> &b, const T &t) {
     using namespace std;
-    const T angle = acos(a.dot(b));
-    return a*(sin((1-t)*angle)/sin(angle))+b*(sin(t*angle)/sin(angle));
+    T d = a.dot(b);
+    const Quat<T> end = (d < 0) ? -b : b;
+    d = (d < 0) ? -d : d;
+    if (d > static_cast<T>(fast::slerp_threshold)) {
+        return (a * (1 - t) + end * t).normalize_or_one();
+    }
+    const T angle = acos(d);
+    const T s = sin(angle);
+    return a * (sin((1 - t) * angle) / s) + end * (sin(t * angle) / s);
+}
+
+namespace fast {
+/**
+ * @brief quat scaled by fast::rsqrt of its squared length, no zero check.
+ */
+template <std::floating_point T> constexpr Quat<T> normalize(const Quat<T> &quat) {
+    return quat * fast::rsqrt(quat.dot(quat));
+}
+/**
+ * @brief smath::slerp through fast::acos, fast::sin and fast::rsqrt, within
+ * a few ulp of it for unit quaternions.
+ */
+template <std::floating_point T>
+constexpr Quat<T> slerp(const Quat<T> &a, const Quat<T> &b, const T &t) {
+    T d = a.dot(b);
+    const Quat<T> end = (d < 0) ? -b : b;
+    d = (d < 0) ? -d : d;
+    if (d > static_cast<T>(slerp_threshold)) {
+        return fast::normalize(a * (1 - t) + end * t);
+    }
+    const T angle = fast::acos(d);
+    const T inverse_sin = fast::rsqrt((1 - d) * (1 + d));
+    return a * (fast::sin((1 - t) * angle) * inverse_sin) +
+           end * (fast::sin(t * angle) * inverse_sin);
 }
+} // namespace fast
+
+namespace detail {
+template <class Q> struct quat_scalar {};
+template <class T> struct quat_scalar<Quat<T>> {
+    using type = T;
+};
+template <class R>
+using quat_scalar_t = typename quat_scalar<std::ranges::range_value_t<R>>::type;
+} // namespace detail
+/**
+ * @brief Contiguous range of Quat, e.g. std::vector<Quat<float>> or a span.
+ */
+template <class R>
+concept QuatRange = std::ranges::contiguous_range<R> &&
+                    requires { typename detail::quat_scalar_t<R>; };
 } // namespace smath
 #endif
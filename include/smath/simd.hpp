@@ -0,0 +1,1796 @@
+#ifndef SMATH_SIMD_HPP
+#define SMATH_SIMD_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "fast.hpp"
+#if defined(SMATH_SSE)
+#include <immintrin.h>
+#endif
+
+namespace smath::simd {
+/*
+    Register-backed kernels for the hot vector sizes:
+    Vec<4,float>, Vec<3,float> -> one __m128
+    Vec<4,double>, Vec<3,double> -> one __m256d (AVX only)
+    Vec3 is padded to four lanes inside the register. The fourth lane is
+    loaded as zero so horizontal sums stay exact, and it is never stored back.
+*/
+template <unsigned int N, class T> struct Kernel {
+    static constexpr bool enabled = false;
+    static constexpr bool has_cross = false;
+    static constexpr bool has_shuffle = false;
+};
+
+#if defined(SMATH_SSE)
+template <unsigned int N>
+    requires(N == 3 || N == 4)
+struct Kernel<N, float> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_cross = true;
+    static constexpr bool has_shuffle = true;
+    using Register = __m128;
+
+    static Register load(const float *p) {
+        if constexpr (N == 4) {
+            return _mm_loadu_ps(p);
+        } else {
+            const __m128 low =
+                _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(p));
+            return _mm_movelh_ps(low, _mm_load_ss(p + 2));
+        }
+    }
+    static void store(float *p, Register r) {
+        if constexpr (N == 4) {
+            _mm_storeu_ps(p, r);
+        } else {
+            _mm_storel_pi(reinterpret_cast<__m64 *>(p), r);
+            _mm_store_ss(p + 2, _mm_movehl_ps(r, r));
+        }
+    }
+    static Register broadcast(float value) { return _mm_set1_ps(value); }
+    static Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+    static Register sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+    static Register mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+    static Register div(Register a, Register b) { return _mm_div_ps(a, b); }
+    static Register neg(Register a) {
+        return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+    }
+    /**
+     * @brief Lane k of the result is lane (imm >> 2k) & 3 of a.
+     */
+    template <int imm> static Register shuffle(Register a) {
+        return _mm_shuffle_ps(a, a, imm);
+    }
+    static float hsum(Register a) {
+        __m128 shuffled = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(a, shuffled);
+        shuffled = _mm_movehl_ps(shuffled, sums);
+        return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+    }
+    /**
+     * @brief a.yzx * b.zxy - a.zxy * b.yzx, the fourth lane ends up zero.
+     */
+    static Register cross(Register a, Register b) {
+        const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+};
+#endif
+
+#if defined(SMATH_AVX)
+template <unsigned int N>
+    requires(N == 3 || N == 4)
+struct Kernel<N, double> {
+    static constexpr bool enabled = true;
+#if defined(SMATH_AVX2)
+    static constexpr bool has_cross = true;
+    // The three lane load is split in two, slower than picking the elements.
+    static constexpr bool has_shuffle = N == 4;
+#else
+    static constexpr bool has_cross = false;
+    static constexpr bool has_shuffle = false;
+#endif
+    using Register = __m256d;
+
+    static Register load(const double *p) {
+        if constexpr (N == 4) {
+            return _mm256_loadu_pd(p);
+        } else {
+            return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p)),
+                                        _mm_load_sd(p + 2), 1);
+        }
+    }
+    static void store(double *p, Register r) {
+        if constexpr (N == 4) {
+            _mm256_storeu_pd(p, r);
+        } else {
+            _mm_storeu_pd(p, _mm256_castpd256_pd128(r));
+            _mm_store_sd(p + 2, _mm256_extractf128_pd(r, 1));
+        }
+    }
+    static Register broadcast(double value) { return _mm256_set1_pd(value); }
+    static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+    static Register sub(Register a, Register b) { return _mm256_sub_pd(a, b); }
+    static Register mul(Register a, Register b) { return _mm256_mul_pd(a, b); }
+    static Register div(Register a, Register b) { return _mm256_div_pd(a, b); }
+    static Register neg(Register a) {
+        return _mm256_xor_pd(a, _mm256_set1_pd(-0.0));
+    }
+    static double hsum(Register a) {
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(a),
+                                        _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+#if defined(SMATH_AVX2)
+    static Register cross(Register a, Register b) {
+        const __m256d a_yzx = _mm256_permute4x64_pd(a, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m256d b_yzx = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m256d c =
+            _mm256_sub_pd(_mm256_mul_pd(a, b_yzx), _mm256_mul_pd(a_yzx, b));
+        return _mm256_permute4x64_pd(c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+    template <int imm> static Register shuffle(Register a) {
+        return _mm256_permute4x64_pd(a, imm);
+    }
+#endif
+};
+#endif
+
+template <unsigned int N, class T>
+constexpr bool accelerated = Kernel<N, T>::enabled;
+
+/**
+ * @brief Swizzles from a register-backed size into a four lane one, done as
+ * a single shuffle. Three lane results are left to the element copies: the
+ * compiler already builds them with inserts, where the shuffle would pay for
+ * a split store.
+ */
+template <unsigned int N, unsigned int M, class T>
+constexpr bool shuffle_accelerated =
+    M == 4 && Kernel<N, T>::has_shuffle && Kernel<M, T>::has_shuffle;
+/**
+ * @brief out[k] = in[I_k], the indices known at compile time.
+ */
+template <unsigned int N, class T, unsigned int... I>
+    requires(shuffle_accelerated<N, sizeof...(I), T>)
+inline void swizzle(const T *in, T *out) {
+    constexpr unsigned int picked[] = {I...};
+    constexpr int imm =
+        static_cast<int>(picked[0] | picked[1] << 2 | picked[2] << 4 | picked[3] << 6);
+    Kernel<4, T>::store(out, Kernel<N, T>::template shuffle<imm>(Kernel<N, T>::load(in)));
+}
+
+/***************************************
+        Array kernels
+***************************************/
+template <unsigned int N, class T>
+inline void add(const T *a, const T *b, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::add(K::load(a), K::load(b)));
+}
+template <unsigned int N, class T>
+inline void sub(const T *a, const T *b, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::sub(K::load(a), K::load(b)));
+}
+template <unsigned int N, class T>
+inline void mul(const T *a, const T *b, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::mul(K::load(a), K::load(b)));
+}
+template <unsigned int N, class T>
+inline void div(const T *a, const T *b, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::div(K::load(a), K::load(b)));
+}
+template <unsigned int N, class T>
+inline void scale(const T *a, const T &s, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::mul(K::load(a), K::broadcast(s)));
+}
+template <unsigned int N, class T>
+inline void div_scalar(const T *a, const T &s, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::div(K::load(a), K::broadcast(s)));
+}
+template <unsigned int N, class T> inline void neg(const T *a, T *out) {
+    using K = Kernel<N, T>;
+    K::store(out, K::neg(K::load(a)));
+}
+template <unsigned int N, class T> inline T dot(const T *a, const T *b) {
+    using K = Kernel<N, T>;
+    return K::hsum(K::mul(K::load(a), K::load(b)));
+}
+template <class T> inline void cross(const T *a, const T *b, T *out) {
+    using K = Kernel<3, T>;
+    K::store(out, K::cross(K::load(a), K::load(b)));
+}
+
+/***************************************
+        Matrix kernels
+***************************************/
+#if defined(SMATH_SSE)
+namespace detail {
+/**
+ * @brief Signed cofactor terms for the 4x4 inverse. p holds the six 2x2
+ * determinants of a pair of rows x, y; for a row a the result is
+ * (+,-,+,-) * (a.yxxx * p.5543 - a.zzyy * p.4221 + a.wwwz * p.3100)
+ */
+inline __m128 cofactor4(__m128 a, __m128 x, __m128 y) {
+    const __m128 x_1000 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 1));
+    const __m128 y_1000 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(0, 0, 0, 1));
+    const __m128 x_2211 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 y_2211 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 x_3332 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 3, 3));
+    const __m128 y_3332 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 3, 3, 3));
+    // (p5, p5, p4, p3), (p4, p2, p2, p1), (p3, p1, p0, p0)
+    const __m128 p_5543 = _mm_sub_ps(_mm_mul_ps(x_2211, y_3332),
+                                     _mm_mul_ps(x_3332, y_2211));
+    const __m128 p_4221 = _mm_sub_ps(_mm_mul_ps(x_1000, y_3332),
+                                     _mm_mul_ps(x_3332, y_1000));
+    const __m128 p_3100 = _mm_sub_ps(_mm_mul_ps(x_1000, y_2211),
+                                     _mm_mul_ps(x_2211, y_1000));
+    const __m128 a_1000 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 1));
+    const __m128 a_2211 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 a_3332 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 3, 3));
+    const __m128 sum = _mm_add_ps(
+        _mm_sub_ps(_mm_mul_ps(a_1000, p_5543), _mm_mul_ps(a_2211, p_4221)),
+        _mm_mul_ps(a_3332, p_3100));
+    return _mm_xor_ps(sum, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+}
+} // namespace detail
+
+/**
+ * @brief Inverse of a column major 4x4 float matrix by cofactors, the 2x2
+ * determinants of row 0/1 and row 2/3 are shared by all 16 entries.
+ */
+inline void inverse4(const float *in, float *out) {
+    __m128 r0 = _mm_loadu_ps(in);
+    __m128 r1 = _mm_loadu_ps(in + 4);
+    __m128 r2 = _mm_loadu_ps(in + 8);
+    __m128 r3 = _mm_loadu_ps(in + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    const __m128 c0 = detail::cofactor4(r1, r2, r3);
+    const __m128 c1 = _mm_xor_ps(detail::cofactor4(r0, r2, r3), _mm_set1_ps(-0.0f));
+    const __m128 c2 = detail::cofactor4(r3, r0, r1);
+    const __m128 c3 = _mm_xor_ps(detail::cofactor4(r2, r0, r1), _mm_set1_ps(-0.0f));
+    // Laplace expansion along row 0 against the first adjugate column.
+    const float det = Kernel<4, float>::hsum(_mm_mul_ps(r0, c0));
+    const __m128 inv_det = _mm_set1_ps(1.0f / det);
+    _mm_storeu_ps(out, _mm_mul_ps(c0, inv_det));
+    _mm_storeu_ps(out + 4, _mm_mul_ps(c1, inv_det));
+    _mm_storeu_ps(out + 8, _mm_mul_ps(c2, inv_det));
+    _mm_storeu_ps(out + 12, _mm_mul_ps(c3, inv_det));
+}
+#endif
+
+/**
+ * @brief Column major 4x4 product C = A * B. Column k of C is the columns
+ * of A weighted by the four entries of column k of B, each column of A is
+ * one register.
+ */
+template <class T>
+    requires(accelerated<4, T>)
+inline void mul4x4(const T *a, const T *b, T *c) {
+    using K = Kernel<4, T>;
+    const typename K::Register a0 = K::load(a);
+    const typename K::Register a1 = K::load(a + 4);
+    const typename K::Register a2 = K::load(a + 8);
+    const typename K::Register a3 = K::load(a + 12);
+    for (unsigned int k = 0; k < 4; k++) {
+        const T *column = b + 4 * k;
+        const typename K::Register low =
+            K::add(K::mul(a0, K::broadcast(column[0])),
+                   K::mul(a1, K::broadcast(column[1])));
+        const typename K::Register high =
+            K::add(K::mul(a2, K::broadcast(column[2])),
+                   K::mul(a3, K::broadcast(column[3])));
+        K::store(c + 4 * k, K::add(low, high));
+    }
+}
+/**
+ * @brief Column major 4x4 matrix times a 4 element vector.
+ */
+template <class T>
+    requires(accelerated<4, T>)
+inline void mul4x4_vec(const T *a, const T *v, T *out) {
+    using K = Kernel<4, T>;
+    const typename K::Register low =
+        K::add(K::mul(K::load(a), K::broadcast(v[0])),
+               K::mul(K::load(a + 4), K::broadcast(v[1])));
+    const typename K::Register high =
+        K::add(K::mul(K::load(a + 8), K::broadcast(v[2])),
+               K::mul(K::load(a + 12), K::broadcast(v[3])));
+    K::store(out, K::add(low, high));
+}
+
+/*
+    Full width registers for the matrix multiply micro-kernel.
+    Wide<float> -> __m256 (8 lanes), Wide<double> -> __m256d (4 lanes)
+*/
+template <class T> struct Wide {
+    static constexpr bool enabled = false;
+    static constexpr unsigned int width = 1;
+};
+#if defined(SMATH_AVX)
+template <> struct Wide<float> {
+    static constexpr bool enabled = true;
+    static constexpr unsigned int width = 8;
+    using Register = __m256;
+
+    static Register zero() { return _mm256_setzero_ps(); }
+    static Register load(const float *p) { return _mm256_loadu_ps(p); }
+    static void store(float *p, Register r) { _mm256_storeu_ps(p, r); }
+    static Register broadcast(float value) { return _mm256_set1_ps(value); }
+    static Register add(Register a, Register b) { return _mm256_add_ps(a, b); }
+    static Register sub(Register a, Register b) { return _mm256_sub_ps(a, b); }
+    static Register mul(Register a, Register b) { return _mm256_mul_ps(a, b); }
+    static Register div(Register a, Register b) { return _mm256_div_ps(a, b); }
+    static Register sqrt(Register a) { return _mm256_sqrt_ps(a); }
+    // The rsqrtps estimate and one Newton step, as fast::rsqrt.
+    static Register rsqrt(Register a) {
+        const Register y = _mm256_rsqrt_ps(a);
+        const Register half_a = _mm256_mul_ps(_mm256_set1_ps(0.5f), a);
+        const Register ayy = _mm256_mul_ps(_mm256_mul_ps(half_a, y), y);
+        return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), ayy));
+    }
+    static Register round(Register a) {
+        return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static Register floor(Register a) { return _mm256_floor_ps(a); }
+    static Register min(Register a, Register b) { return _mm256_min_ps(a, b); }
+    static Register max(Register a, Register b) { return _mm256_max_ps(a, b); }
+    static Register abs(Register a) {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+    }
+    // a with its sign flipped wherever sign is negative.
+    static Register flip_sign(Register a, Register sign) {
+        return _mm256_xor_ps(a, _mm256_and_ps(sign, _mm256_set1_ps(-0.0f)));
+    }
+    // All bits set where a > b, for select.
+    static Register greater(Register a, Register b) {
+        return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+    }
+    static Register select(Register mask, Register if_true, Register if_false) {
+        return _mm256_blendv_ps(if_false, if_true, mask);
+    }
+    static Register mask_and(Register a, Register b) { return _mm256_and_ps(a, b); }
+    static Register mask_or(Register a, Register b) { return _mm256_or_ps(a, b); }
+    // Lanes holding small non-negative integers, stored as 8 bytes.
+    static void store_bytes(std::uint8_t *p, Register r) {
+        const __m256i words = _mm256_cvttps_epi32(r);
+        const __m128i halves = _mm_packs_epi32(_mm256_castsi256_si128(words),
+                                               _mm256_extractf128_si256(words, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(p), _mm_packus_epi16(halves, halves));
+    }
+#if defined(SMATH_AVX2)
+    // Eight 32-bit element indices, one per lane.
+    using Index = __m256i;
+    static Index load_index(const std::uint32_t *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+    template <int Shift> static Index shift_index(Index i) {
+        return _mm256_slli_epi32(i, Shift);
+    }
+    static Register gather(const float *base, Index i) {
+        return _mm256_i32gather_ps(base, i, 4);
+    }
+#endif
+    static Register fmadd(Register a, Register b, Register c) {
+#if defined(SMATH_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+};
+template <> struct Wide<double> {
+    static constexpr bool enabled = true;
+    static constexpr unsigned int width = 4;
+    using Register = __m256d;
+
+    static Register zero() { return _mm256_setzero_pd(); }
+    static Register load(const double *p) { return _mm256_loadu_pd(p); }
+    static void store(double *p, Register r) { _mm256_storeu_pd(p, r); }
+    static Register broadcast(double value) { return _mm256_set1_pd(value); }
+    static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+    static Register sub(Register a, Register b) { return _mm256_sub_pd(a, b); }
+    static Register mul(Register a, Register b) { return _mm256_mul_pd(a, b); }
+    static Register div(Register a, Register b) { return _mm256_div_pd(a, b); }
+    static Register sqrt(Register a) { return _mm256_sqrt_pd(a); }
+    static Register rsqrt(Register a) {
+        return _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(a));
+    }
+    static Register round(Register a) {
+        return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static Register floor(Register a) { return _mm256_floor_pd(a); }
+    static Register min(Register a, Register b) { return _mm256_min_pd(a, b); }
+    static Register max(Register a, Register b) { return _mm256_max_pd(a, b); }
+    static Register abs(Register a) {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+    }
+    // a with its sign flipped wherever sign is negative.
+    static Register flip_sign(Register a, Register sign) {
+        return _mm256_xor_pd(a, _mm256_and_pd(sign, _mm256_set1_pd(-0.0)));
+    }
+    // All bits set where a > b, for select.
+    static Register greater(Register a, Register b) {
+        return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+    }
+    static Register select(Register mask, Register if_true, Register if_false) {
+        return _mm256_blendv_pd(if_false, if_true, mask);
+    }
+    static Register mask_and(Register a, Register b) { return _mm256_and_pd(a, b); }
+    static Register mask_or(Register a, Register b) { return _mm256_or_pd(a, b); }
+    // Lanes holding small non-negative integers, stored as 4 bytes.
+    static void store_bytes(std::uint8_t *p, Register r) {
+        const __m128i words = _mm256_cvttpd_epi32(r);
+        const __m128i halves = _mm_packs_epi32(words, words);
+        const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(halves, halves));
+        std::memcpy(p, &bytes, 4);
+    }
+#if defined(SMATH_AVX2)
+    // Four 32-bit element indices, one per lane.
+    using Index = __m128i;
+    static Index load_index(const std::uint32_t *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    }
+    template <int Shift> static Index shift_index(Index i) {
+        return _mm_slli_epi32(i, Shift);
+    }
+    // Masked form with a zeroed source: the plain intrinsic starts from
+    // _mm256_undefined_pd, which GCC 12 reports as maybe-uninitialized.
+    static Register gather(const double *base, Index i) {
+        const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, i, all, 8);
+    }
+#endif
+    static Register fmadd(Register a, Register b, Register c) {
+#if defined(SMATH_FMA)
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+};
+#endif
+
+/**
+ * @brief Whether gemm<M,N,K,T> runs the register-blocked kernel. Below one
+ * register of rows, or for thin operands, the plain loop is as fast.
+ */
+template <unsigned int M, unsigned int N, unsigned int K, class T>
+constexpr bool gemm_accelerated =
+    Wide<T>::enabled && M >= Wide<T>::width && N >= 4 && K >= 4;
+
+#if defined(SMATH_AVX)
+namespace detail {
+/**
+ * @brief C[MV*width x KR] = A[MV*width x N] * B[N x KR], all column major
+ * with leading dimensions M (A, C) and N (B). The MV*KR accumulators are
+ * unrolled through index sequences so they stay in registers.
+ */
+template <unsigned int MV, unsigned int KR, unsigned int M, unsigned int N,
+          class T>
+inline void gemm_block(const T *a, const T *b, T *c) {
+    using W = Wide<T>;
+    using Register = typename W::Register;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        Register acc[KR * MV] = {((void)I, W::zero())...};
+        for (unsigned int n = 0; n < N; n++) {
+            Register column[MV];
+            for (unsigned int v = 0; v < MV; v++) {
+                column[v] = W::load(a + n * M + v * W::width);
+            }
+            ((acc[I] = W::fmadd(column[I % MV], W::broadcast(b[(I / MV) * N + n]),
+                                acc[I])),
+             ...);
+        }
+        (W::store(c + (I / MV) * M + (I % MV) * W::width, acc[I]), ...);
+    }(std::make_index_sequence<KR * MV>{});
+}
+/**
+ * @brief All M rows of KR columns of C: blocks of two registers, then one
+ * register, then scalar rows for what does not fill a register.
+ */
+template <unsigned int KR, unsigned int M, unsigned int N, class T>
+inline void gemm_panel(const T *a, const T *b, T *c) {
+    constexpr unsigned int width = Wide<T>::width;
+    constexpr unsigned int rows = 2 * width;
+    constexpr unsigned int full = M - M % rows;
+    for (unsigned int m = 0; m < full; m += rows) {
+        gemm_block<2, KR, M, N>(a + m, b, c + m);
+    }
+    if constexpr (M % rows >= width) {
+        gemm_block<1, KR, M, N>(a + full, b, c + full);
+    }
+    for (unsigned int k = 0; k < KR; k++) {
+        for (unsigned int m = M - M % width; m < M; m++) {
+            T sum = 0;
+            for (unsigned int n = 0; n < N; n++) {
+                sum += a[n * M + m] * b[k * N + n];
+            }
+            c[k * M + m] = sum;
+        }
+    }
+}
+} // namespace detail
+#endif
+
+/**
+ * @brief Split n packed xyz triples into three component arrays.
+ */
+template <class T>
+inline void deinterleave3(const T *in, T *x, T *y, T *z, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+        for (; i + 4 <= n; i += 4) {
+            const __m128 a = _mm_loadu_ps(in + 3 * i);
+            const __m128 b = _mm_loadu_ps(in + 3 * i + 4);
+            const __m128 c = _mm_loadu_ps(in + 3 * i + 8);
+            const __m128 x2y2x3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+            const __m128 y0z0y1z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+            _mm_storeu_ps(x + i, _mm_shuffle_ps(a, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0)));
+            _mm_storeu_ps(y + i,
+                          _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_ps(z + i, _mm_shuffle_ps(y0z0y1z1, c, _MM_SHUFFLE(3, 0, 3, 1)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        x[i] = in[3 * i];
+        y[i] = in[3 * i + 1];
+        z[i] = in[3 * i + 2];
+    }
+}
+/**
+ * @brief Pack three component arrays back into n xyz triples.
+ */
+template <class T>
+inline void interleave3(const T *x, const T *y, const T *z, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        for (; i + 4 <= n; i += 4) {
+            const __m128 vx = _mm_loadu_ps(x + i);
+            const __m128 vy = _mm_loadu_ps(y + i);
+            const __m128 vz = _mm_loadu_ps(z + i);
+            const __m128 x0x2y0y2 = _mm_shuffle_ps(vx, vy, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 z0z2x1x3 = _mm_shuffle_ps(vz, vx, _MM_SHUFFLE(3, 1, 2, 0));
+            const __m128 y1y3z1z3 = _mm_shuffle_ps(vy, vz, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(out + 3 * i,
+                          _mm_shuffle_ps(x0x2y0y2, z0z2x1x3, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(out + 3 * i + 4,
+                          _mm_shuffle_ps(y1y3z1z3, x0x2y0y2, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_ps(out + 3 * i + 8,
+                          _mm_shuffle_ps(z0z2x1x3, y1y3z1z3, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[3 * i] = x[i];
+        out[3 * i + 1] = y[i];
+        out[3 * i + 2] = z[i];
+    }
+}
+
+/**
+ * @brief Split n packed 4-tuples (quaternions wxyz) into four arrays.
+ */
+template <class T>
+inline void deinterleave4(const T *in, T *w, T *x, T *y, T *z, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        for (; i + 4 <= n; i += 4) {
+            __m128 a = _mm_loadu_ps(in + 4 * i);
+            __m128 b = _mm_loadu_ps(in + 4 * i + 4);
+            __m128 c = _mm_loadu_ps(in + 4 * i + 8);
+            __m128 d = _mm_loadu_ps(in + 4 * i + 12);
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            _mm_storeu_ps(w + i, a);
+            _mm_storeu_ps(x + i, b);
+            _mm_storeu_ps(y + i, c);
+            _mm_storeu_ps(z + i, d);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        w[i] = in[4 * i];
+        x[i] = in[4 * i + 1];
+        y[i] = in[4 * i + 2];
+        z[i] = in[4 * i + 3];
+    }
+}
+
+/**
+ * @brief Pack four component arrays back into n 4-tuples.
+ */
+template <class T>
+inline void interleave4(const T *w, const T *x, const T *y, const T *z, T *out,
+                        std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        for (; i + 4 <= n; i += 4) {
+            __m128 a = _mm_loadu_ps(w + i);
+            __m128 b = _mm_loadu_ps(x + i);
+            __m128 c = _mm_loadu_ps(y + i);
+            __m128 d = _mm_loadu_ps(z + i);
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            _mm_storeu_ps(out + 4 * i, a);
+            _mm_storeu_ps(out + 4 * i + 4, b);
+            _mm_storeu_ps(out + 4 * i + 8, c);
+            _mm_storeu_ps(out + 4 * i + 12, d);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[4 * i] = w[i];
+        out[4 * i + 1] = x[i];
+        out[4 * i + 2] = y[i];
+        out[4 * i + 3] = z[i];
+    }
+}
+
+/**
+ * @brief SoA rotation of n 3D elements, each by its own unit quaternion
+ * (qw, qx, qy, qz) with t = 2 (u x v), v' = v + w t + u x t. The outputs
+ * may alias the inputs.
+ */
+template <class T>
+inline void rotate3(const T *qw, const T *qx, const T *qy, const T *qz,
+                    const T *x, const T *y, const T *z, T *ox, T *oy, T *oz,
+                    std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        for (; i + W::width <= n; i += W::width) {
+            const Register w = W::load(qw + i);
+            const Register ux = W::load(qx + i);
+            const Register uy = W::load(qy + i);
+            const Register uz = W::load(qz + i);
+            const Register vx = W::load(x + i);
+            const Register vy = W::load(y + i);
+            const Register vz = W::load(z + i);
+            const Register tx = W::sub(W::mul(uy, vz), W::mul(uz, vy));
+            const Register ty = W::sub(W::mul(uz, vx), W::mul(ux, vz));
+            const Register tz = W::sub(W::mul(ux, vy), W::mul(uy, vx));
+            const Register sx = W::add(tx, tx);
+            const Register sy = W::add(ty, ty);
+            const Register sz = W::add(tz, tz);
+            W::store(ox + i, W::add(W::fmadd(w, sx, vx),
+                                    W::sub(W::mul(uy, sz), W::mul(uz, sy))));
+            W::store(oy + i, W::add(W::fmadd(w, sy, vy),
+                                    W::sub(W::mul(uz, sx), W::mul(ux, sz))));
+            W::store(oz + i, W::add(W::fmadd(w, sz, vz),
+                                    W::sub(W::mul(ux, sy), W::mul(uy, sx))));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        const T vx = x[i];
+        const T vy = y[i];
+        const T vz = z[i];
+        const T tx = 2 * (qy[i] * vz - qz[i] * vy);
+        const T ty = 2 * (qz[i] * vx - qx[i] * vz);
+        const T tz = 2 * (qx[i] * vy - qy[i] * vx);
+        ox[i] = vx + qw[i] * tx + (qy[i] * tz - qz[i] * ty);
+        oy[i] = vy + qw[i] * ty + (qz[i] * tx - qx[i] * tz);
+        oz[i] = vz + qw[i] * tz + (qx[i] * ty - qy[i] * tx);
+    }
+}
+
+/**
+ * @brief SoA transform of n 3D elements by a column major 4x4 matrix, the
+ * missing fourth component is w (1 for points, 0 for directions). With
+ * Project every result is divided by its own w. Elements are loaded before
+ * they are stored, so the outputs may alias the inputs.
+ */
+template <bool Project, class T>
+inline void transform3(const T *m, T w, const T *x, const T *y, const T *z,
+                       T *ox, T *oy, T *oz, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        Register c[16];
+        for (unsigned int k = 0; k < 12; k++) {
+            c[k] = W::broadcast(m[k]);
+        }
+        for (unsigned int k = 12; k < 16; k++) {
+            c[k] = W::broadcast(m[k] * w);
+        }
+        for (; i + W::width <= n; i += W::width) {
+            const Register vx = W::load(x + i);
+            const Register vy = W::load(y + i);
+            const Register vz = W::load(z + i);
+            Register rx = W::fmadd(
+                c[0], vx, W::fmadd(c[4], vy, W::fmadd(c[8], vz, c[12])));
+            Register ry = W::fmadd(
+                c[1], vx, W::fmadd(c[5], vy, W::fmadd(c[9], vz, c[13])));
+            Register rz = W::fmadd(
+                c[2], vx, W::fmadd(c[6], vy, W::fmadd(c[10], vz, c[14])));
+            if constexpr (Project) {
+                const Register rw = W::fmadd(
+                    c[3], vx, W::fmadd(c[7], vy, W::fmadd(c[11], vz, c[15])));
+                rx = W::div(rx, rw);
+                ry = W::div(ry, rw);
+                rz = W::div(rz, rw);
+            }
+            W::store(ox + i, rx);
+            W::store(oy + i, ry);
+            W::store(oz + i, rz);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        const T vx = x[i];
+        const T vy = y[i];
+        const T vz = z[i];
+        T rx = m[0] * vx + m[4] * vy + m[8] * vz + m[12] * w;
+        T ry = m[1] * vx + m[5] * vy + m[9] * vz + m[13] * w;
+        T rz = m[2] * vx + m[6] * vy + m[10] * vz + m[14] * w;
+        if constexpr (Project) {
+            const T rw = m[3] * vx + m[7] * vy + m[11] * vz + m[15] * w;
+            rx /= rw;
+            ry /= rw;
+            rz /= rw;
+        }
+        ox[i] = rx;
+        oy[i] = ry;
+        oz[i] = rz;
+    }
+}
+/**
+ * @brief transform3 over n padded elements (x, y, z, 0), four T apart and
+ * aligned to 4 * sizeof(T): each one is a single register load, no
+ * staging. The pad lane of out is written as zero; outputs may alias the
+ * inputs.
+ */
+template <bool Project, class T>
+inline void transform_padded(const T *m, T w, const T *in, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (std::is_same_v<T, float>) {
+        // Two elements per register, the columns repeated in both halves.
+        const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m));
+        const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 4));
+        const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 8));
+        const __m256 c3 = _mm256_mul_ps(
+            _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m + 12)), _mm256_set1_ps(w));
+        for (; i + 2 <= n; i += 2) {
+            const __m256 v = _mm256_loadu_ps(in + 4 * i);
+            __m256 r = Wide<float>::fmadd(
+                c2, _mm256_permute_ps(v, 0xAA),
+                Wide<float>::fmadd(c1, _mm256_permute_ps(v, 0x55),
+                                   Wide<float>::fmadd(c0, _mm256_permute_ps(v, 0x00), c3)));
+            if constexpr (Project) {
+                r = _mm256_div_ps(r, _mm256_permute_ps(r, 0xFF));
+            }
+            _mm256_storeu_ps(out + 4 * i, _mm256_blend_ps(r, _mm256_setzero_ps(), 0x88));
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        const __m256d c0 = _mm256_loadu_pd(m);
+        const __m256d c1 = _mm256_loadu_pd(m + 4);
+        const __m256d c2 = _mm256_loadu_pd(m + 8);
+        const __m256d c3 = _mm256_mul_pd(_mm256_loadu_pd(m + 12), _mm256_set1_pd(w));
+        for (; i < n; i++) {
+            const double *v = in + 4 * i;
+            __m256d r = Wide<double>::fmadd(
+                c2, _mm256_broadcast_sd(v + 2),
+                Wide<double>::fmadd(c1, _mm256_broadcast_sd(v + 1),
+                                    Wide<double>::fmadd(c0, _mm256_broadcast_sd(v), c3)));
+            if constexpr (Project) {
+                // w of the upper half into every lane, AVX without AVX2.
+                const __m256d high = _mm256_permute2f128_pd(r, r, 0x11);
+                r = _mm256_div_pd(r, _mm256_permute_pd(high, 0xF));
+            }
+            _mm256_store_pd(out + 4 * i, _mm256_blend_pd(r, _mm256_setzero_pd(), 0x8));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        const T *v = in + 4 * i;
+        T r[4];
+        for (unsigned int row = 0; row < 4; row++) {
+            r[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row] * w;
+        }
+        for (unsigned int row = 0; row < 3; row++) {
+            out[4 * i + row] = Project ? r[row] / r[3] : r[row];
+        }
+        out[4 * i + 3] = 0;
+    }
+}
+
+#if defined(SMATH_AVX)
+namespace detail {
+/**
+ * @brief Polynomial with the given coefficients (lowest first) evaluated
+ * on a whole register.
+ */
+template <class W, unsigned int K>
+inline typename W::Register horner(typename W::Register x,
+                                   const double (&coefficients)[K]) {
+    typename W::Register result = W::broadcast(coefficients[K - 1]);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((result = W::fmadd(result, x, W::broadcast(coefficients[K - 2 - I]))), ...);
+    }(std::make_index_sequence<K - 1>());
+    return result;
+}
+/**
+ * @brief sin of every lane in [0, pi/2], the slerp weights. Past pi/4 it is
+ * cos(pi/2 - x), where pi/2 - x is exact in the leading part, so no
+ * reduction by multiples of pi/2 is needed.
+ */
+template <class T>
+inline typename Wide<T>::Register sin_first_quadrant(typename Wide<T>::Register x) {
+    using W = Wide<T>;
+    using Register = typename W::Register;
+    using Tables = fast::detail::Tables<T>;
+    const Register upper = W::greater(x, W::broadcast(std::numbers::pi / 4));
+    Register flipped = W::sub(W::zero(), x);
+    for (const double part : Tables::half_pi) {
+        flipped = W::add(flipped, W::broadcast(part));
+    }
+    const Register r = W::select(upper, flipped, x);
+    const Register z = W::mul(r, r);
+    return W::select(upper, horner<W>(z, Tables::cos), W::mul(r, horner<W>(z, Tables::sin)));
+}
+} // namespace detail
+#endif
+
+enum class Blend { nlerp, onlerp, slerp };
+/**
+ * @brief Weights of a and of the shortest-path b for one quaternion blend,
+ * given d = |a.dot(b)|. The scalar twin of the register path in blend4.
+ */
+template <Blend Mode, class T>
+inline void blend_weights(T d, T t, T &wa, T &wb) {
+    if constexpr (Mode == Blend::onlerp) {
+        t = fast::onlerp_t(d, t);
+    }
+    wa = 1 - t;
+    wb = t;
+    if constexpr (Mode == Blend::slerp) {
+        if (d <= static_cast<T>(fast::slerp_threshold)) {
+            const T angle = fast::acos(d);
+            const T inverse_sin = 1 / std::sqrt(1 - d * d);
+            wa = fast::sin(wa * angle) * inverse_sin;
+            wb = fast::sin(wb * angle) * inverse_sin;
+        }
+    }
+}
+/**
+ * @brief SoA blend of n quaternion pairs (a, b) at t[i], component arrays
+ * in w x y z order. b is flipped onto the shortest path and every result
+ * is renormalized, which also absorbs the polynomial error of slerp. The
+ * outputs may alias the inputs.
+ */
+template <Blend Mode, class T>
+inline void blend4(const T *const a[4], const T *const b[4], const T *t,
+                   T *const out[4], std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        const Register one = W::broadcast(1);
+        for (; i + W::width <= n; i += W::width) {
+            Register va[4];
+            Register vb[4];
+            for (unsigned int c = 0; c < 4; c++) {
+                va[c] = W::load(a[c] + i);
+                vb[c] = W::load(b[c] + i);
+            }
+            Register d = W::mul(va[0], vb[0]);
+            for (unsigned int c = 1; c < 4; c++) {
+                d = W::fmadd(va[c], vb[c], d);
+            }
+            for (unsigned int c = 0; c < 4; c++) {
+                vb[c] = W::flip_sign(vb[c], d);
+            }
+            d = W::min(W::abs(d), one);
+            Register vt = W::load(t + i);
+            if constexpr (Mode == Blend::onlerp) {
+                const Register h = W::sub(vt, W::broadcast(0.5));
+                const Register k = W::fmadd(
+                    W::mul(detail::horner<W>(d, fast::detail::onlerp_a_coefficients), h),
+                    h, detail::horner<W>(d, fast::detail::onlerp_b_coefficients));
+                vt = W::fmadd(W::mul(W::mul(vt, h), W::sub(vt, one)), k, vt);
+            }
+            Register wa = W::sub(one, vt);
+            Register wb = vt;
+            if constexpr (Mode == Blend::slerp) {
+                const Register angle =
+                    W::mul(W::sqrt(W::sub(one, d)),
+                           detail::horner<W>(d, fast::detail::acos_coefficients));
+                const Register inverse_sin =
+                    W::div(one, W::sqrt(W::max(W::sub(one, W::mul(d, d)), W::zero())));
+                const Register near = W::greater(d, W::broadcast(fast::slerp_threshold));
+                const Register sin_a = detail::sin_first_quadrant<T>(W::mul(wa, angle));
+                const Register sin_b = detail::sin_first_quadrant<T>(W::mul(wb, angle));
+                wa = W::select(near, wa, W::mul(sin_a, inverse_sin));
+                wb = W::select(near, wb, W::mul(sin_b, inverse_sin));
+            }
+            Register r[4];
+            Register length2 = W::zero();
+            for (unsigned int c = 0; c < 4; c++) {
+                r[c] = W::fmadd(wa, va[c], W::mul(wb, vb[c]));
+                length2 = W::fmadd(r[c], r[c], length2);
+            }
+            const Register scale = W::div(one, W::sqrt(length2));
+            for (unsigned int c = 0; c < 4; c++) {
+                W::store(out[c] + i, W::mul(r[c], scale));
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        T d = 0;
+        for (unsigned int c = 0; c < 4; c++) {
+            d += a[c][i] * b[c][i];
+        }
+        const T sign = (d < 0) ? static_cast<T>(-1) : static_cast<T>(1);
+        d = std::min(d * sign, static_cast<T>(1));
+        T wa;
+        T wb;
+        blend_weights<Mode>(d, t[i], wa, wb);
+        wb *= sign;
+        T r[4];
+        T length2 = 0;
+        for (unsigned int c = 0; c < 4; c++) {
+            r[c] = wa * a[c][i] + wb * b[c][i];
+            length2 += r[c] * r[c];
+        }
+        const T scale = 1 / std::sqrt(length2);
+        for (unsigned int c = 0; c < 4; c++) {
+            out[c][i] = r[c] * scale;
+        }
+    }
+}
+
+/**
+ * @brief Dual quaternion skinning of n vertices with four influences each,
+ * all streams SoA. palette holds 8 scalars per bone (real wxyz, dual wxyz),
+ * every influence is flipped onto the hemisphere of the first one, the
+ * blend is normalized and applied as p' = r p r* + t. normal_in and
+ * normal_out may both be null. Bone indices are not checked.
+ */
+template <class T>
+inline void skin_dual_quat(const T *palette, const std::uint32_t *const bone[4],
+                           const T *const weight[4], const T *const in[3],
+                           const T *const normal_in[3], T *const out[3],
+                           T *const normal_out[3], std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX2)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        const Register two = W::broadcast(2);
+        // v + w t + u x t with t = 2 (u x v), on whole registers.
+        const auto rotate = [&](const Register r[4], Register v[3]) {
+            const Register tx = W::mul(two, W::sub(W::mul(r[2], v[2]), W::mul(r[3], v[1])));
+            const Register ty = W::mul(two, W::sub(W::mul(r[3], v[0]), W::mul(r[1], v[2])));
+            const Register tz = W::mul(two, W::sub(W::mul(r[1], v[1]), W::mul(r[2], v[0])));
+            v[0] = W::add(W::fmadd(r[0], tx, v[0]), W::sub(W::mul(r[2], tz), W::mul(r[3], ty)));
+            v[1] = W::add(W::fmadd(r[0], ty, v[1]), W::sub(W::mul(r[3], tx), W::mul(r[1], tz)));
+            v[2] = W::add(W::fmadd(r[0], tz, v[2]), W::sub(W::mul(r[1], ty), W::mul(r[2], tx)));
+        };
+        const auto gather = [&](unsigned int k, std::size_t at, Register q[8]) {
+            const typename W::Index index =
+                W::template shift_index<3>(W::load_index(bone[k] + at));
+            for (unsigned int c = 0; c < 8; c++) {
+                q[c] = W::gather(palette + c, index);
+            }
+        };
+        for (; i + W::width <= n; i += W::width) {
+            // The first influence sets the hemisphere and starts the blend.
+            Register first[8];
+            gather(0, i, first);
+            Register blended[8];
+            const Register w0 = W::load(weight[0] + i);
+            for (unsigned int c = 0; c < 8; c++) {
+                blended[c] = W::mul(w0, first[c]);
+            }
+            for (unsigned int k = 1; k < 4; k++) {
+                Register q[8];
+                gather(k, i, q);
+                Register w = W::load(weight[k] + i);
+                Register d = W::mul(q[0], first[0]);
+                for (unsigned int c = 1; c < 4; c++) {
+                    d = W::fmadd(q[c], first[c], d);
+                }
+                w = W::flip_sign(w, d);
+                for (unsigned int c = 0; c < 8; c++) {
+                    blended[c] = W::fmadd(w, q[c], blended[c]);
+                }
+            }
+            Register length2 = W::mul(blended[0], blended[0]);
+            for (unsigned int c = 1; c < 4; c++) {
+                length2 = W::fmadd(blended[c], blended[c], length2);
+            }
+            const Register scale = W::div(W::broadcast(1), W::sqrt(length2));
+            Register r[4];
+            Register dq[4];
+            for (unsigned int c = 0; c < 4; c++) {
+                r[c] = W::mul(blended[c], scale);
+                dq[c] = W::mul(blended[c + 4], scale);
+            }
+            // t = 2 (rw dv - dw rv + rv x dv)
+            Register t[3];
+            for (unsigned int c = 0; c < 3; c++) {
+                const unsigned int a = 1 + (c + 1) % 3;
+                const unsigned int b = 1 + (c + 2) % 3;
+                t[c] = W::mul(two, W::add(W::sub(W::mul(r[0], dq[c + 1]),
+                                                 W::mul(dq[0], r[c + 1])),
+                                          W::sub(W::mul(r[a], dq[b]), W::mul(r[b], dq[a]))));
+            }
+            Register p[3] = {W::load(in[0] + i), W::load(in[1] + i), W::load(in[2] + i)};
+            rotate(r, p);
+            for (unsigned int c = 0; c < 3; c++) {
+                W::store(out[c] + i, W::add(p[c], t[c]));
+            }
+            if (normal_in) {
+                Register v[3] = {W::load(normal_in[0] + i), W::load(normal_in[1] + i),
+                                 W::load(normal_in[2] + i)};
+                rotate(r, v);
+                for (unsigned int c = 0; c < 3; c++) {
+                    W::store(normal_out[c] + i, v[c]);
+                }
+            }
+        }
+    }
+#endif
+    const auto rotate = [](const T r[4], T v[3]) {
+        const T tx = 2 * (r[2] * v[2] - r[3] * v[1]);
+        const T ty = 2 * (r[3] * v[0] - r[1] * v[2]);
+        const T tz = 2 * (r[1] * v[1] - r[2] * v[0]);
+        const T x = v[0] + r[0] * tx + (r[2] * tz - r[3] * ty);
+        const T y = v[1] + r[0] * ty + (r[3] * tx - r[1] * tz);
+        v[2] = v[2] + r[0] * tz + (r[1] * ty - r[2] * tx);
+        v[0] = x;
+        v[1] = y;
+    };
+    for (; i < n; i++) {
+        T blended[8] = {};
+        const T *first = palette + 8 * bone[0][i];
+        for (unsigned int k = 0; k < 4; k++) {
+            const T *q = palette + 8 * bone[k][i];
+            const T d = q[0] * first[0] + q[1] * first[1] + q[2] * first[2] +
+                        q[3] * first[3];
+            const T w = (d < 0) ? -weight[k][i] : weight[k][i];
+            for (unsigned int c = 0; c < 8; c++) {
+                blended[c] += w * q[c];
+            }
+        }
+        const T scale =
+            1 / std::sqrt(blended[0] * blended[0] + blended[1] * blended[1] +
+                          blended[2] * blended[2] + blended[3] * blended[3]);
+        T r[4];
+        T dq[4];
+        for (unsigned int c = 0; c < 4; c++) {
+            r[c] = blended[c] * scale;
+            dq[c] = blended[c + 4] * scale;
+        }
+        T p[3] = {in[0][i], in[1][i], in[2][i]};
+        rotate(r, p);
+        out[0][i] = p[0] + 2 * (r[0] * dq[1] - dq[0] * r[1] + r[2] * dq[3] - r[3] * dq[2]);
+        out[1][i] = p[1] + 2 * (r[0] * dq[2] - dq[0] * r[2] + r[3] * dq[1] - r[1] * dq[3]);
+        out[2][i] = p[2] + 2 * (r[0] * dq[3] - dq[0] * r[3] + r[1] * dq[2] - r[2] * dq[1]);
+        if (normal_in) {
+            T v[3] = {normal_in[0][i], normal_in[1][i], normal_in[2][i]};
+            rotate(r, v);
+            for (unsigned int c = 0; c < 3; c++) {
+                normal_out[c][i] = v[c];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Linear blend skinning of n vertices with four influences each, all
+ * streams AoS as stored in the mesh: bone and weight hold four values per
+ * vertex, in, normal_in, out and normal_out three. palette holds 16 scalars
+ * per bone (column major Mat4). The bottom row is assumed 0 0 0 1, the AVX
+ * paths load it with the columns but it never reaches the result. The
+ * weighted sum of the four matrices moves the position, its upper 3x3 the
+ * normal, which is then normalized (zero stays zero). normal_in and
+ * normal_out may both be null. Bone indices are not checked.
+ */
+template <class T>
+inline void skin_linear(const T *palette, const std::uint32_t *bone, const T *weight,
+                        const T *in, const T *normal_in, T *out, T *normal_out,
+                        std::size_t n) {
+    // Column major offsets of the 3x4 affine part.
+    constexpr unsigned int offset[12] = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14};
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    // Per vertex, the four bones are blended with whole-column loads (a
+    // gather per matrix element across vertices is several times slower),
+    // float holds two columns per register and double one.
+    if constexpr (std::is_same_v<T, float>) {
+        using W = Wide<float>;
+        const auto apply = [](__m256 m01, __m256 m23, float x, float y, float z,
+                              float w) {
+            const __m256 xy = _mm256_set_m128(_mm_set1_ps(y), _mm_set1_ps(x));
+            const __m256 zw = _mm256_set_m128(_mm_set1_ps(w), _mm_set1_ps(z));
+            const __m256 sum = W::fmadd(m01, xy, W::mul(m23, zw));
+            return _mm_add_ps(_mm256_castps256_ps128(sum),
+                              _mm256_extractf128_ps(sum, 1));
+        };
+        for (; i < n; i++) {
+            const float *matrix = palette + 16 * bone[4 * i];
+            __m256 w = W::broadcast(weight[4 * i]);
+            __m256 m01 = W::mul(w, W::load(matrix));
+            __m256 m23 = W::mul(w, W::load(matrix + 8));
+            for (unsigned int k = 1; k < 4; k++) {
+                matrix = palette + 16 * bone[4 * i + k];
+                w = W::broadcast(weight[4 * i + k]);
+                m01 = W::fmadd(w, W::load(matrix), m01);
+                m23 = W::fmadd(w, W::load(matrix + 8), m23);
+            }
+            const float *p = in + 3 * i;
+            alignas(16) float result[4];
+            _mm_store_ps(result, apply(m01, m23, p[0], p[1], p[2], 1));
+            for (unsigned int r = 0; r < 3; r++) {
+                out[3 * i + r] = result[r];
+            }
+            if (normal_in) {
+                const float *v = normal_in + 3 * i;
+                __m128 normal = apply(m01, m23, v[0], v[1], v[2], 0);
+                const __m128 length2 = _mm_dp_ps(normal, normal, 0x7F);
+                normal = _mm_and_ps(_mm_div_ps(normal, _mm_sqrt_ps(length2)),
+                                    _mm_cmpgt_ps(length2, _mm_setzero_ps()));
+                _mm_store_ps(result, normal);
+                for (unsigned int r = 0; r < 3; r++) {
+                    normal_out[3 * i + r] = result[r];
+                }
+            }
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        using W = Wide<double>;
+        using Register = typename W::Register;
+        const auto apply = [](const Register m[4], const double *v) {
+            return W::fmadd(m[2], W::broadcast(v[2]),
+                            W::fmadd(m[1], W::broadcast(v[1]), W::mul(m[0], W::broadcast(v[0]))));
+        };
+        for (; i < n; i++) {
+            const double *matrix = palette + 16 * bone[4 * i];
+            Register w = W::broadcast(weight[4 * i]);
+            Register m[4];
+            for (unsigned int c = 0; c < 4; c++) {
+                m[c] = W::mul(w, W::load(matrix + 4 * c));
+            }
+            for (unsigned int k = 1; k < 4; k++) {
+                matrix = palette + 16 * bone[4 * i + k];
+                w = W::broadcast(weight[4 * i + k]);
+                for (unsigned int c = 0; c < 4; c++) {
+                    m[c] = W::fmadd(w, W::load(matrix + 4 * c), m[c]);
+                }
+            }
+            alignas(32) double result[4];
+            W::store(result, W::add(apply(m, in + 3 * i), m[3]));
+            for (unsigned int r = 0; r < 3; r++) {
+                out[3 * i + r] = result[r];
+            }
+            if (normal_in) {
+                W::store(result, apply(m, normal_in + 3 * i));
+                const double length2 = result[0] * result[0] +
+                                       result[1] * result[1] + result[2] * result[2];
+                const double scale = (length2 > 0) ? 1 / std::sqrt(length2) : 0.0;
+                for (unsigned int r = 0; r < 3; r++) {
+                    normal_out[3 * i + r] = result[r] * scale;
+                }
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        T m[12] = {};
+        for (unsigned int k = 0; k < 4; k++) {
+            const T *matrix = palette + 16 * bone[4 * i + k];
+            for (unsigned int c = 0; c < 12; c++) {
+                m[c] += weight[4 * i + k] * matrix[offset[c]];
+            }
+        }
+        const T p[3] = {in[3 * i], in[3 * i + 1], in[3 * i + 2]};
+        for (unsigned int r = 0; r < 3; r++) {
+            out[3 * i + r] = m[r] * p[0] + m[3 + r] * p[1] + m[6 + r] * p[2] + m[9 + r];
+        }
+        if (normal_in) {
+            const T v[3] = {normal_in[3 * i], normal_in[3 * i + 1], normal_in[3 * i + 2]};
+            T result[3];
+            for (unsigned int r = 0; r < 3; r++) {
+                result[r] = m[r] * v[0] + m[3 + r] * v[1] + m[6 + r] * v[2];
+            }
+            const T length2 =
+                result[0] * result[0] + result[1] * result[1] + result[2] * result[2];
+            const T scale = (length2 > 0) ? 1 / std::sqrt(length2) : static_cast<T>(0);
+            for (unsigned int r = 0; r < 3; r++) {
+                normal_out[3 * i + r] = result[r] * scale;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Frustum culling of n bounding spheres, SoA. planes holds six
+ * (a, b, c, d) with unit inward normals. out[i] is 0 when the sphere is
+ * outside a plane, 2 when it is strictly inside all of them and 1
+ * otherwise.
+ */
+template <class T>
+inline void classify_spheres(const T *planes, const T *x, const T *y,
+                             const T *z, const T *radius, std::uint8_t *out,
+                             std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        Register plane[6][4];
+        for (unsigned int p = 0; p < 6; p++) {
+            for (unsigned int c = 0; c < 4; c++) {
+                plane[p][c] = W::broadcast(planes[4 * p + c]);
+            }
+        }
+        const Register one = W::broadcast(1);
+        for (; i + W::width <= n; i += W::width) {
+            const Register px = W::load(x + i);
+            const Register py = W::load(y + i);
+            const Register pz = W::load(z + i);
+            const Register r = W::load(radius + i);
+            const Register negative_r = W::sub(W::zero(), r);
+            Register outside = W::zero();
+            Register inside = W::greater(one, W::zero());
+            for (unsigned int p = 0; p < 6; p++) {
+                const Register d = W::fmadd(
+                    plane[p][2], pz,
+                    W::fmadd(plane[p][1], py, W::fmadd(plane[p][0], px, plane[p][3])));
+                outside = W::mask_or(outside, W::greater(negative_r, d));
+                inside = W::mask_and(inside, W::greater(d, r));
+            }
+            W::store_bytes(out + i, W::select(outside, W::zero(),
+                                              W::add(one, W::mask_and(inside, one))));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        bool outside = false;
+        bool inside = true;
+        for (unsigned int p = 0; p < 6; p++) {
+            const T *plane = planes + 4 * p;
+            const T d = plane[0] * x[i] + plane[1] * y[i] + plane[2] * z[i] + plane[3];
+            outside = outside || d < -radius[i];
+            inside = inside && d > radius[i];
+        }
+        out[i] = outside ? 0 : inside ? 2 : 1;
+    }
+}
+/**
+ * @brief Frustum culling of n axis aligned boxes given by their min and
+ * max corners, SoA, with the codes of classify_spheres. Every plane is
+ * tested against the box's extent projected on its normal.
+ */
+template <class T>
+inline void classify_boxes(const T *planes, const T *const min[3],
+                           const T *const max[3], std::uint8_t *out,
+                           std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        Register plane[6][4];
+        Register extent_scale[6][3];
+        for (unsigned int p = 0; p < 6; p++) {
+            for (unsigned int c = 0; c < 4; c++) {
+                plane[p][c] = W::broadcast(planes[4 * p + c]);
+            }
+            for (unsigned int c = 0; c < 3; c++) {
+                extent_scale[p][c] = W::abs(plane[p][c]);
+            }
+        }
+        const Register one = W::broadcast(1);
+        const Register half = W::broadcast(static_cast<T>(0.5));
+        for (; i + W::width <= n; i += W::width) {
+            Register center[3];
+            Register extent[3];
+            for (unsigned int c = 0; c < 3; c++) {
+                const Register lo = W::load(min[c] + i);
+                const Register hi = W::load(max[c] + i);
+                center[c] = W::mul(half, W::add(lo, hi));
+                extent[c] = W::mul(half, W::sub(hi, lo));
+            }
+            Register outside = W::zero();
+            Register inside = W::greater(one, W::zero());
+            for (unsigned int p = 0; p < 6; p++) {
+                const Register d = W::fmadd(
+                    plane[p][2], center[2],
+                    W::fmadd(plane[p][1], center[1],
+                             W::fmadd(plane[p][0], center[0], plane[p][3])));
+                const Register r = W::fmadd(
+                    extent_scale[p][2], extent[2],
+                    W::fmadd(extent_scale[p][1], extent[1],
+                             W::mul(extent_scale[p][0], extent[0])));
+                outside = W::mask_or(outside, W::greater(W::sub(W::zero(), r), d));
+                inside = W::mask_and(inside, W::greater(d, r));
+            }
+            W::store_bytes(out + i, W::select(outside, W::zero(),
+                                              W::add(one, W::mask_and(inside, one))));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        bool outside = false;
+        bool inside = true;
+        for (unsigned int p = 0; p < 6; p++) {
+            const T *plane = planes + 4 * p;
+            T d = plane[3];
+            T r = 0;
+            for (unsigned int c = 0; c < 3; c++) {
+                d += plane[c] * (min[c][i] + max[c][i]) * static_cast<T>(0.5);
+                r += std::abs(plane[c]) * (max[c][i] - min[c][i]) * static_cast<T>(0.5);
+            }
+            outside = outside || d < -r;
+            inside = inside && d > r;
+        }
+        out[i] = outside ? 0 : inside ? 2 : 1;
+    }
+}
+
+/**
+ * @brief Column major C[MxK] = A[MxN] * B[NxK]. Register-blocked on 2x4
+ * (float: 16 rows, double: 8 rows, times 4 columns) when
+ * gemm_accelerated, every operand fits in L1 up to 32x32 so no further
+ * cache tiling is done.
+ */
+template <unsigned int M, unsigned int N, unsigned int K, class T>
+inline void gemm(const T *a, const T *b, T *c) {
+#if defined(SMATH_AVX)
+    if constexpr (gemm_accelerated<M, N, K, T>) {
+        constexpr unsigned int cols = 4;
+        constexpr unsigned int full = K - K % cols;
+        for (unsigned int k = 0; k < full; k += cols) {
+            detail::gemm_panel<cols, M, N>(a, b + k * N, c + k * M);
+        }
+        if constexpr (K % cols != 0) {
+            detail::gemm_panel<K % cols, M, N>(a, b + full * N, c + full * M);
+        }
+        return;
+    }
+#endif
+    for (unsigned int k = 0; k < K; k++) {
+        for (unsigned int m = 0; m < M; m++) {
+            T sum = 0;
+            for (unsigned int n = 0; n < N; n++) {
+                sum += a[n * M + m] * b[k * N + n];
+            }
+            c[k * M + m] = sum;
+        }
+    }
+}
+
+/***************************************
+        Bulk kernels
+***************************************/
+/**
+ * @brief out[i] = sqrt(in[i]) for n elements. Packed instructions are used
+ * explicitly since a plain std::sqrt loop is kept scalar by math-errno.
+ */
+template <class T>
+inline void sqrt(const T *in, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (std::is_same_v<T, float>) {
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_loadu_ps(in + i)));
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i)));
+        }
+    }
+#elif defined(SMATH_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_loadu_ps(in + i)));
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        for (; i + 2 <= n; i += 2) {
+            _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(in + i)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = static_cast<T>(std::sqrt(in[i]));
+    }
+}
+
+/***************************************
+        Fast approximations
+***************************************/
+/*
+    fast:: functions over arrays, eight floats or four doubles per AVX
+    iteration through the same reduction and polynomials as the scalar
+    ones (FMA may round the last bit differently). The tails, and builds
+    without AVX, use the scalar functions.
+*/
+#if defined(SMATH_AVX)
+namespace detail {
+/**
+ * @brief sin and cos of every lane, see fast::sin.
+ */
+template <class T>
+inline void sin_cos(typename Wide<T>::Register x, typename Wide<T>::Register &sin,
+                    typename Wide<T>::Register &cos) {
+    using W = Wide<T>;
+    using Register = typename W::Register;
+    using Tables = fast::detail::Tables<T>;
+    const Register q = W::round(W::mul(x, W::broadcast(2 / std::numbers::pi)));
+    const Register minus_q = W::sub(W::zero(), q);
+    Register r = x;
+    for (const double part : Tables::half_pi) {
+        r = W::fmadd(minus_q, W::broadcast(part), r);
+    }
+    const Register z = W::mul(r, r);
+    const Register s = W::mul(r, horner<W>(z, Tables::sin));
+    const Register c = horner<W>(z, Tables::cos);
+    // q mod 4 in floating point, exact for the q the reduction supports.
+    const Register quadrant =
+        W::sub(q, W::mul(W::broadcast(4), W::floor(W::mul(q, W::broadcast(0.25)))));
+    const Register odd = W::greater(
+        W::sub(quadrant, W::mul(W::broadcast(2), W::floor(W::mul(quadrant, W::broadcast(0.5))))),
+        W::broadcast(0.5));
+    const Register sin_negative = W::greater(quadrant, W::broadcast(1.5));
+    const Register cos_negative = W::mask_and(W::greater(quadrant, W::broadcast(0.5)),
+                                              W::greater(W::broadcast(2.5), quadrant));
+    sin = W::select(odd, c, s);
+    cos = W::select(odd, s, c);
+    sin = W::select(sin_negative, W::sub(W::zero(), sin), sin);
+    cos = W::select(cos_negative, W::sub(W::zero(), cos), cos);
+}
+/**
+ * @brief atan2 of every lane pair, see fast::atan2.
+ */
+template <class T>
+inline typename Wide<T>::Register atan2(typename Wide<T>::Register y,
+                                        typename Wide<T>::Register x) {
+    using W = Wide<T>;
+    using Register = typename W::Register;
+    const Register zero = W::zero();
+    const Register ax = W::abs(x);
+    const Register ay = W::abs(y);
+    const Register low = W::min(ax, ay);
+    const Register high = W::max(ax, ay);
+    const Register octant =
+        W::greater(low, W::mul(W::broadcast(fast::detail::tan_eighth_pi), high));
+    const Register numerator = W::select(octant, W::sub(low, high), low);
+    const Register denominator = W::select(
+        octant, W::add(low, high), W::select(W::greater(high, zero), high, W::broadcast(1)));
+    const Register t = W::div(numerator, denominator);
+    Register angle = W::mul(t, horner<W>(W::mul(t, t), fast::detail::Tables<T>::atan));
+    angle = W::select(octant, W::add(angle, W::broadcast(std::numbers::pi / 4)), angle);
+    angle = W::select(W::greater(ay, ax), W::sub(W::broadcast(std::numbers::pi / 2), angle),
+                      angle);
+    angle = W::select(W::greater(zero, x), W::sub(W::broadcast(std::numbers::pi), angle),
+                      angle);
+    return W::select(W::greater(zero, y), W::sub(zero, angle), angle);
+}
+} // namespace detail
+#endif
+
+/**
+ * @brief out[i] = fast::rsqrt(in[i]) for n elements.
+ */
+template <class T> inline void rsqrt(const T *in, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        for (; i + W::width <= n; i += W::width) {
+            W::store(out + i, W::rsqrt(W::load(in + i)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = fast::rsqrt(in[i]);
+    }
+}
+/**
+ * @brief out[i] = fast::sin(in[i]) for n elements.
+ */
+template <class T> inline void sin(const T *in, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        for (; i + W::width <= n; i += W::width) {
+            typename W::Register s;
+            typename W::Register c;
+            detail::sin_cos<T>(W::load(in + i), s, c);
+            W::store(out + i, s);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = fast::sin(in[i]);
+    }
+}
+/**
+ * @brief out[i] = fast::cos(in[i]) for n elements.
+ */
+template <class T> inline void cos(const T *in, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        for (; i + W::width <= n; i += W::width) {
+            typename W::Register s;
+            typename W::Register c;
+            detail::sin_cos<T>(W::load(in + i), s, c);
+            W::store(out + i, c);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = fast::cos(in[i]);
+    }
+}
+/**
+ * @brief sin[i], cos[i] = fast::sincos(in[i]) for n elements, one reduction
+ * for both.
+ */
+template <class T> inline void sincos(const T *in, T *sin, T *cos, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        for (; i + W::width <= n; i += W::width) {
+            typename W::Register s;
+            typename W::Register c;
+            detail::sin_cos<T>(W::load(in + i), s, c);
+            W::store(sin + i, s);
+            W::store(cos + i, c);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        const SinCos<T> value = fast::sincos(in[i]);
+        sin[i] = value.sin;
+        cos[i] = value.cos;
+    }
+}
+/**
+ * @brief out[i] = fast::acos(in[i]) for n elements in [-1, 1].
+ */
+template <class T> inline void acos(const T *in, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        using Register = typename W::Register;
+        const Register one = W::broadcast(1);
+        for (; i + W::width <= n; i += W::width) {
+            const Register x = W::load(in + i);
+            const Register a = W::abs(x);
+            Register result;
+            if constexpr (std::is_same_v<T, float>) {
+                result = W::mul(W::sqrt(W::sub(one, a)),
+                                detail::horner<W>(a, fast::detail::acos_coefficients));
+            } else {
+                const Register half = W::broadcast(0.5);
+                const Register far = W::greater(a, half);
+                const Register s = W::select(far, W::sqrt(W::mul(W::sub(one, a), half)), a);
+                const Register asin = W::mul(
+                    s, detail::horner<W>(W::mul(s, s), fast::detail::asin_double_coefficients));
+                result = W::select(far, W::add(asin, asin),
+                                   W::sub(W::broadcast(std::numbers::pi / 2), asin));
+            }
+            W::store(out + i, W::select(W::greater(W::zero(), x),
+                                        W::sub(W::broadcast(std::numbers::pi), result), result));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = fast::acos(in[i]);
+    }
+}
+/**
+ * @brief out[i] = fast::atan2(y[i], x[i]) for n elements.
+ */
+template <class T> inline void atan2(const T *y, const T *x, T *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX)
+    if constexpr (Wide<T>::enabled) {
+        using W = Wide<T>;
+        for (; i + W::width <= n; i += W::width) {
+            W::store(out + i, detail::atan2<T>(W::load(y + i), W::load(x + i)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = fast::atan2(y[i], x[i]);
+    }
+}
+
+/***************************************
+        16-bit floats
+***************************************/
+/**
+ * @return IEEE binary16 bits of value, rounded to nearest even. Overflow
+ * gives infinity, NaN stays a quiet NaN with the top of its payload (as
+ * vcvtps2ph does).
+ */
+constexpr std::uint16_t half_from_float(float value) {
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::uint32_t magnitude = bits & 0x7FFFFFFFu;
+    if (magnitude >= 0x7F800000u) {
+        const std::uint32_t nan =
+            magnitude > 0x7F800000u ? 0x0200u | ((magnitude >> 13) & 0x03FFu) : 0;
+        return static_cast<std::uint16_t>(sign | 0x7C00u | nan);
+    }
+    // 65520 and above round to infinity.
+    if (magnitude >= 0x477FF000u) {
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+    // Below 2^-14 the result is subnormal, counted in units of 2^-24.
+    if (magnitude < 0x38800000u) {
+        if (magnitude < 0x33000000u) {
+            return static_cast<std::uint16_t>(sign);
+        }
+        const std::uint32_t mantissa = (magnitude & 0x007FFFFFu) | 0x00800000u;
+        const std::uint32_t shift = 126 - (magnitude >> 23);
+        const std::uint32_t rest = mantissa & ((1u << shift) - 1);
+        const std::uint32_t halfway = 1u << (shift - 1);
+        std::uint32_t result = mantissa >> shift;
+        if (rest > halfway || (rest == halfway && (result & 1))) {
+            result++;
+        }
+        return static_cast<std::uint16_t>(sign | result);
+    }
+    // Rebias the exponent from 127 to 15 and round off 13 mantissa bits, a
+    // carry out of the mantissa correctly bumps the exponent.
+    std::uint32_t result = magnitude - 0x38000000u;
+    result += 0x0FFFu + ((result >> 13) & 1);
+    return static_cast<std::uint16_t>(sign | (result >> 13));
+}
+/**
+ * @return The float equal to IEEE binary16 bits, exact. Signaling NaN comes
+ * back quiet (as vcvtph2ps does).
+ */
+constexpr float half_to_float(std::uint16_t half) {
+    const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+    const std::uint32_t exponent = (half >> 10) & 0x1Fu;
+    const std::uint32_t mantissa = half & 0x03FFu;
+    if (exponent == 0x1F) {
+        const std::uint32_t nan = mantissa ? 0x00400000u | (mantissa << 13) : 0;
+        return std::bit_cast<float>(sign | 0x7F800000u | nan);
+    }
+    if (exponent == 0) {
+        const float subnormal = static_cast<float>(mantissa) * 0x1p-24f;
+        return sign ? -subnormal : subnormal;
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+/**
+ * @return The upper 16 bits of value rounded to nearest even, NaN made
+ * quiet.
+ */
+constexpr std::uint16_t bfloat16_from_float(float value) {
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+    }
+    return static_cast<std::uint16_t>((bits + 0x7FFFu + ((bits >> 16) & 1)) >> 16);
+}
+constexpr float bfloat16_to_float(std::uint16_t bfloat) {
+    return std::bit_cast<float>(static_cast<std::uint32_t>(bfloat) << 16);
+}
+
+/**
+ * @brief out[i] = binary16 of in[i] for n elements, F16C (and AVX-512)
+ * conversions when available.
+ */
+inline void float_to_half(const float *in, std::uint16_t *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX512)
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm512_cvtps_ph(_mm512_loadu_ps(in + i),
+                                            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+#endif
+#if defined(SMATH_F16C)
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = half_from_float(in[i]);
+    }
+}
+inline void half_to_float(const std::uint16_t *in, float *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX512)
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256(
+                                      reinterpret_cast<const __m256i *>(in + i))));
+    }
+#endif
+#if defined(SMATH_F16C)
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(
+                                      reinterpret_cast<const __m128i *>(in + i))));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = half_to_float(in[i]);
+    }
+}
+/**
+ * @brief out[i] = bfloat16 of in[i] for n elements, the rounding of
+ * bfloat16_from_float done on integer lanes.
+ */
+inline void float_to_bfloat16(const float *in, std::uint16_t *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX2)
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i quiet = _mm256_set1_epi32(0x0040);
+    const auto round = [&](__m256 value) {
+        const __m256i bits = _mm256_castps_si256(value);
+        const __m256i high = _mm256_srli_epi32(bits, 16);
+        const __m256i rounded = _mm256_srli_epi32(
+            _mm256_add_epi32(bits, _mm256_add_epi32(bias, _mm256_and_si256(high, one))), 16);
+        const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+        return _mm256_blendv_epi8(rounded, _mm256_or_si256(high, quiet), nan);
+    };
+    for (; i + 16 <= n; i += 16) {
+        // Lanes hold values below 2^16, so the signed saturation of packus
+        // never triggers; it interleaves 128-bit halves, undone by permute.
+        const __m256i packed = _mm256_packus_epi32(round(_mm256_loadu_ps(in + i)),
+                                                   round(_mm256_loadu_ps(in + i + 8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = bfloat16_from_float(in[i]);
+    }
+}
+inline void bfloat16_to_float(const std::uint16_t *in, float *out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(SMATH_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        const __m256i wide = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = bfloat16_to_float(in[i]);
+    }
+}
+} // namespace smath::simd
+#endif // SMATH_SIMD_HPP
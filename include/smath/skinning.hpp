@@ -0,0 +1,203 @@
+#ifndef SMATH_SKINNING_HPP
+#define SMATH_SKINNING_HPP
+
+#include "config.hpp"
+#include "dual_quat.hpp"
+#include "execution.hpp"
+#include "mat.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    Skinning of vertex streams with four bone influences per vertex, either
+    by blending Mat4 bones (skin_linear) or unit dual quaternions
+    (skin_dual_quat).
+
+    skin_linear blends whole matrix columns per vertex and reads the
+    array-of-structs streams in place. skin_dual_quat stages them through
+    SoA chunks on the stack, like the bulk transforms, and runs across
+    vertices on whole registers. Unused influences should carry weight 0
+    and any valid bone index (0 is fine). Bone indices are validated once
+    up front when SMATH_CHECKED is non-zero, never inside the kernels.
+*/
+/**
+ * @brief Input streams of a skinned mesh, normals are optional.
+ */
+template <class T> struct SkinStreams {
+    std::span<const Vec<4, std::uint32_t>> bones;
+    std::span<const Vec<4, T>> weights;
+    std::span<const Vec<3, T>> positions;
+    std::span<const Vec<3, T>> normals{};
+};
+/**
+ * @brief Output streams, normals must be given exactly when the input has
+ * them.
+ */
+template <class T> struct SkinOutput {
+    std::span<Vec<3, T>> positions;
+    std::span<Vec<3, T>> normals{};
+};
+
+namespace detail {
+constexpr std::size_t skin_chunk = 64;
+
+template <class T> constexpr std::size_t skin_grain() {
+    // Bone indices, weights, and positions and normals read and written.
+    const std::size_t grain = execution::grain(16 + 16 * sizeof(T));
+    return std::max(skin_chunk, grain - grain % skin_chunk);
+}
+
+template <class T>
+void check_skin(std::size_t palette_size, const SkinStreams<T> &in,
+                const SkinOutput<T> &out) {
+    const std::size_t n = in.positions.size();
+    if (in.bones.size() != n || in.weights.size() != n ||
+        (!in.normals.empty() && in.normals.size() != n)) {
+        throw std::invalid_argument("Skin stream size mismatched.");
+    }
+    if (out.positions.size() != n || out.normals.size() != in.normals.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+#if SMATH_CHECKED
+    for (const Vec<4, std::uint32_t> &bone : in.bones) {
+        for (unsigned int k = 0; k < 4; k++) {
+            if (bone.unchecked(k) >= palette_size)
+                throw std::out_of_range("Bone index out of bound");
+        }
+    }
+#else
+    (void)palette_size;
+#endif
+    static_assert(sizeof(Vec<4, std::uint32_t>) == 4 * sizeof(std::uint32_t));
+    static_assert(sizeof(Vec<4, T>) == 4 * sizeof(T));
+    static_assert(sizeof(Vec<3, T>) == 3 * sizeof(T));
+}
+
+/**
+ * @brief Stage [begin, end) of the streams into SoA chunks and call
+ * kernel(bone, weight, in, normal_in, out, normal_out, count) per chunk.
+ */
+template <class T, class Kernel>
+void skin_range(const SkinStreams<T> &in, const SkinOutput<T> &out,
+                std::size_t begin, std::size_t end, Kernel &&kernel) {
+    alignas(64) std::uint32_t bone[4][skin_chunk];
+    alignas(64) T weight[4][skin_chunk];
+    alignas(64) T position[3][skin_chunk];
+    alignas(64) T normal[3][skin_chunk];
+    const std::uint32_t *const bone_soa[4] = {bone[0], bone[1], bone[2], bone[3]};
+    const T *const weight_soa[4] = {weight[0], weight[1], weight[2], weight[3]};
+    T *const position_soa[3] = {position[0], position[1], position[2]};
+    T *const normal_soa[3] = {normal[0], normal[1], normal[2]};
+    const bool has_normals = !in.normals.empty();
+    const std::uint32_t *packed_bones =
+        reinterpret_cast<const std::uint32_t *>(in.bones.data());
+    const T *packed_weights = reinterpret_cast<const T *>(in.weights.data());
+    const T *packed_positions = reinterpret_cast<const T *>(in.positions.data());
+    const T *packed_normals = reinterpret_cast<const T *>(in.normals.data());
+    T *packed_out = reinterpret_cast<T *>(out.positions.data());
+    T *packed_normal_out = reinterpret_cast<T *>(out.normals.data());
+    for (std::size_t base = begin; base < end; base += skin_chunk) {
+        const std::size_t count = std::min(skin_chunk, end - base);
+        simd::deinterleave4(packed_bones + 4 * base, bone[0], bone[1], bone[2],
+                            bone[3], count);
+        simd::deinterleave4(packed_weights + 4 * base, weight[0], weight[1],
+                            weight[2], weight[3], count);
+        simd::deinterleave3(packed_positions + 3 * base, position[0],
+                            position[1], position[2], count);
+        if (has_normals) {
+            simd::deinterleave3(packed_normals + 3 * base, normal[0], normal[1],
+                                normal[2], count);
+        }
+        kernel(bone_soa, weight_soa, position_soa,
+               has_normals ? normal_soa : nullptr, position_soa,
+               has_normals ? normal_soa : nullptr, count);
+        simd::interleave3(position[0], position[1], position[2],
+                          packed_out + 3 * base, count);
+        if (has_normals) {
+            simd::interleave3(normal[0], normal[1], normal[2],
+                              packed_normal_out + 3 * base, count);
+        }
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Linear blend skinning: every vertex is moved by the weighted sum
+ * of its bones' affine matrices, normals by the upper 3x3 of that sum and
+ * renormalized (exact for bones without non-uniform scale). The bottom
+ * row of the palette matrices does not affect the result.
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void skin_linear(Policy &&policy,
+                 std::type_identity_t<std::span<const Mat<4, 4, T>>> palette,
+                 const SkinStreams<T> &in, std::type_identity_t<SkinOutput<T>> out) {
+    detail::check_skin(palette.size(), in, out);
+    static_assert(sizeof(Mat<4, 4, T>) == 16 * sizeof(T));
+    const T *packed_palette = reinterpret_cast<const T *>(palette.data());
+    const std::uint32_t *packed_bones =
+        reinterpret_cast<const std::uint32_t *>(in.bones.data());
+    const T *packed_weights = reinterpret_cast<const T *>(in.weights.data());
+    const T *packed_positions = reinterpret_cast<const T *>(in.positions.data());
+    const T *packed_normals = reinterpret_cast<const T *>(in.normals.data());
+    T *packed_out = reinterpret_cast<T *>(out.positions.data());
+    T *packed_normal_out = reinterpret_cast<T *>(out.normals.data());
+    const bool has_normals = !in.normals.empty();
+    execution::for_each_range(
+        policy, in.positions.size(), detail::skin_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            simd::skin_linear(packed_palette, packed_bones + 4 * begin,
+                              packed_weights + 4 * begin, packed_positions + 3 * begin,
+                              has_normals ? packed_normals + 3 * begin : nullptr,
+                              packed_out + 3 * begin,
+                              has_normals ? packed_normal_out + 3 * begin : nullptr,
+                              end - begin);
+        });
+}
+template <class T>
+void skin_linear(std::type_identity_t<std::span<const Mat<4, 4, T>>> palette,
+                 const SkinStreams<T> &in, std::type_identity_t<SkinOutput<T>> out) {
+    skin_linear(execution::seq, palette, in, out);
+}
+
+/**
+ * @brief Dual quaternion skinning: every vertex is moved by the normalized
+ * weighted blend of its bones' unit dual quaternions.
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void skin_dual_quat(Policy &&policy,
+                    std::type_identity_t<std::span<const DualQuat<T>>> palette,
+                    const SkinStreams<T> &in,
+                    std::type_identity_t<SkinOutput<T>> out) {
+    detail::check_skin(palette.size(), in, out);
+    static_assert(sizeof(DualQuat<T>) == 8 * sizeof(T));
+    const T *packed_palette = reinterpret_cast<const T *>(palette.data());
+    execution::for_each_range(
+        policy, in.positions.size(), detail::skin_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            detail::skin_range(
+                in, out, begin, end,
+                [&](const std::uint32_t *const bone[4], const T *const weight[4],
+                    const T *const position[3], const T *const normal[3],
+                    T *const position_out[3], T *const normal_out[3],
+                    std::size_t count) {
+                    simd::skin_dual_quat(packed_palette, bone, weight, position,
+                                         normal, position_out, normal_out,
+                                         count);
+                });
+        });
+}
+template <class T>
+void skin_dual_quat(std::type_identity_t<std::span<const DualQuat<T>>> palette,
+                    const SkinStreams<T> &in,
+                    std::type_identity_t<SkinOutput<T>> out) {
+    skin_dual_quat(execution::seq, palette, in, out);
+}
+} // namespace smath
+#endif // SMATH_SKINNING_HPP
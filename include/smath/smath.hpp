@@ -1,6 +1,14 @@
 #ifndef SMATH_SMATH_HPP
 #define SMATH_SMATH_HPP
 
+#include "affine.hpp"
+#include "blend.hpp"
 #include "common.hpp"
+#include "dual_quat.hpp"
+#include "frustum.hpp"
+#include "half.hpp"
+#include "layout.hpp"
+#include "skinning.hpp"
+#include "transform.hpp"
 
 #endif //SMATH_SMATH_H
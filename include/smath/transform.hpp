@@ -0,0 +1,464 @@
+#ifndef SMATH_TRANSFORM_HPP
+#define SMATH_TRANSFORM_HPP
+
+#include "config.hpp"
+#include "execution.hpp"
+#include "layout.hpp"
+#include "mat.hpp"
+#include "quat.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include "vec_array.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace smath {
+/*
+    Bulk transforms of many Vec3 by one Mat4.
+
+    Array-of-structs spans are staged through small structure-of-arrays
+    chunks on the stack so the SIMD kernel runs over whole registers of
+    vertices: [x0 y0 z0 x1 y1 z1 ...] -> [x0 x1 ...] [y0 y1 ...] [z0 z1 ...].
+    VecArray is already SoA and skips the staging, and so do spans of
+    PaddedVec3 (layout.hpp), whose elements are each one register load.
+
+    rotate_vectors by one quaternion goes through its rotation matrix, by
+    one quaternion per vector stages the quaternions the same way and runs
+    v' = v + w t + u x t with t = 2 (u x v) on whole registers.
+
+    in and out may be the same buffer (in place), but must not otherwise
+    overlap. Every function also takes an execution policy first, par splits
+    the buffer into cache-sized ranges run on the thread pool.
+*/
+namespace detail {
+constexpr std::size_t transform_chunk = 64;
+
+template <class T> constexpr bool is_affine(const Mat<4, 4, T> &m) {
+    return m.unchecked(3) == 0 && m.unchecked(7) == 0 &&
+           m.unchecked(11) == 0 && m.unchecked(15) == 1;
+}
+/**
+ * @brief Inverse transpose of the upper 3x3 embedded in a Mat4 with zero
+ * translation, it keeps normals perpendicular under non-uniform scale.
+ */
+template <class T> constexpr Mat<4, 4, T> normal_matrix(const Mat<4, 4, T> &m) {
+    const Mat<3, 3, T> n = m.to_mat3().inverse().transpose();
+    Mat<4, 4, T> result{};
+    for (unsigned int c = 0; c < 3; c++) {
+        for (unsigned int r = 0; r < 3; r++) {
+            result.unchecked(c * 4 + r) = n.unchecked(c * 3 + r);
+        }
+    }
+    result.unchecked(15) = 1;
+    return result;
+}
+/**
+ * @brief Scale every element of a SoA chunk to unit length, zero stays zero.
+ */
+template <class T> void normalize_or_zero(T *x, T *y, T *z, std::size_t n) {
+    T length[transform_chunk];
+    for (std::size_t i = 0; i < n; i++) {
+        length[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+    }
+    simd::sqrt(length, length, n);
+    for (std::size_t i = 0; i < n; i++) {
+        const T scale = (length[i] == 0) ? static_cast<T>(0) : 1 / length[i];
+        x[i] *= scale;
+        y[i] *= scale;
+        z[i] *= scale;
+    }
+}
+enum class TransformKind { point, vector, normal };
+
+/**
+ * @brief The matrix the kernel actually applies, normals use the inverse
+ * transpose which is computed once per call.
+ */
+template <TransformKind Kind, class T>
+constexpr Mat<4, 4, T> kernel_matrix(const Mat<4, 4, T> &m) {
+    if constexpr (Kind == TransformKind::normal) {
+        return normal_matrix(m);
+    } else {
+        return m;
+    }
+}
+/**
+ * @brief Elements per parallel task, a whole number of staging chunks.
+ */
+template <class T> constexpr std::size_t transform_grain() {
+    const std::size_t grain = execution::grain(6 * sizeof(T));
+    return std::max(transform_chunk, grain - grain % transform_chunk);
+}
+
+template <TransformKind Kind, class T>
+void transform_soa(const Mat<4, 4, T> &matrix, const T *x, const T *y,
+                   const T *z, T *ox, T *oy, T *oz, std::size_t n) {
+    if constexpr (Kind == TransformKind::point) {
+        if (is_affine(matrix)) {
+            simd::transform3<false>(&matrix.unchecked(0), static_cast<T>(1),
+                                    x, y, z, ox, oy, oz, n);
+        } else {
+            simd::transform3<true>(&matrix.unchecked(0), static_cast<T>(1), x,
+                                   y, z, ox, oy, oz, n);
+        }
+    } else if constexpr (Kind == TransformKind::vector) {
+        simd::transform3<false>(&matrix.unchecked(0), static_cast<T>(0), x, y,
+                                z, ox, oy, oz, n);
+    } else {
+        for (std::size_t base = 0; base < n; base += transform_chunk) {
+            const std::size_t count = std::min(transform_chunk, n - base);
+            simd::transform3<false>(&matrix.unchecked(0), static_cast<T>(0),
+                                    x + base, y + base, z + base, ox + base,
+                                    oy + base, oz + base, count);
+            normalize_or_zero(ox + base, oy + base, oz + base, count);
+        }
+    }
+}
+template <TransformKind Kind, class T>
+void transform_aos(const Mat<4, 4, T> &matrix, const T *in, T *out,
+                   std::size_t n) {
+    alignas(64) T x[transform_chunk];
+    alignas(64) T y[transform_chunk];
+    alignas(64) T z[transform_chunk];
+    for (std::size_t base = 0; base < n; base += transform_chunk) {
+        const std::size_t count = std::min(transform_chunk, n - base);
+        simd::deinterleave3(in + 3 * base, x, y, z, count);
+        transform_soa<Kind>(matrix, x, y, z, x, y, z, count);
+        simd::interleave3(x, y, z, out + 3 * base, count);
+    }
+}
+template <TransformKind Kind, class Policy, class T>
+void transform_span(Policy &&policy, const Mat<4, 4, T> &m,
+                    std::span<const Vec<3, T>> in, std::span<Vec<3, T>> out) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    // Vec<3,T> is exactly three T, so the span is one packed xyz buffer.
+    static_assert(sizeof(Vec<3, T>) == 3 * sizeof(T));
+    const T *packed_in = reinterpret_cast<const T *>(in.data());
+    T *packed_out = reinterpret_cast<T *>(out.data());
+    const Mat<4, 4, T> matrix = kernel_matrix<Kind>(m);
+    execution::for_each_range(
+        policy, in.size(), transform_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            transform_aos<Kind>(matrix, packed_in + 3 * begin,
+                                packed_out + 3 * begin, end - begin);
+        });
+}
+template <TransformKind Kind, class Policy, class T>
+void transform_array(Policy &&policy, const Mat<4, 4, T> &m,
+                     const VecArray<3, T> &in, VecArray<3, T> &out) {
+    if (&in != &out) {
+        out.resize(in.size());
+    }
+    const Mat<4, 4, T> matrix = kernel_matrix<Kind>(m);
+    const T *x = in.component(0).data();
+    const T *y = in.component(1).data();
+    const T *z = in.component(2).data();
+    T *ox = out.component(0).data();
+    T *oy = out.component(1).data();
+    T *oz = out.component(2).data();
+    execution::for_each_range(
+        policy, in.size(), transform_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            transform_soa<Kind>(matrix, x + begin, y + begin, z + begin,
+                                ox + begin, oy + begin, oz + begin,
+                                end - begin);
+        });
+}
+template <TransformKind Kind, class Policy, class T>
+void transform_padded_span(Policy &&policy, const Mat<4, 4, T> &m,
+                           std::span<const PaddedVec3<T>> in,
+                           std::span<PaddedVec3<T>> out) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    static_assert(sizeof(PaddedVec3<T>) == 4 * sizeof(T));
+    const T *packed_in = reinterpret_cast<const T *>(in.data());
+    T *packed_out = reinterpret_cast<T *>(out.data());
+    const bool project = Kind == TransformKind::point && !is_affine(m);
+    const T w = Kind == TransformKind::point ? static_cast<T>(1) : static_cast<T>(0);
+    execution::for_each_range(
+        policy, in.size(), execution::grain(8 * sizeof(T)),
+        [&](std::size_t begin, std::size_t end) {
+            if (project) {
+                simd::transform_padded<true>(&m.unchecked(0), w, packed_in + 4 * begin,
+                                             packed_out + 4 * begin, end - begin);
+            } else {
+                simd::transform_padded<false>(&m.unchecked(0), w, packed_in + 4 * begin,
+                                              packed_out + 4 * begin, end - begin);
+            }
+        });
+}
+template <class T>
+void rotate_aos(const T *q, const T *in, T *out, std::size_t n) {
+    alignas(64) T qw[transform_chunk];
+    alignas(64) T qx[transform_chunk];
+    alignas(64) T qy[transform_chunk];
+    alignas(64) T qz[transform_chunk];
+    alignas(64) T x[transform_chunk];
+    alignas(64) T y[transform_chunk];
+    alignas(64) T z[transform_chunk];
+    for (std::size_t base = 0; base < n; base += transform_chunk) {
+        const std::size_t count = std::min(transform_chunk, n - base);
+        simd::deinterleave4(q + 4 * base, qw, qx, qy, qz, count);
+        simd::deinterleave3(in + 3 * base, x, y, z, count);
+        simd::rotate3(qw, qx, qy, qz, x, y, z, x, y, z, count);
+        simd::interleave3(x, y, z, out + 3 * base, count);
+    }
+}
+template <class Policy, class T>
+void rotate_span(Policy &&policy, std::span<const Quat<T>> q,
+                 std::span<const Vec<3, T>> in, std::span<Vec<3, T>> out) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+    if (q.size() != in.size()) {
+        throw std::invalid_argument("Quaternion span size mismatched.");
+    }
+    static_assert(sizeof(Quat<T>) == 4 * sizeof(T));
+    static_assert(sizeof(Vec<3, T>) == 3 * sizeof(T));
+    const T *packed_q = reinterpret_cast<const T *>(q.data());
+    const T *packed_in = reinterpret_cast<const T *>(in.data());
+    T *packed_out = reinterpret_cast<T *>(out.data());
+    execution::for_each_range(
+        policy, in.size(), transform_grain<T>(),
+        [&](std::size_t begin, std::size_t end) {
+            rotate_aos(packed_q + 4 * begin, packed_in + 3 * begin,
+                       packed_out + 3 * begin, end - begin);
+        });
+}
+} // namespace detail
+
+/**
+ * @brief out[i] = m * (in[i], 1). A non-affine m (projection) also divides
+ * by the resulting w.
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void transform_points(Policy &&policy, const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<const Vec<3, T>>> in,
+                      std::type_identity_t<std::span<Vec<3, T>>> out) {
+    detail::transform_span<detail::TransformKind::point>(policy, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_points(Policy &&policy, const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<Vec<3, T>>> points) {
+    detail::transform_span<detail::TransformKind::point>(
+        policy, m, std::span<const Vec<3, T>>(points), points);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_points(Policy &&policy, const Mat<4, 4, T> &m,
+                      const VecArray<3, T> &in, VecArray<3, T> &out) {
+    detail::transform_array<detail::TransformKind::point>(policy, m, in, out);
+}
+template <class T>
+void transform_points(const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<const Vec<3, T>>> in,
+                      std::type_identity_t<std::span<Vec<3, T>>> out) {
+    transform_points(execution::seq, m, in, out);
+}
+template <class T>
+void transform_points(const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<Vec<3, T>>> points) {
+    transform_points(execution::seq, m, points);
+}
+template <class T>
+void transform_points(const Mat<4, 4, T> &m, const VecArray<3, T> &in,
+                      VecArray<3, T> &out) {
+    transform_points(execution::seq, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_points(Policy &&policy, const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<const PaddedVec3<T>>> in,
+                      std::type_identity_t<std::span<PaddedVec3<T>>> out) {
+    detail::transform_padded_span<detail::TransformKind::point>(policy, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_points(Policy &&policy, const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<PaddedVec3<T>>> points) {
+    detail::transform_padded_span<detail::TransformKind::point>(
+        policy, m, std::span<const PaddedVec3<T>>(points), points);
+}
+template <class T>
+void transform_points(const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<const PaddedVec3<T>>> in,
+                      std::type_identity_t<std::span<PaddedVec3<T>>> out) {
+    transform_points(execution::seq, m, in, out);
+}
+template <class T>
+void transform_points(const Mat<4, 4, T> &m,
+                      std::type_identity_t<std::span<PaddedVec3<T>>> points) {
+    transform_points(execution::seq, m, points);
+}
+
+/**
+ * @brief out[i] = m * (in[i], 0), directions ignore the translation.
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void transform_vectors(Policy &&policy, const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<const Vec<3, T>>> in,
+                       std::type_identity_t<std::span<Vec<3, T>>> out) {
+    detail::transform_span<detail::TransformKind::vector>(policy, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_vectors(Policy &&policy, const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<Vec<3, T>>> vectors) {
+    detail::transform_span<detail::TransformKind::vector>(
+        policy, m, std::span<const Vec<3, T>>(vectors), vectors);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_vectors(Policy &&policy, const Mat<4, 4, T> &m,
+                       const VecArray<3, T> &in, VecArray<3, T> &out) {
+    detail::transform_array<detail::TransformKind::vector>(policy, m, in, out);
+}
+template <class T>
+void transform_vectors(const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<const Vec<3, T>>> in,
+                       std::type_identity_t<std::span<Vec<3, T>>> out) {
+    transform_vectors(execution::seq, m, in, out);
+}
+template <class T>
+void transform_vectors(const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<Vec<3, T>>> vectors) {
+    transform_vectors(execution::seq, m, vectors);
+}
+template <class T>
+void transform_vectors(const Mat<4, 4, T> &m, const VecArray<3, T> &in,
+                       VecArray<3, T> &out) {
+    transform_vectors(execution::seq, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_vectors(Policy &&policy, const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<const PaddedVec3<T>>> in,
+                       std::type_identity_t<std::span<PaddedVec3<T>>> out) {
+    detail::transform_padded_span<detail::TransformKind::vector>(policy, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_vectors(Policy &&policy, const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<PaddedVec3<T>>> vectors) {
+    detail::transform_padded_span<detail::TransformKind::vector>(
+        policy, m, std::span<const PaddedVec3<T>>(vectors), vectors);
+}
+template <class T>
+void transform_vectors(const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<const PaddedVec3<T>>> in,
+                       std::type_identity_t<std::span<PaddedVec3<T>>> out) {
+    transform_vectors(execution::seq, m, in, out);
+}
+template <class T>
+void transform_vectors(const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<PaddedVec3<T>>> vectors) {
+    transform_vectors(execution::seq, m, vectors);
+}
+
+/**
+ * @brief out[i] = normalize_or_zero(transpose(inverse(A)) * in[i]) with A
+ * the upper 3x3 of m.
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void transform_normals(Policy &&policy, const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<const Vec<3, T>>> in,
+                       std::type_identity_t<std::span<Vec<3, T>>> out) {
+    detail::transform_span<detail::TransformKind::normal>(policy, m, in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_normals(Policy &&policy, const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<Vec<3, T>>> normals) {
+    detail::transform_span<detail::TransformKind::normal>(
+        policy, m, std::span<const Vec<3, T>>(normals), normals);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void transform_normals(Policy &&policy, const Mat<4, 4, T> &m,
+                       const VecArray<3, T> &in, VecArray<3, T> &out) {
+    detail::transform_array<detail::TransformKind::normal>(policy, m, in, out);
+}
+template <class T>
+void transform_normals(const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<const Vec<3, T>>> in,
+                       std::type_identity_t<std::span<Vec<3, T>>> out) {
+    transform_normals(execution::seq, m, in, out);
+}
+template <class T>
+void transform_normals(const Mat<4, 4, T> &m,
+                       std::type_identity_t<std::span<Vec<3, T>>> normals) {
+    transform_normals(execution::seq, m, normals);
+}
+template <class T>
+void transform_normals(const Mat<4, 4, T> &m, const VecArray<3, T> &in,
+                       VecArray<3, T> &out) {
+    transform_normals(execution::seq, m, in, out);
+}
+
+/**
+ * @brief out[i] = q.rotate(in[i]) for a unit q, applied through its
+ * rotation matrix.
+ */
+template <execution::ExecutionPolicy Policy, class T>
+void rotate_vectors(Policy &&policy, const Quat<T> &q,
+                    std::type_identity_t<std::span<const Vec<3, T>>> in,
+                    std::type_identity_t<std::span<Vec<3, T>>> out) {
+    transform_vectors(policy, q.to_mat4(), in, out);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void rotate_vectors(Policy &&policy, const Quat<T> &q,
+                    std::type_identity_t<std::span<Vec<3, T>>> vectors) {
+    transform_vectors(policy, q.to_mat4(), vectors);
+}
+template <execution::ExecutionPolicy Policy, class T>
+void rotate_vectors(Policy &&policy, const Quat<T> &q, const VecArray<3, T> &in,
+                    VecArray<3, T> &out) {
+    transform_vectors(policy, q.to_mat4(), in, out);
+}
+/**
+ * @brief out[i] = q[i].rotate(in[i]), every q[i] must be a unit quaternion.
+ */
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void rotate_vectors(
+    Policy &&policy, const Quats &q,
+    std::span<const Vec<3, detail::quat_scalar_t<Quats>>> in,
+    std::span<Vec<3, detail::quat_scalar_t<Quats>>> out) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::rotate_span(policy, std::span<const Quat<T>>(q), in, out);
+}
+template <execution::ExecutionPolicy Policy, QuatRange Quats>
+void rotate_vectors(
+    Policy &&policy, const Quats &q,
+    std::span<Vec<3, detail::quat_scalar_t<Quats>>> vectors) {
+    using T = detail::quat_scalar_t<Quats>;
+    detail::rotate_span(policy, std::span<const Quat<T>>(q),
+                        std::span<const Vec<3, T>>(vectors), vectors);
+}
+template <class T>
+void rotate_vectors(const Quat<T> &q,
+                    std::type_identity_t<std::span<const Vec<3, T>>> in,
+                    std::type_identity_t<std::span<Vec<3, T>>> out) {
+    rotate_vectors(execution::seq, q, in, out);
+}
+template <class T>
+void rotate_vectors(const Quat<T> &q,
+                    std::type_identity_t<std::span<Vec<3, T>>> vectors) {
+    rotate_vectors(execution::seq, q, vectors);
+}
+template <class T>
+void rotate_vectors(const Quat<T> &q, const VecArray<3, T> &in,
+                    VecArray<3, T> &out) {
+    rotate_vectors(execution::seq, q, in, out);
+}
+template <QuatRange Quats>
+void rotate_vectors(
+    const Quats &q,
+    std::span<const Vec<3, detail::quat_scalar_t<Quats>>> in,
+    std::span<Vec<3, detail::quat_scalar_t<Quats>>> out) {
+    rotate_vectors(execution::seq, q, in, out);
+}
+template <QuatRange Quats>
+void rotate_vectors(
+    const Quats &q,
+    std::span<Vec<3, detail::quat_scalar_t<Quats>>> vectors) {
+    rotate_vectors(execution::seq, q, vectors);
+}
+} // namespace smath
+#endif // SMATH_TRANSFORM_HPP
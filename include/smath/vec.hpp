@@ -8,9 +8,30 @@
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
-#include <cstring>
+#include "config.hpp"
+#include "expr.hpp"
+#include "simd.hpp"
 
 namespace smath {
+/**
+ * @brief Sine and cosine of one angle.
+ */
+template <class T> struct SinCos {
+    T sin;
+    T cos;
+};
+/**
+ * @brief std::sin and std::cos of radian side by side, so the compiler
+ * fuses them into one sincos call sharing the argument reduction. There is
+ * no precise form over arrays, fast::sincos over spans (vec_array.hpp) is
+ * the batched one and carries the fast:: error bounds.
+ */
+template <class T>
+    requires(std::is_arithmetic_v<T>)
+constexpr SinCos<T> sincos(const T &radian) {
+    return {static_cast<T>(std::sin(radian)), static_cast<T>(std::cos(radian))};
+}
+
 template <unsigned int N, class T>
     requires(std::is_arithmetic_v<T> && N <= 32)
 class Vec {
@@ -21,19 +42,21 @@ class Vec {
     /***************************************
             Constructors
     ****************************************/
-    Vec() : data{} {};
+    constexpr Vec() : data{} {};
 
 
     template <class... Us>
         requires(sizeof...(Us) == N && (std::convertible_to<Us, T> && ...))
-    Vec(Us... args) : data{static_cast<T>(args)...} {}
-    Vec(T value) {
+    constexpr Vec(Us... args) : data{static_cast<T>(args)...} {}
+    constexpr Vec(T value) : data{} {
         for(unsigned int i = 0; i< N; i++){
             data[i] = value;
         }
     }
-    explicit Vec(const T *arr) {
-        std::memcpy(this->data, arr, N*(sizeof(T)));
+    explicit constexpr Vec(const T *arr) : data{} {
+        for (unsigned int i = 0; i < N; i++) {
+            data[i] = arr[i];
+        }
     }
     // Copy constructor
     Vec(const Vec &other) = default;
@@ -45,11 +68,50 @@ class Vec {
     Vec &operator=(Vec<N, T> &&other) noexcept = default;
 
     // Initializer list
-    Vec(std::initializer_list<T> values) {
+    constexpr Vec(std::initializer_list<T> values) : data{} {
         if(values.size()!=N){
             throw std::invalid_argument("Number of values mismatched target vector size.");
         }
-        std::memcpy(data,values.begin(),sizeof(T)*N);
+        unsigned int i = 0;
+        for (const T &value : values) {
+            data[i++] = value;
+        }
+    }
+    /**
+     * @brief Materialise a lazy expression (see expr.hpp) in a single loop.
+     */
+    template <VecExpression E>
+        requires(E::size == N)
+    constexpr Vec(const E &expr) : data{} {
+        for (unsigned int i = 0; i < N; i++) {
+            data[i] = static_cast<T>(expr.eval(i));
+        }
+    }
+    template <VecExpression E>
+        requires(E::size == N)
+    constexpr Vec &operator=(const E &expr) {
+        // Element i of an expression only reads element i of its operands, so
+        // this vector may appear inside the expression.
+        for (unsigned int i = 0; i < N; i++) {
+            data[i] = static_cast<T>(expr.eval(i));
+        }
+        return *this;
+    }
+    template <VecExpression E>
+        requires(E::size == N)
+    constexpr Vec &operator+=(const E &expr) {
+        for (unsigned int i = 0; i < N; i++) {
+            data[i] += static_cast<T>(expr.eval(i));
+        }
+        return *this;
+    }
+    template <VecExpression E>
+        requires(E::size == N)
+    constexpr Vec &operator-=(const E &expr) {
+        for (unsigned int i = 0; i < N; i++) {
+            data[i] -= static_cast<T>(expr.eval(i));
+        }
+        return *this;
     }
     /***************************************
             Getters
@@ -60,9 +122,11 @@ class Vec {
      * @param i zero-based index
      * @return data[i]
      */
-    T &operator[](int i) {
+    constexpr T &operator[](int i) {
+#if SMATH_CHECKED
         if (i < 0 || i > N - 1)
             throw std::out_of_range("Index out of bound");
+#endif
         return data[i];
     }
     /**
@@ -70,11 +134,27 @@ class Vec {
      * @param i zero-based index
      * @return data[i]
      */
-    const T &operator[](int i) const {
+    constexpr const T &operator[](int i) const {
+#if SMATH_CHECKED
         if (i < 0 || i > N - 1)
             throw std::out_of_range("Index out of bound");
+#endif
         return data[i];
     }
+    /**
+     * @brief Element access without bounds checking, regardless of
+     * SMATH_CHECKED.
+     * @param i zero-based index
+     * @return data[i]
+     */
+    constexpr T &unchecked(unsigned int i) { return data[i]; }
+    /**
+     * @brief Element access without bounds checking, regardless of
+     * SMATH_CHECKED.
+     * @param i zero-based index
+     * @return data[i]
+     */
+    constexpr const T &unchecked(unsigned int i) const { return data[i]; }
     /**
      * @return String representation of vector.
      */
@@ -90,11 +170,42 @@ class Vec {
     }
 
     /**
-     * @brief Swizzling-like accessor.
+     * @brief Swizzling-like accessor with runtime indices, every index goes
+     * through operator[]. Prefer swizzle<...>() when they are constants.
      */
-    auto operator[](const unsigned int index, auto... indices) const requires(sizeof...(indices)>0){
+    constexpr auto operator[](const unsigned int index, auto... indices) const requires(sizeof...(indices)>0){
         return Vec<sizeof...(indices)+1, T>{(*this)[index], (*this)[indices]...};
     }
+    /**
+     * @brief Compile-time swizzle, swizzle<2, 0, 1>() is (z, x, y). Indices
+     * are validated by the constraint, and a Vec4 result is a single shuffle
+     * where simd::shuffle_accelerated allows it.
+     */
+    template <unsigned int... I>
+        requires(sizeof...(I) > 0 && sizeof...(I) <= 32 && ((I < N) && ...))
+    constexpr Vec<sizeof...(I), T> swizzle() const {
+        if constexpr (simd::shuffle_accelerated<N, sizeof...(I), T>) {
+            if !consteval {
+                Vec<sizeof...(I), T> result;
+                simd::swizzle<N, T, I...>(data, &result.unchecked(0));
+                return result;
+            }
+        }
+        return Vec<sizeof...(I), T>(data[I]...);
+    }
+    /**
+     * @brief Named components, only those the vector has.
+     */
+    constexpr T &x() { return data[0]; }
+    constexpr const T &x() const { return data[0]; }
+    constexpr T &y() requires(N > 1) { return data[1]; }
+    constexpr const T &y() const requires(N > 1) { return data[1]; }
+    constexpr T &z() requires(N > 2) { return data[2]; }
+    constexpr const T &z() const requires(N > 2) { return data[2]; }
+    constexpr T &w() requires(N > 3) { return data[3]; }
+    constexpr const T &w() const requires(N > 3) { return data[3]; }
+    constexpr Vec<2, T> xy() const requires(N > 1) { return swizzle<0, 1>(); }
+    constexpr Vec<3, T> xyz() const requires(N > 2) { return swizzle<0, 1, 2>(); }
     /***************************************
             Operations
     ****************************************/
@@ -102,7 +213,12 @@ class Vec {
     /**
      * @return Length of the vector.
      */
-    T length() const {
+    constexpr T length() const {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                return std::sqrt(simd::dot<N>(data, data));
+            }
+        }
         T len = 0;
         for (unsigned int i = 0; i < N; i++) {
             len += data[i] * data[i];
@@ -112,7 +228,12 @@ class Vec {
     /**
      * @return Squared length of the vector.
      */
-    T length2() const {
+    constexpr T length2() const {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                return simd::dot<N>(data, data);
+            }
+        }
         T len = 0;
         for (int i = 0; i < N; i++) {
             len += data[i] * data[i];
@@ -122,61 +243,91 @@ class Vec {
     /**
      * @return Classic Cross Product.
      */
-    Vec<3, T> cross(const Vec<3, T> &other) const requires (N==3) {
-        return Vec<3, T>{(*this)[1] * other[2] - (*this)[2] * other[1],
-                         -(*this)[0] * other[2] + (*this)[2] * other[0],
-                         (*this)[0] * other[1] - (*this)[1] * other[0]};
+    constexpr Vec<3, T> cross(const Vec<3, T> &other) const requires (N==3) {
+        if constexpr (simd::Kernel<3, T>::has_cross) {
+            if !consteval {
+                Vec<3, T> result{};
+                simd::cross(data, other.data, result.data);
+                return result;
+            }
+        }
+        return Vec<3, T>{data[1] * other.data[2] - data[2] * other.data[1],
+                         -data[0] * other.data[2] + data[2] * other.data[0],
+                         data[0] * other.data[1] - data[1] * other.data[0]};
     }
     /**
      * @return Classic Dot Product.
      */
-    T dot(const Vec<N, T> &other) const {
+    constexpr T dot(const Vec<N, T> &other) const {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                return simd::dot<N>(data, other.data);
+            }
+        }
         T total = 0;
         for (unsigned int i = 0; i < N; i++) {
-            total += (*this)[i] * other[i];
+            total += data[i] * other.data[i];
         }
         return total;
     }
-    Vec<N+1,T> expand(const T& value) const {
+    constexpr auto expand(const T& value) const requires (N < 32) {
         Vec<N+1,T> result{};
-        std::memcpy(result->data, this->data, N*sizeof(T));
-        result[N]=value;
+        for (unsigned int i = 0; i < N; i++) {
+            result.unchecked(i) = data[i];
+        }
+        result.unchecked(N) = value;
         return result;
     }
     template <unsigned int M>
-    Vec<N+M,T> combine(const Vec<M,T> other) const {
+    constexpr Vec<N+M,T> combine(const Vec<M,T> other) const {
         Vec<N+M,T> result{};
-        std::memcpy(result->data, this->data, N*sizeof(T));
-        std::memcpy(result->data+N*sizeof(T), other.data, M*sizeof(T));
+        for (unsigned int i = 0; i < N; i++) {
+            result.unchecked(i) = data[i];
+        }
+        for (unsigned int i = 0; i < M; i++) {
+            result.unchecked(N + i) = other.unchecked(i);
+        }
         return result;
     }
     /**
      * @return Normalized Vector of the operand. Raise error when encounter a zero-vector
      */
-    Vec<N, T> normalize() const {
+    constexpr Vec<N, T> normalize() const {
         Vec<N, T> temp{};
         const T length = this->length();
         if (length == 0)
             throw std::logic_error("Cannot normalize a zero-vector.");
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::div_scalar<N>(data, length, temp.data);
+                return temp;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            temp[i] = (*this)[i] / length;
+            temp.data[i] = data[i] / length;
         }
         return temp;
     }
     /**
      * @return Normalized Vector of the operand. Return zero-vector on zero-vector.
      */
-    Vec<N, T> normalize_or_zero() const {
+    constexpr Vec<N, T> normalize_or_zero() const {
         Vec<N, T> temp{};
         const T length = this->length();
         if (length == 0)
             return Vec<N, T>{0, 0, 0};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::div_scalar<N>(data, length, temp.data);
+                return temp;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            temp[i] = (*this)[i] / length;
+            temp.data[i] = data[i] / length;
         }
         return temp;
     }
-    T angle(const Vec<N, T> other) const {
+    constexpr T angle(const Vec<N, T> other) const {
         return std::acos(this->dot(other) / (this->length() * other.length()));
     }
 
@@ -184,7 +335,7 @@ class Vec {
      * @brief Defined only for vec3.
      * @return Projection on target Vector.
      */
-    Vec<3, T> project(const Vec<3, T> other) const requires (N==3) {
+    constexpr Vec<3, T> project(const Vec<3, T> other) const requires (N==3) {
         return other * (this->dot(other) / other.length2());
     }
 
@@ -192,28 +343,29 @@ class Vec {
      * @brief Vector rotation based on Rodrigues' rotation formula.
      * @return Rotation on input axis by input radian.
      */
-    Vec<3, T> rotate(const T &radian, const Vec<3, T> axis = {0, 0, 1}) const requires (N==3) {
-        Vec<3, T> n = axis.normalize();
-
-        return (1 - std::cos(radian)) * (n.dot((*this)) * (n)) +
-               std::cos(radian) * (*this) + std::sin(radian) * (this->cross(n));
+    constexpr Vec<3, T> rotate(const T &radian, const Vec<3, T> axis = {0, 0, 1}) const requires (N==3) {
+        const Vec<3, T> n = axis.normalize();
+        const Vec<3, T> n_cross = this->cross(n);
+        const auto [s, c] = sincos(radian);
+        return lazy(n) * ((1 - c) * n.dot(*this)) + lazy(*this) * c +
+               lazy(n_cross) * s;
     }
 
-    bool all() const{
+    constexpr bool all() const{
         for (unsigned int i = 0; i<N; i++){
             if(!data[i])
                 return false;
         }
         return true;
     }
-    bool any() const{
+    constexpr bool any() const{
         for (unsigned int i = 0; i<N; i++){
             if(data[i])
                 return true;
         }
         return false;
     }
-    bool none() const{
+    constexpr bool none() const{
         return !any();
     }
     /***************************************
@@ -224,9 +376,9 @@ class Vec {
      * @brief Custom boolean casting for vector. This require the element in the Vec to be able to convert to bool.
      * @return True if and only if all vector elements are True.
      */
-    explicit operator bool() const {
+    explicit constexpr operator bool() const {
         for (unsigned int i = 0; i < N; i++) {
-            if (!(*this)[i])
+            if (!data[i])
                 return false;
         }
         return true;
@@ -234,104 +386,176 @@ class Vec {
     /**
      * @brief Unary - operator, simply flip all element.
      */
-    friend Vec<N, T> operator-(const Vec<N, T> &a) {
+    friend constexpr Vec<N, T> operator-(const Vec<N, T> &a) {
         Vec<N, T> result{};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::neg<N>(a.data, result.data);
+                return result;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = -a[i];
+            result.data[i] = -a.data[i];
         }
         return result;
     }
 
-    friend Vec<N, T> operator+(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, T> operator+(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, T> result{};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::add<N>(a.data, b.data, result.data);
+                return result;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = a[i] + b[i];
+            result.data[i] = a.data[i] + b.data[i];
         }
         return result;
     };
-    friend Vec<N, T> operator-(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, T> operator-(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, T> result{};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::sub<N>(a.data, b.data, result.data);
+                return result;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = a[i] - b[i];
+            result.data[i] = a.data[i] - b.data[i];
         }
         return result;
     }
-    friend Vec<N, T> operator*(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, T> operator*(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, T> result{};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::mul<N>(a.data, b.data, result.data);
+                return result;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = a[i] * b[i];
+            result.data[i] = a.data[i] * b.data[i];
         }
         return result;
     }
-    friend Vec<N, T> operator*(const Vec<N, T> &a, const T &b) {
+    friend constexpr Vec<N, T> operator*(const Vec<N, T> &a, const T &b) {
         Vec<N, T> result{};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::scale<N>(a.data, b, result.data);
+                return result;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = a[i] * b;
+            result.data[i] = a.data[i] * b;
         }
         return result;
     }
-    friend Vec<N, T> operator*(const T &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, T> operator*(const T &a, const Vec<N, T> &b) {
         Vec<N, T> result{};
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::scale<N>(b.data, a, result.data);
+                return result;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = a * b[i];
+            result.data[i] = a * b.data[i];
         }
         return result;
     }
-    friend Vec<N, T> operator/(const Vec<N, T> &a, const T &b) {
+    friend constexpr Vec<N, T> operator/(const Vec<N, T> &a, const T &b) {
         return a * (1 / b);
     }
-    friend Vec<N, T> operator%(const Vec<N, T> &a, const T &b) {
+    friend constexpr Vec<N, T> operator%(const Vec<N, T> &a, const T &b) {
         Vec<N, T> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = a[i] % b;
+            result.data[i] = a.data[i] % b;
         }
         return result;
     }
-    Vec<N, T> &operator+=(const Vec<N, T> &other) {
+    constexpr Vec<N, T> &operator+=(const Vec<N, T> &other) {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::add<N>(data, other.data, data);
+                return *this;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] += other[i];
+            data[i] += other.data[i];
         }
         return *this;
     };
-    Vec<N, T> &operator-=(const Vec<N, T> &other) {
+    constexpr Vec<N, T> &operator-=(const Vec<N, T> &other) {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::sub<N>(data, other.data, data);
+                return *this;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] -= other[i];
+            data[i] -= other.data[i];
         }
         return *this;
     };
-    Vec<N, T> &operator*=(const Vec<N, T> &other) {
+    constexpr Vec<N, T> &operator*=(const Vec<N, T> &other) {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::mul<N>(data, other.data, data);
+                return *this;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] *= other[i];
+            data[i] *= other.data[i];
         }
         return *this;
     };
-    Vec<N, T> &operator*=(const T &other) {
+    constexpr Vec<N, T> &operator*=(const T &other) {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::scale<N>(data, other, data);
+                return *this;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] *= other;
+            data[i] *= other;
         }
         return *this;
     };
-    Vec<N, T> &operator/=(const Vec<N, T> &other) {
+    constexpr Vec<N, T> &operator/=(const Vec<N, T> &other) {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::div<N>(data, other.data, data);
+                return *this;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] /= other[i];
+            data[i] /= other.data[i];
         }
         return *this;
     };
-    Vec<N, T> &operator/=(const T &other) {
+    constexpr Vec<N, T> &operator/=(const T &other) {
+        if constexpr (simd::accelerated<N, T>) {
+            if !consteval {
+                simd::div_scalar<N>(data, other, data);
+                return *this;
+            }
+        }
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] /= other;
+            data[i] /= other;
         }
         return *this;
     };
-    Vec<N, T> &operator%=(const Vec<N, T> &other) {
+    constexpr Vec<N, T> &operator%=(const Vec<N, T> &other) {
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] %= other[i];
+            data[i] %= other.data[i];
         }
         return *this;
     };
-    Vec<N, T> &operator%=(const T &other) {
+    constexpr Vec<N, T> &operator%=(const T &other) {
         for (unsigned int i = 0; i < N; i++) {
-            (*this)[i] %= other;
+            data[i] %= other;
         }
         return *this;
     };
@@ -339,59 +563,59 @@ class Vec {
     /***************************************
             Relational Operators
     ****************************************/
-    friend Vec<N, unsigned int> operator==(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, unsigned int> operator==(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i] == b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] == b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Vec<N, unsigned int> operator!=(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, unsigned int> operator!=(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i] != b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] != b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Vec<N, unsigned int> operator<(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, unsigned int> operator<(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i] < b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] < b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Vec<N, unsigned int> operator>(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, unsigned int> operator>(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i] > b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] > b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Vec<N, unsigned int> operator<=(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, unsigned int> operator<=(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i] <= b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] <= b.data[i]) ? 1 : 0;
         }
         return result;
     }
-    friend Vec<N, unsigned int> operator>=(const Vec<N, T> &a, const Vec<N, T> &b) {
+    friend constexpr Vec<N, unsigned int> operator>=(const Vec<N, T> &a, const Vec<N, T> &b) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i] >= b[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i] >= b.data[i]) ? 1 : 0;
         }
         return result;
     }
     friend bool operator!(const Vec<N, T> &a) {
         Vec<N, unsigned int> result{};
         for (unsigned int i = 0; i < N; i++) {
-            result[i] = (a[i]) ? 1 : 0;
+            result.unchecked(i) = (a.data[i]) ? 1 : 0;
         }
         return result;
     }
     friend std::ostream &operator<<(std::ostream &o, const Vec<N, T> &vec) {
         o << "Vec" << N << "<";
         for (int i = 0; i < N; i++) {
-            o << vec[i];
+            o << vec.data[i];
             if (i != N - 1) {
                 o << ", ";
             }
@@ -412,5 +636,25 @@ using Vec4u = Vec<4, unsigned int>;
 using Vec4f = Vec<4, float>;
 using Vec4d = Vec<4, double>;
 using Vec4b = Vec<4, bool>;
+
+namespace fast {
+/**
+ * @brief vec scaled by fast::rsqrt of its squared length. No zero check, a
+ * zero vector gives non-finite components.
+ */
+template <unsigned int N, std::floating_point T>
+constexpr Vec<N, T> normalize(const Vec<N, T> &vec) {
+    return vec * fast::rsqrt(vec.length2());
+}
+/**
+ * @brief Vec::angle through fast::rsqrt and fast::acos, the cosine clamped
+ * to [-1, 1] against rounding.
+ */
+template <unsigned int N, std::floating_point T>
+constexpr T angle(const Vec<N, T> &a, const Vec<N, T> &b) {
+    const T cosine = a.dot(b) * fast::rsqrt(a.length2() * b.length2());
+    return fast::acos(cosine > 1 ? T(1) : (cosine < -1 ? T(-1) : cosine));
+}
+} // namespace fast
 } // namespace smath
 #endif // SMATH_VEC3_HPP
@@ -0,0 +1,538 @@
+#ifndef SMATH_VEC_ARRAY_HPP
+#define SMATH_VEC_ARRAY_HPP
+
+#include "config.hpp"
+#include "execution.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace smath {
+/*
+    Structure-of-arrays container for many Vec<N,T>.
+    Component c of every element lives in its own contiguous buffer:
+    [x0,x1,x2,...] [y0,y1,y2,...] [z0,z1,z2,...]
+    so bulk operations are plain loops over N arrays, which the compiler
+    turns into packed SIMD instructions.
+*/
+template <unsigned int N, class T>
+    requires(std::is_arithmetic_v<T> && N <= 32)
+class VecArray {
+  private:
+    std::array<std::vector<T>, N> components{};
+    std::size_t count = 0;
+
+    void check_size(const VecArray<N, T> &other) const {
+        if (other.count != count) {
+            throw std::invalid_argument("VecArray sizes mismatched.");
+        }
+    }
+
+    /**
+     * @brief out[i - begin] = dot of element i, for i in [begin, end).
+     */
+    void dot_range(const VecArray<N, T> &other, T *SMATH_RESTRICT out,
+                   std::size_t begin, std::size_t end) const {
+        const std::size_t n = end - begin;
+        for (std::size_t i = 0; i < n; i++) {
+            out[i] = 0;
+        }
+        for (unsigned int c = 0; c < N; c++) {
+            const T *a = components[c].data() + begin;
+            const T *b = other.components[c].data() + begin;
+            for (std::size_t i = 0; i < n; i++) {
+                out[i] += a[i] * b[i];
+            }
+        }
+    }
+    void normalize_range(VecArray<N, T> &result, std::size_t begin,
+                         std::size_t end) const {
+        std::vector<T> scale(end - begin);
+        T *SMATH_RESTRICT s = scale.data();
+        dot_range(*this, s, begin, end);
+        simd::sqrt(s, s, end - begin);
+        for (std::size_t i = 0; i < end - begin; i++) {
+            s[i] = (s[i] == 0) ? static_cast<T>(0) : 1 / s[i];
+        }
+        for (unsigned int c = 0; c < N; c++) {
+            const T *SMATH_RESTRICT in = components[c].data() + begin;
+            T *SMATH_RESTRICT out = result.components[c].data() + begin;
+            for (std::size_t i = 0; i < end - begin; i++) {
+                out[i] = in[i] * s[i];
+            }
+        }
+    }
+
+  public:
+    /***************************************
+            Constructors
+    ****************************************/
+    VecArray() = default;
+    explicit VecArray(std::size_t size, const Vec<N, T> &value = Vec<N, T>{})
+        : count(size) {
+        for (unsigned int c = 0; c < N; c++) {
+            components[c].assign(size, value.unchecked(c));
+        }
+    }
+    /**
+     * @brief Build from an array-of-structs span.
+     */
+    explicit VecArray(std::span<const Vec<N, T>> aos) { from_aos(aos); }
+    // Copy constructor
+    VecArray(const VecArray &other) = default;
+    // Move constructor
+    VecArray(VecArray &&other) noexcept = default;
+    // Copy assignment
+    VecArray &operator=(const VecArray &other) = default;
+    // Move assignment
+    VecArray &operator=(VecArray &&other) noexcept = default;
+
+    /***************************************
+            Getters
+    ****************************************/
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    /**
+     * @brief Gather element i into a Vec.
+     */
+    Vec<N, T> operator[](std::size_t i) const {
+#if SMATH_CHECKED
+        if (i >= count)
+            throw std::out_of_range("Index out of bound");
+#endif
+        Vec<N, T> result{};
+        for (unsigned int c = 0; c < N; c++) {
+            result.unchecked(c) = components[c][i];
+        }
+        return result;
+    }
+    /**
+     * @brief Scatter a Vec into element i.
+     */
+    void set(std::size_t i, const Vec<N, T> &value) {
+#if SMATH_CHECKED
+        if (i >= count)
+            throw std::out_of_range("Index out of bound");
+#endif
+        for (unsigned int c = 0; c < N; c++) {
+            components[c][i] = value.unchecked(c);
+        }
+    }
+    /**
+     * @return Contiguous view over component c of every element.
+     */
+    std::span<T> component(unsigned int c) {
+        return std::span<T>(components[c].data(), count);
+    }
+    std::span<const T> component(unsigned int c) const {
+        return std::span<const T>(components[c].data(), count);
+    }
+
+    /***************************************
+            Size Management
+    ****************************************/
+    void reserve(std::size_t capacity) {
+        for (auto &component : components) {
+            component.reserve(capacity);
+        }
+    }
+    void resize(std::size_t size, const Vec<N, T> &value = Vec<N, T>{}) {
+        for (unsigned int c = 0; c < N; c++) {
+            components[c].resize(size, value.unchecked(c));
+        }
+        count = size;
+    }
+    void push_back(const Vec<N, T> &value) {
+        for (unsigned int c = 0; c < N; c++) {
+            components[c].push_back(value.unchecked(c));
+        }
+        count++;
+    }
+    void clear() { resize(0); }
+
+    /***************************************
+            AoS Conversion
+    ****************************************/
+    /**
+     * @brief Replace the content with an array-of-structs span.
+     */
+    void from_aos(std::span<const Vec<N, T>> aos) {
+        resize(aos.size());
+        for (unsigned int c = 0; c < N; c++) {
+            T *SMATH_RESTRICT out = components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] = aos[i].unchecked(c);
+            }
+        }
+    }
+    /**
+     * @brief Write the content into an array-of-structs span of equal size.
+     */
+    void to_aos(std::span<Vec<N, T>> aos) const {
+        if (aos.size() != count) {
+            throw std::invalid_argument("Output span size mismatched.");
+        }
+        for (unsigned int c = 0; c < N; c++) {
+            const T *SMATH_RESTRICT in = components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                aos[i].unchecked(c) = in[i];
+            }
+        }
+    }
+    std::vector<Vec<N, T>> to_aos() const {
+        std::vector<Vec<N, T>> aos(count);
+        to_aos(std::span<Vec<N, T>>(aos));
+        return aos;
+    }
+
+    /***************************************
+            Bulk Operations
+    ****************************************/
+    /**
+     * @return Dot product of every pair of elements.
+     */
+    template <execution::ExecutionPolicy Policy>
+    std::vector<T> dot(Policy &&policy, const VecArray<N, T> &other) const {
+        check_size(other);
+        std::vector<T> result(count);
+        execution::for_each_range(
+            policy, count, execution::grain((2 * N + 1) * sizeof(T)),
+            [&](std::size_t begin, std::size_t end) {
+                dot_range(other, result.data() + begin, begin, end);
+            });
+        return result;
+    }
+    std::vector<T> dot(const VecArray<N, T> &other) const {
+        return dot(execution::seq, other);
+    }
+    /**
+     * @return Squared length of every element.
+     */
+    template <execution::ExecutionPolicy Policy>
+    std::vector<T> length2(Policy &&policy) const {
+        return dot(policy, *this);
+    }
+    std::vector<T> length2() const { return dot(*this); }
+    /**
+     * @return Length of every element.
+     */
+    template <execution::ExecutionPolicy Policy>
+    std::vector<T> length(Policy &&policy) const {
+        std::vector<T> result(count);
+        execution::for_each_range(
+            policy, count, execution::grain((N + 1) * sizeof(T)),
+            [&](std::size_t begin, std::size_t end) {
+                dot_range(*this, result.data() + begin, begin, end);
+                simd::sqrt(result.data() + begin, result.data() + begin,
+                           end - begin);
+            });
+        return result;
+    }
+    std::vector<T> length() const { return length(execution::seq); }
+    /**
+     * @return Classic Cross Product of every pair of elements.
+     */
+    VecArray<3, T> cross(const VecArray<3, T> &other) const
+        requires(N == 3)
+    {
+        check_size(other);
+        VecArray<3, T> result(count);
+        const T *SMATH_RESTRICT ax = components[0].data();
+        const T *SMATH_RESTRICT ay = components[1].data();
+        const T *SMATH_RESTRICT az = components[2].data();
+        const T *SMATH_RESTRICT bx = other.components[0].data();
+        const T *SMATH_RESTRICT by = other.components[1].data();
+        const T *SMATH_RESTRICT bz = other.components[2].data();
+        T *SMATH_RESTRICT rx = result.components[0].data();
+        T *SMATH_RESTRICT ry = result.components[1].data();
+        T *SMATH_RESTRICT rz = result.components[2].data();
+        for (std::size_t i = 0; i < count; i++) {
+            rx[i] = ay[i] * bz[i] - az[i] * by[i];
+            ry[i] = -ax[i] * bz[i] + az[i] * bx[i];
+            rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+        }
+        return result;
+    }
+    /**
+     * @return Normalized copy. Return zero-vector on zero-vector.
+     */
+    template <execution::ExecutionPolicy Policy>
+    VecArray<N, T> normalize_or_zero(Policy &&policy) const {
+        VecArray<N, T> result(count);
+        execution::for_each_range(
+            policy, count, execution::grain((2 * N + 1) * sizeof(T)),
+            [&](std::size_t begin, std::size_t end) {
+                normalize_range(result, begin, end);
+            });
+        return result;
+    }
+    VecArray<N, T> normalize_or_zero() const {
+        return normalize_or_zero(execution::seq);
+    }
+    /**
+     * @return Normalized copy. Raise error when any element is a zero-vector.
+     */
+    template <execution::ExecutionPolicy Policy>
+    VecArray<N, T> normalize(Policy &&policy) const {
+        const std::vector<T> lengths = length2(policy);
+        bool has_zero = false;
+        for (std::size_t i = 0; i < count; i++) {
+            has_zero |= (lengths[i] == 0);
+        }
+        if (has_zero)
+            throw std::logic_error("Cannot normalize a zero-vector.");
+        return normalize_or_zero(policy);
+    }
+    VecArray<N, T> normalize() const { return normalize(execution::seq); }
+
+    /***************************************
+            Operators Overload
+    ****************************************/
+    VecArray<N, T> &operator+=(const VecArray<N, T> &other) {
+        check_size(other);
+        for (unsigned int c = 0; c < N; c++) {
+            T *out = components[c].data();
+            const T *in = other.components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] += in[i];
+            }
+        }
+        return *this;
+    }
+    VecArray<N, T> &operator-=(const VecArray<N, T> &other) {
+        check_size(other);
+        for (unsigned int c = 0; c < N; c++) {
+            T *out = components[c].data();
+            const T *in = other.components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] -= in[i];
+            }
+        }
+        return *this;
+    }
+    VecArray<N, T> &operator*=(const VecArray<N, T> &other) {
+        check_size(other);
+        for (unsigned int c = 0; c < N; c++) {
+            T *out = components[c].data();
+            const T *in = other.components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] *= in[i];
+            }
+        }
+        return *this;
+    }
+    VecArray<N, T> &operator*=(const T &other) {
+        for (unsigned int c = 0; c < N; c++) {
+            T *SMATH_RESTRICT out = components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] *= other;
+            }
+        }
+        return *this;
+    }
+    VecArray<N, T> &operator/=(const T &other) {
+        for (unsigned int c = 0; c < N; c++) {
+            T *SMATH_RESTRICT out = components[c].data();
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] /= other;
+            }
+        }
+        return *this;
+    }
+    /**
+     * @brief Add the same Vec to every element.
+     */
+    VecArray<N, T> &operator+=(const Vec<N, T> &other) {
+        for (unsigned int c = 0; c < N; c++) {
+            T *SMATH_RESTRICT out = components[c].data();
+            const T value = other.unchecked(c);
+            for (std::size_t i = 0; i < count; i++) {
+                out[i] += value;
+            }
+        }
+        return *this;
+    }
+    friend VecArray<N, T> operator+(VecArray<N, T> a, const VecArray<N, T> &b) {
+        a += b;
+        return a;
+    }
+    friend VecArray<N, T> operator-(VecArray<N, T> a, const VecArray<N, T> &b) {
+        a -= b;
+        return a;
+    }
+    friend VecArray<N, T> operator*(VecArray<N, T> a, const VecArray<N, T> &b) {
+        a *= b;
+        return a;
+    }
+    friend VecArray<N, T> operator*(VecArray<N, T> a, const T &b) {
+        a *= b;
+        return a;
+    }
+    friend VecArray<N, T> operator*(const T &a, VecArray<N, T> b) {
+        b *= a;
+        return b;
+    }
+    friend VecArray<N, T> operator/(VecArray<N, T> a, const T &b) {
+        a /= b;
+        return a;
+    }
+};
+using VecArray2f = VecArray<2, float>;
+using VecArray2d = VecArray<2, double>;
+using VecArray3f = VecArray<3, float>;
+using VecArray3d = VecArray<3, double>;
+using VecArray4f = VecArray<4, float>;
+using VecArray4d = VecArray<4, double>;
+
+namespace fast {
+/*
+    fast:: approximations over whole arrays, e.g. the component() spans of
+    a VecArray, on the register kernels of simd.hpp. Same bounds as the
+    scalar functions in fast.hpp.
+*/
+namespace detail {
+template <class T> constexpr std::size_t array_grain(std::size_t arrays) {
+    return execution::grain(arrays * sizeof(T));
+}
+inline void check_arrays(std::size_t in, std::size_t out) {
+    if (in != out) {
+        throw std::invalid_argument("Output span size mismatched.");
+    }
+}
+template <class Policy, class T>
+void map_arrays(Policy &&policy, std::span<const T> in, std::span<T> out,
+                void (*kernel)(const T *, T *, std::size_t)) {
+    check_arrays(in.size(), out.size());
+    execution::for_each_range(policy, in.size(), array_grain<T>(2),
+                              [&](std::size_t begin, std::size_t end) {
+                                  kernel(in.data() + begin, out.data() + begin,
+                                         end - begin);
+                              });
+}
+} // namespace detail
+
+/**
+ * @brief out[i] = fast::rsqrt(in[i]), out may be in.
+ */
+template <execution::ExecutionPolicy Policy, std::floating_point T>
+void rsqrt(Policy &&policy, std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    detail::map_arrays(policy, in, out, &simd::rsqrt<T>);
+}
+template <std::floating_point T>
+void rsqrt(std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    rsqrt(execution::seq, in, out);
+}
+/**
+ * @brief out[i] = fast::sin(in[i]), out may be in.
+ */
+template <execution::ExecutionPolicy Policy, std::floating_point T>
+void sin(Policy &&policy, std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    detail::map_arrays(policy, in, out, &simd::sin<T>);
+}
+template <std::floating_point T>
+void sin(std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    sin(execution::seq, in, out);
+}
+/**
+ * @brief out[i] = fast::cos(in[i]), out may be in.
+ */
+template <execution::ExecutionPolicy Policy, std::floating_point T>
+void cos(Policy &&policy, std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    detail::map_arrays(policy, in, out, &simd::cos<T>);
+}
+template <std::floating_point T>
+void cos(std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    cos(execution::seq, in, out);
+}
+/**
+ * @brief sin[i], cos[i] = fast::sincos(in[i]), either output may be in.
+ */
+template <execution::ExecutionPolicy Policy, std::floating_point T>
+void sincos(Policy &&policy, std::type_identity_t<std::span<const T>> in, std::span<T> sin,
+            std::span<T> cos) {
+    detail::check_arrays(in.size(), sin.size());
+    detail::check_arrays(in.size(), cos.size());
+    execution::for_each_range(policy, in.size(), detail::array_grain<T>(3),
+                              [&](std::size_t begin, std::size_t end) {
+                                  simd::sincos(in.data() + begin, sin.data() + begin,
+                                               cos.data() + begin, end - begin);
+                              });
+}
+template <std::floating_point T>
+void sincos(std::type_identity_t<std::span<const T>> in, std::span<T> sin, std::span<T> cos) {
+    sincos(execution::seq, in, sin, cos);
+}
+/**
+ * @brief out[i] = fast::acos(in[i]) for in[i] in [-1, 1], out may be in.
+ */
+template <execution::ExecutionPolicy Policy, std::floating_point T>
+void acos(Policy &&policy, std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    detail::map_arrays(policy, in, out, &simd::acos<T>);
+}
+template <std::floating_point T>
+void acos(std::type_identity_t<std::span<const T>> in, std::span<T> out) {
+    acos(execution::seq, in, out);
+}
+/**
+ * @brief out[i] = fast::atan2(y[i], x[i]), out may be y or x.
+ */
+template <execution::ExecutionPolicy Policy, std::floating_point T>
+void atan2(Policy &&policy, std::type_identity_t<std::span<const T>> y,
+           std::type_identity_t<std::span<const T>> x, std::span<T> out) {
+    detail::check_arrays(y.size(), x.size());
+    detail::check_arrays(y.size(), out.size());
+    execution::for_each_range(policy, y.size(), detail::array_grain<T>(3),
+                              [&](std::size_t begin, std::size_t end) {
+                                  simd::atan2(y.data() + begin, x.data() + begin,
+                                              out.data() + begin, end - begin);
+                              });
+}
+template <std::floating_point T>
+void atan2(std::type_identity_t<std::span<const T>> y,
+           std::type_identity_t<std::span<const T>> x, std::span<T> out) {
+    atan2(execution::seq, y, x, out);
+}
+
+/**
+ * @return Copy of vecs with every element scaled by fast::rsqrt of its
+ * squared length. No zero check, zero vectors come out non-finite.
+ */
+template <execution::ExecutionPolicy Policy, unsigned int N, std::floating_point T>
+VecArray<N, T> normalize(Policy &&policy, const VecArray<N, T> &vecs) {
+    VecArray<N, T> result(vecs.size());
+    execution::for_each_range(
+        policy, vecs.size(), detail::array_grain<T>(2 * N + 1),
+        [&](std::size_t begin, std::size_t end) {
+            const std::size_t n = end - begin;
+            std::vector<T> scale(n);
+            T *SMATH_RESTRICT s = scale.data();
+            for (unsigned int c = 0; c < N; c++) {
+                const T *SMATH_RESTRICT in = vecs.component(c).data() + begin;
+                for (std::size_t i = 0; i < n; i++) {
+                    s[i] += in[i] * in[i];
+                }
+            }
+            simd::rsqrt(s, s, n);
+            for (unsigned int c = 0; c < N; c++) {
+                const T *SMATH_RESTRICT in = vecs.component(c).data() + begin;
+                T *SMATH_RESTRICT out = result.component(c).data() + begin;
+                for (std::size_t i = 0; i < n; i++) {
+                    out[i] = in[i] * s[i];
+                }
+            }
+        });
+    return result;
+}
+template <unsigned int N, std::floating_point T>
+VecArray<N, T> normalize(const VecArray<N, T> &vecs) {
+    return fast::normalize(execution::seq, vecs);
+}
+} // namespace fast
+} // namespace smath
+#endif // SMATH_VEC_ARRAY_HPP
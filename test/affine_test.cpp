@@ -0,0 +1,49 @@
+#include "affine.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+
+using namespace smath;
+
+TEST(CONSTRUCTION) {
+    Affine3f identity;
+    assert_equal(identity.mat(), Mat4f::identity());
+    Affine3f a(scale3(1.0f, 2.0f, 3.0f), Vec3f(4, 5, 6));
+    assert_equal(a.linear(), scale3(1.0f, 2.0f, 3.0f));
+    assert_equal(a.translation(), Vec3f(4, 5, 6));
+    assert_equal(a.mat(), translation3(4.0f, 5.0f, 6.0f)
+                              .cross(scale3(1.0f, 2.0f, 3.0f).to_homogeneous()));
+}
+
+TEST(TRANSFORM) {
+    Affine3f a(scale3(2.0f, 2.0f, 2.0f), Vec3f(1, 0, -1));
+    assert_equal(a.transform_point(Vec3f(1, 2, 3)), Vec3f(3, 4, 5));
+    assert_equal(a.transform_vector(Vec3f(1, 2, 3)), Vec3f(2, 4, 6));
+    assert_equal(a * Vec4f(1, 2, 3, 1), Vec4f(3, 4, 5, 1));
+}
+
+TEST(INVERSE) {
+    Affine3d a(euler_y(0.3).cross(scale3(2.0, 3.0, 0.5)), Vec3d(1, 2, 3));
+    assert_close(a.inverse().mat(), a.mat().inverse(), Mat4d(1e-12));
+    assert_close((a * a.inverse()).mat(), Mat4d::identity(), Mat4d(1e-12));
+    Vec3d p(-4, 2, 7);
+    assert_close(a.inverse().transform_point(a.transform_point(p)), p,
+                 Vec3d(1e-12));
+
+    Rigid3d r(euler_z(1.1), Vec3d(-2, 0, 5));
+    assert_close(r.inverse().mat(), r.mat().inverse(), Mat4d(1e-12));
+    // Rigid composes with affine as an affine.
+    Affine3d mixed = a * r;
+    assert_close(mixed.inverse().mat(), mixed.mat().inverse(), Mat4d(1e-12));
+}
+
+TEST(CONSTEXPR) {
+    constexpr Rigid3f r(Mat3f::identity(), Vec3f(1, 2, 3));
+    constexpr Rigid3f back = r.inverse();
+    static_assert((back.translation() == Vec3f(-1, -2, -3)).all());
+    static_assert(((r * back).transform_point(Vec3f(7, 8, 9)) ==
+                   Vec3f(7, 8, 9))
+                      .all());
+    assert_equal(back.translation(), Vec3f(-1, -2, -3));
+}
+
+int main() { return TestRunner::instance().run("Affine Test"); }
@@ -0,0 +1,96 @@
+#include "../bench/report.hpp"
+#include "test_tool.hpp"
+#include <sstream>
+
+using namespace smath::bench;
+
+static Result make_result(std::string name, std::vector<double> ns) {
+    Result result;
+    result.name = std::move(name);
+    result.items_per_call = 4;
+    result.calls_per_sample = 100;
+    result.ns_per_item = std::move(ns);
+    std::sort(result.ns_per_item.begin(), result.ns_per_item.end());
+    return result;
+}
+
+static Context make_context(std::string label) {
+    Context context;
+    context.label = std::move(label);
+    context.compiler = "gcc 12, \"test\"";
+    context.flags = "-O2";
+    context.cpu = "cpu";
+    return context;
+}
+
+TEST(WELCH_T_TEST) {
+    // I_0.5(2, 3) = 11/16
+    assert_close(incomplete_beta(2.0, 3.0, 0.5), 0.6875, 1e-12);
+    // One degree of freedom is Cauchy: p(|t| >= 1) = 1/2
+    assert_close(incomplete_beta(0.5, 0.5, 0.5), 0.5, 1e-12);
+    const Welch equal = welch_t_test(0, 1, 10, 1, 1, 10);
+    assert_close(equal.t, 2.2360679774997896, 1e-12);
+    assert_close(equal.dof, 18.0, 1e-12);
+    assert_close(equal.p_value, 0.0382496145, 1e-9);
+    const Welch unequal = welch_t_test(10, 1, 5, 12, 3, 20);
+    assert_close(unequal.dof, 20.4522292994, 1e-8);
+    assert_equal(welch_t_test(1, 0, 10, 1, 0, 10).p_value, 1.0);
+    assert_equal(welch_t_test(1, 0, 10, 2, 0, 10).p_value, 0.0);
+    assert_equal(welch_t_test(1, 1, 1, 2, 1, 10).p_value, 1.0);
+}
+
+TEST(RESULT_FILES) {
+    std::vector<Result> results = {make_result("mat4f/inverse", {2, 1, 3, 2}),
+                                   make_result("quatf/slerp,\"batch\"", {5, 5, 6})};
+    // Counters of the first run only, the second had none.
+    results[0].per_item[PerfCounters::cycles] = 4;
+    results[0].per_item[PerfCounters::instructions] = 10;
+    assert_close(*results[0].ipc(), 2.5, 1e-12);
+    assert_equal(results[1].ipc().has_value(), false);
+    for (bool json : {true, false}) {
+        std::ostringstream out;
+        if (json)
+            write_json(out, make_context("v1"), results);
+        else
+            write_csv(out, make_context("v1"), results);
+        const ResultFile file = json ? parse_json(out.str()) : parse_csv(out.str());
+        assert_equal(out.str().find("instructions_per_item") != std::string::npos, true);
+        assert_equal(file.context.at("label"), std::string("v1"));
+        assert_equal(file.context.at("compiler"), std::string("gcc 12, \"test\""));
+        assert_equal(file.results.size(), std::size_t(2));
+        assert_equal(file.results[0].name, results[0].name);
+        assert_equal(file.results[1].name, results[1].name);
+        assert_equal(file.results[0].samples, std::size_t(4));
+        assert_close(file.results[0].median, 2.0, 1e-12);
+        assert_close(file.results[0].mean, 2.0, 1e-12);
+        assert_close(file.results[0].stddev, results[0].stddev(), 1e-12);
+        assert_close(file.results[1].min, 5.0, 1e-12);
+    }
+}
+
+TEST(COMPARE) {
+    ResultFile baseline;
+    ResultFile current;
+    baseline.results = {Summary{"a", 10, 10, 0.1, 9.9, 10.1, 10.2, 25},
+                        Summary{"b", 10, 10, 0.1, 9.9, 10.1, 10.2, 25},
+                        Summary{"c", 10, 10, 5, 5, 15, 20, 25},
+                        Summary{"gone", 1, 1, 0, 1, 1, 1, 25}};
+    current.results = {Summary{"a", 12, 12, 0.1, 11.9, 12.1, 12.2, 25},
+                       Summary{"b", 8, 8, 0.1, 7.9, 8.1, 8.2, 25},
+                       Summary{"c", 12, 12, 5, 6, 17, 22, 25},
+                       Summary{"new", 1, 1, 0, 1, 1, 1, 25}};
+    const std::vector<Comparison> comparisons = compare(baseline, current, 0.05, 0.01);
+    assert_equal(comparisons.size(), std::size_t(4));
+    assert_equal(comparisons[0].slower, true);
+    assert_close(comparisons[0].change, 0.2, 1e-12);
+    assert_equal(comparisons[1].slower, false);
+    assert_equal(comparisons[1].faster, true);
+    // 20% slower but within the noise
+    assert_equal(comparisons[2].slower, false);
+    assert_equal(comparisons[2].faster, false);
+    // Dropped from the current run, listed after the matches.
+    assert_equal(comparisons[3].name, std::string("gone"));
+    assert_equal(comparisons[3].missing, true);
+    assert_equal(comparisons[0].missing || comparisons[1].missing, false);
+}
+int main() { return TestRunner::instance().run("Bench Report"); }
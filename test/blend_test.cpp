@@ -0,0 +1,109 @@
+#include "blend.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <vector>
+
+using namespace smath;
+
+// Pairs up to 178 degrees apart, including near-parallel ones and pairs
+// whose dot is negative so the shortest path has to flip b.
+template <class T>
+static void make_pairs(std::size_t count, std::vector<Quat<T>> &a,
+                       std::vector<Quat<T>> &b) {
+    for (std::size_t i = 0; i < count; i++) {
+        const T x = static_cast<T>(i % 13) - 6;
+        const T y = static_cast<T>(i % 7) + 1;
+        const Quat<T> start =
+            Quat<T>::from_axis_angle(static_cast<T>(0.1) * i, Vec<3, T>(x, y, 1));
+        const T apart = (i % 5 == 0) ? static_cast<T>(1e-4) : static_cast<T>(0.031) * (i % 100);
+        const Quat<T> end = Quat<T>::from_axis_angle(apart, Vec<3, T>(1, -x, y)).mul(start);
+        a.push_back(start);
+        b.push_back((i % 3 == 0) ? -end : end);
+    }
+}
+
+TEST(SCALAR_SLERP) {
+    const Quat<float> a = Quat<float>::from_axis_angle(0.2f, Vec3f(0, 0, 1));
+    const Quat<float> b = Quat<float>::from_axis_angle(1.2f, Vec3f(0, 0, 1));
+    assert_close(slerp(a, b, 0.5f), Quat<float>::from_axis_angle(0.7f, Vec3f(0, 0, 1)),
+                 Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+    // -b is the same rotation, the result must not take the long way round.
+    assert_close(slerp(a, -b, 0.5f), Quat<float>::from_axis_angle(0.7f, Vec3f(0, 0, 1)),
+                 Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+    // Near-parallel pairs neither divide by zero nor leave the unit sphere.
+    const Quat<float> close = Quat<float>::from_axis_angle(0.2001f, Vec3f(0, 0, 1));
+    assert_close(slerp(a, close, 0.3f).length(), 1.0f, 1e-6f);
+    assert_close(nlerp(a, -b, 0.5f), Quat<float>::from_axis_angle(0.7f, Vec3f(0, 0, 1)),
+                 Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+}
+
+TEST(BATCH_SLERP) {
+    std::vector<Quat<float>> a;
+    std::vector<Quat<float>> b;
+    make_pairs(203, a, b);
+    std::vector<float> t(a.size());
+    for (std::size_t i = 0; i < t.size(); i++) {
+        t[i] = static_cast<float>(i % 11) / 10;
+    }
+    std::vector<Quat<float>> out(a.size());
+    slerp(a, b, t, out);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        assert_close(out[i], slerp(a[i], b[i], t[i]),
+                     Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+    }
+    slerp(execution::par, a, b, 0.25f, out);
+    assert_close(out[202], slerp(a[202], b[202], 0.25f),
+                 Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+
+    std::vector<Quat<double>> ad;
+    std::vector<Quat<double>> bd;
+    make_pairs(37, ad, bd);
+    std::vector<Quat<double>> outd(ad.size());
+    slerp(ad, bd, 0.7, outd);
+    for (std::size_t i = 0; i < ad.size(); i++) {
+        assert_close(outd[i], slerp(ad[i], bd[i], 0.7),
+                     Quat<double>(1e-7, 1e-7, 1e-7, 1e-7));
+    }
+}
+
+TEST(BATCH_NLERP_ONLERP) {
+    std::vector<Quat<float>> a;
+    std::vector<Quat<float>> b;
+    make_pairs(203, a, b);
+    std::vector<Quat<float>> out(a.size());
+    nlerp(a, b, 0.3f, out);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        assert_close(out[i], nlerp(a[i], b[i], 0.3f),
+                     Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+    }
+    // onlerp stays within 1.5e-3 rad of slerp, where plain nlerp drifts off.
+    float onlerp_error = 0;
+    float nlerp_error = 0;
+    for (int step = 0; step <= 10; step++) {
+        const float t = static_cast<float>(step) / 10;
+        onlerp(a, b, t, out);
+        for (std::size_t i = 0; i < a.size(); i++) {
+            const Quat<float> exact = slerp(a[i], b[i], t);
+            const float angle = 2 * std::acos(std::min(1.0f, std::abs(out[i].dot(exact))));
+            onlerp_error = std::max(onlerp_error, angle);
+            assert_close(out[i], onlerp(a[i], b[i], t),
+                         Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+            const float drift = 2 * std::acos(std::min(
+                1.0f, std::abs(nlerp(a[i], b[i], t).dot(exact))));
+            nlerp_error = std::max(nlerp_error, drift);
+        }
+    }
+    assert_close(onlerp_error, 0.0f, 1.5e-3f);
+    // Over 0.1 rad for nlerp on these pairs, the correction is what closes the gap.
+    assert_equal(nlerp_error > 10 * onlerp_error, true);
+
+    std::vector<Quat<float>> short_out(3);
+    bool thrown = false;
+    try {
+        nlerp(a, b, 0.5f, short_out);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+int main() { return TestRunner::instance().run("Quaternion Blend"); }
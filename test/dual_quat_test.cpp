@@ -0,0 +1,62 @@
+#include "dual_quat.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <vector>
+
+using namespace smath;
+
+TEST(CONSTRUCTION) {
+    const DualQuatf identity{};
+    assert_equal(identity.real(), Quat<float>(1, 0, 0, 0));
+    assert_equal(identity.dual(), Quat<float>(0, 0, 0, 0));
+    const DualQuatf moved(Quat<float>::from_axis_angle(0.6f, Vec3f(1, 2, 3)), Vec3f(4, -5, 6));
+    assert_close(moved.translation(), Vec3f(4, -5, 6), Vec3f(1e-5f));
+    assert_close(moved.real().length(), 1.0f, 1e-6f);
+}
+
+TEST(MAT4_CONVERSION) {
+    const Mat4f rigid = translation3(1.0f, -2.0f, 3.0f)
+                            .cross(rotation(2.5f, Vec3f(1, -1, 0.5f)));
+    const DualQuatf q = DualQuatf::from_mat4(rigid);
+    assert_close(q.to_mat4(), rigid, Mat4f(1e-5f));
+    // Half turns, where the off-diagonal differences vanish.
+    const Mat4f half_turn = rotation(static_cast<float>(PI), Vec3f(0, 1, 1));
+    assert_close(DualQuatf::from_mat4(half_turn).to_mat4(), half_turn, Mat4f(1e-5f));
+}
+
+TEST(COMPOSITION_INVERSE) {
+    const Mat4d a = translation3(0.5, 1.0, -2.0).cross(rotation(0.3, Vec3d(0, 0, 1)));
+    const Mat4d b = translation3(-1.0, 4.0, 0.0).cross(rotation(1.1, Vec3d(1, 1, 0)));
+    const DualQuatd qa = DualQuatd::from_mat4(a);
+    const DualQuatd qb = DualQuatd::from_mat4(b);
+    assert_close(qa.mul(qb).to_mat4(), a.cross(b), Mat4d(1e-12));
+    assert_close(qa.inverse().to_mat4(), a.inverse_rigid(), Mat4d(1e-12));
+    const Vec3d p(0.25, -3.0, 7.0);
+    const Vec4d expected = a.cross(b) * p.expand(1.0);
+    assert_close(qa.mul(qb).transform_point(p), Vec3d(expected[0], expected[1], expected[2]),
+                 Vec3d(1e-12));
+    assert_close(qa.transform_vector(p), a.to_mat3().cross(p), Vec3d(1e-12));
+}
+
+TEST(NORMALIZED_BLEND) {
+    const DualQuatf a(Quat<float>::from_axis_angle(0.2f, Vec3f(0, 0, 1)), Vec3f(1, 0, 0));
+    const DualQuatf b(Quat<float>::from_axis_angle(1.0f, Vec3f(0, 0, 1)), Vec3f(1, 0, 0));
+    const std::vector<DualQuatf> q{a, -b};
+    const std::vector<float> w{0.5f, 0.5f};
+    const DualQuatf mid = blend(std::span<const DualQuatf>(q), std::span<const float>(w));
+    // -b is the same transform, the blend flips it back onto a's hemisphere.
+    assert_close(mid.real(), Quat<float>::from_axis_angle(0.6f, Vec3f(0, 0, 1)),
+                 Quat<float>(1e-6f, 1e-6f, 1e-6f, 1e-6f));
+    assert_close(mid.translation(), Vec3f(1, 0, 0), Vec3f(1e-6f));
+    const DualQuatf scaled = a * 3.0f;
+    assert_close(scaled.normalize().to_mat4(), a.to_mat4(), Mat4f(1e-6f));
+}
+
+TEST(CONSTEXPR) {
+    constexpr DualQuatd moved(Quat<double>::identity(), Vec3d(1, 2, 3));
+    static_assert(static_cast<bool>(moved.translation() == Vec3d(1, 2, 3)));
+    static_assert(static_cast<bool>(moved.transform_point(Vec3d(1, 1, 1)) == Vec3d(2, 3, 4)));
+    static_assert(moved.mul(moved.inverse()) == DualQuatd::identity());
+    assert_equal(moved.inverse().translation(), Vec3d(-1, -2, -3));
+}
+int main() { return TestRunner::instance().run("Dual Quaternion"); }
@@ -0,0 +1,115 @@
+#include "execution.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace smath;
+
+template <class V>
+static bool same(const std::vector<V> &a, const std::vector<V> &b) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (!static_cast<bool>(a[i] == b[i]))
+            return false;
+    }
+    return true;
+}
+
+TEST(PARALLEL_FOR_COVERAGE) {
+    execution::ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(10007);
+    pool.parallel_for(hits.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            hits[i]++;
+        }
+    });
+    bool once = true;
+    for (const std::atomic<int> &hit : hits) {
+        once &= (hit == 1);
+    }
+    assert_equal(once, true);
+
+    // Nested calls run on the same pool without deadlocking.
+    std::atomic<std::size_t> total{0};
+    pool.parallel_for(8, 1, [&](std::size_t, std::size_t) {
+        pool.parallel_for(100, 10, [&](std::size_t begin, std::size_t end) {
+            total += end - begin;
+        });
+    });
+    assert_equal(total.load(), static_cast<std::size_t>(800));
+
+    // Without workers the caller runs every chunk.
+    execution::ThreadPool inline_pool(0);
+    std::size_t covered = 0;
+    inline_pool.parallel_for(1000, 64, [&](std::size_t begin, std::size_t end) {
+        covered += end - begin;
+    });
+    assert_equal(covered, static_cast<std::size_t>(1000));
+}
+
+TEST(PARALLEL_FOR_EXCEPTION) {
+    execution::ThreadPool pool(2);
+    bool thrown = false;
+    try {
+        pool.parallel_for(1000, 10, [](std::size_t begin, std::size_t) {
+            if (begin == 500)
+                throw std::runtime_error("chunk failed");
+        });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+
+TEST(POLICY_VEC_ARRAY) {
+    constexpr std::size_t count = 100003;
+    VecArray3f a(count);
+    VecArray3f b(count);
+    for (std::size_t i = 0; i < count; i++) {
+        a.set(i, Vec3f(static_cast<float>(i % 13), static_cast<float>(i % 7),
+                       static_cast<float>(i % 3)));
+        b.set(i, Vec3f(1, -2, static_cast<float>(i % 5)));
+    }
+    assert_equal(a.dot(execution::par, b) == a.dot(b), true);
+    assert_equal(a.length(execution::par_unseq) == a.length(), true);
+    const VecArray3f seq = a.normalize_or_zero(execution::seq);
+    const VecArray3f par = a.normalize_or_zero(execution::par);
+    assert_equal(same(seq.to_aos(), par.to_aos()), true);
+    bool thrown = false;
+    try {
+        a.normalize(execution::par);
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+
+TEST(POLICY_TRANSFORM) {
+    constexpr std::size_t count = 100003;
+    const Mat4d m = translation3(1.0, 2.0, -3.0)
+                        .cross(rotation(0.3, Vec3d(1, 1, 0)))
+                        .cross(scale3(2.0, 1.0, 0.5).to_homogeneous());
+    std::vector<Vec3d> points(count);
+    for (std::size_t i = 0; i < count; i++) {
+        points[i] = Vec3d(static_cast<double>(i % 17), static_cast<double>(i % 11),
+                          static_cast<double>(i % 5) - 2);
+    }
+    std::vector<Vec3d> seq(count);
+    std::vector<Vec3d> par(count);
+    transform_points(m, points, seq);
+    transform_points(execution::par, m, points, par);
+    assert_equal(same(par, seq), true);
+    transform_normals(execution::par_unseq, m, points, par);
+    transform_normals(m, points, seq);
+    assert_equal(same(par, seq), true);
+
+    const VecArray3d soa{std::span<const Vec3d>(points)};
+    VecArray3d soa_out;
+    transform_vectors(execution::par, m, soa, soa_out);
+    transform_vectors(m, points, seq);
+    assert_equal(same(soa_out.to_aos(), seq), true);
+}
+int main() { return TestRunner::instance().run("Execution"); }
@@ -0,0 +1,247 @@
+#include "fast.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+using namespace smath;
+
+// Largest absolute error of f against g over count samples of [low, high].
+template <class F, class G>
+static double max_error(F &&f, G &&g, double low, double high, int count) {
+    double worst = 0;
+    for (int i = 0; i <= count; i++) {
+        const double x = low + (high - low) * i / count;
+        worst = std::max(worst, std::abs(f(x) - g(x)));
+    }
+    return worst;
+}
+
+TEST(SIN_BOUND) {
+    const double wide = max_error([](double x) { return fast::sin(x); },
+                                  [](double x) { return std::sin(x); }, -100.0,
+                                  100.0, 100000);
+    assert_close(wide, 0.0, 1e-9);
+    const double single = max_error(
+        [](double x) { return static_cast<double>(fast::sin(static_cast<float>(x))); },
+        [](double x) { return std::sin(static_cast<double>(static_cast<float>(x))); },
+        -10.0, 10.0, 100000);
+    assert_close(single, 0.0, 1e-6);
+}
+
+TEST(ACOS_BOUND) {
+    const double error = max_error([](double x) { return fast::acos(x); },
+                                   [](double x) { return std::acos(x); }, -1.0,
+                                   1.0, 100000);
+    assert_close(error, 0.0, 2.2e-8);
+    assert_close(fast::acos(1.0f), 0.0f, 1e-7f);
+    assert_close(fast::acos(-1.0f), std::numbers::pi_v<float>, 1e-6f);
+}
+
+// Distance in ulp of T between value and the long double reference.
+template <class T> static double ulp_error(T value, long double reference) {
+    if (reference == 0)
+        return value == 0 ? 0 : 1e30;
+    int exponent = 0;
+    std::frexp(reference, &exponent);
+    const long double ulp = std::ldexp(1.0L, exponent - std::numeric_limits<T>::digits);
+    return static_cast<double>(std::abs(static_cast<long double>(value) - reference) / ulp);
+}
+template <class T, class F, class G>
+static double max_ulp(F &&f, G &&g, double low, double high, int count) {
+    double worst = 0;
+    for (int i = 0; i <= count; i++) {
+        const T x = static_cast<T>(low + (high - low) * i / count);
+        worst = std::max(worst, ulp_error<T>(f(x), g(static_cast<long double>(x))));
+    }
+    return worst;
+}
+
+template <class T> static void check_sin_cos_ulp(double range, double bound) {
+    const double sin_ulp = max_ulp<T>([](T x) { return fast::sin(x); },
+                                      [](long double x) { return std::sin(x); }, -range,
+                                      range, 1000000);
+    const double cos_ulp = max_ulp<T>([](T x) { return fast::cos(x); },
+                                      [](long double x) { return std::cos(x); }, -range,
+                                      range, 1000000);
+    assert_close(sin_ulp, 0.0, bound);
+    assert_close(cos_ulp, 0.0, bound);
+}
+TEST(SIN_COS_ULP) {
+    check_sin_cos_ulp<float>(8192, 3);
+    check_sin_cos_ulp<double>(1e5, 3);
+    assert_equal(fast::sin(0.0f), 0.0f);
+    assert_equal(fast::cos(0.0), 1.0);
+}
+
+TEST(ATAN2_ACOS_ULP) {
+    double atan_float = 0;
+    double atan_double = 0;
+    for (int i = 0; i < 200000; i++) {
+        const long double angle = -std::numbers::pi_v<long double> +
+                                  2 * std::numbers::pi_v<long double> * i / 200000;
+        for (const long double radius : {1e-3L, 1.0L, 7e4L}) {
+            const float yf = static_cast<float>(radius * std::sin(angle));
+            const float xf = static_cast<float>(radius * std::cos(angle));
+            atan_float = std::max(atan_float, ulp_error(fast::atan2(yf, xf),
+                                                        std::atan2(static_cast<long double>(yf),
+                                                                   static_cast<long double>(xf))));
+            const double yd = static_cast<double>(radius * std::sin(angle));
+            const double xd = static_cast<double>(radius * std::cos(angle));
+            atan_double = std::max(atan_double, ulp_error(fast::atan2(yd, xd),
+                                                          std::atan2(static_cast<long double>(yd),
+                                                                     static_cast<long double>(xd))));
+        }
+    }
+    assert_close(atan_float, 0.0, 3.0);
+    assert_close(atan_double, 0.0, 4.0);
+    assert_equal(fast::atan2(0.0f, 0.0f), 0.0f);
+    assert_equal(fast::atan2(0.0f, -1.0f), std::numbers::pi_v<float>);
+
+    const double acos_float = max_ulp<float>([](float x) { return fast::acos(x); },
+                                             [](long double x) { return std::acos(x); }, -1.0,
+                                             1.0, 1000000);
+    const double acos_double = max_ulp<double>([](double x) { return fast::acos(x); },
+                                               [](long double x) { return std::acos(x); },
+                                               -1.0, 1.0, 1000000);
+    assert_close(acos_float, 0.0, 3.0);
+    assert_close(acos_double, 0.0, 3.0);
+}
+
+TEST(RSQRT_ULP) {
+    double worst = 0;
+    for (double x = 1e-30; x < 1e30; x *= 1.0001) {
+        const float value = static_cast<float>(x);
+        worst = std::max(worst, ulp_error(fast::rsqrt(value),
+                                          1 / std::sqrt(static_cast<long double>(value))));
+    }
+    assert_close(worst, 0.0, 5.0);
+    assert_close(fast::rsqrt(4.0), 0.5, 1e-16);
+}
+
+// The register kernels keep the bounds of the scalar functions, tails included.
+template <class T> static void check_bulk() {
+    const std::size_t n = 1003;
+    std::vector<T> x(n);
+    std::vector<T> y(n);
+    std::vector<T> unit(n);
+    for (std::size_t i = 0; i < n; i++) {
+        x[i] = static_cast<T>(i) * T(0.37) - T(180);
+        y[i] = static_cast<T>(i % 17) - T(8);
+        unit[i] = static_cast<T>(i) / T(n - 1) * 2 - 1;
+    }
+    std::vector<T> out(n);
+    double worst[5] = {};
+    fast::sin(x, std::span<T>(out));
+    for (std::size_t i = 0; i < n; i++) {
+        worst[0] = std::max(worst[0], ulp_error(out[i], std::sin(static_cast<long double>(x[i]))));
+    }
+    fast::cos(execution::par, x, std::span<T>(out));
+    for (std::size_t i = 0; i < n; i++) {
+        worst[1] = std::max(worst[1], ulp_error(out[i], std::cos(static_cast<long double>(x[i]))));
+    }
+    fast::acos(unit, std::span<T>(out));
+    for (std::size_t i = 0; i < n; i++) {
+        worst[2] = std::max(worst[2], ulp_error(out[i], std::acos(static_cast<long double>(unit[i]))));
+    }
+    fast::atan2(y, x, std::span<T>(out));
+    for (std::size_t i = 0; i < n; i++) {
+        worst[3] = std::max(worst[3], ulp_error(out[i], std::atan2(static_cast<long double>(y[i]),
+                                                                   static_cast<long double>(x[i]))));
+    }
+    // sincos agrees with the sin and cos kernels to the bit, cos computed in place.
+    std::vector<T> sine(n);
+    std::vector<T> cosine = x;
+    fast::sincos(execution::par, x, std::span<T>(sine), std::span<T>(cosine));
+    std::vector<T> expected(n);
+    int mismatched = 0;
+    fast::sin(x, std::span<T>(expected));
+    for (std::size_t i = 0; i < n; i++) {
+        const SinCos<T> scalar = fast::sincos(x[i]);
+        mismatched += sine[i] != expected[i] || scalar.sin != fast::sin(x[i]);
+        mismatched += scalar.cos != fast::cos(x[i]);
+    }
+    fast::cos(x, std::span<T>(expected));
+    for (std::size_t i = 0; i < n; i++) {
+        mismatched += cosine[i] != expected[i];
+    }
+    assert_equal(mismatched, 0);
+    std::vector<T> in_place = x;
+    for (T &value : in_place) {
+        value = value < 0 ? -value : value + 1;
+    }
+    const std::vector<T> positive = in_place;
+    fast::rsqrt(in_place, std::span<T>(in_place));
+    for (std::size_t i = 0; i < n; i++) {
+        worst[4] = std::max(worst[4], ulp_error(in_place[i],
+                                                1 / std::sqrt(static_cast<long double>(positive[i]))));
+    }
+    const bool single = std::is_same_v<T, float>;
+    assert_close(worst[0], 0.0, 3.0);
+    assert_close(worst[1], 0.0, 3.0);
+    assert_close(worst[2], 0.0, 3.0);
+    assert_close(worst[3], 0.0, single ? 3.0 : 4.0);
+    assert_close(worst[4], 0.0, single ? 5.0 : 1.5);
+
+    bool thrown = false;
+    try {
+        fast::sin(x, std::span<T>(out.data(), n - 1));
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+TEST(BULK) {
+    check_bulk<float>();
+    check_bulk<double>();
+}
+
+TEST(VEC_QUAT) {
+    const Vec3f v(3, -4, 12);
+    const Vec3f unit = fast::normalize(v);
+    assert_close((unit - v.normalize()).length(), 0.0f, 1e-6f);
+    assert_close(fast::angle(Vec3f(1, 0, 0), Vec3f(1, 1, 0)), std::numbers::pi_v<float> / 4,
+                 1e-6f);
+    assert_close(fast::angle(Vec3d(1, 2, 3), Vec3d(2, 4, 6)), 0.0, 1e-7);
+    assert_close(fast::angle(Vec4d(1, 2, 3, 4), Vec4d(-4, 1, 0, 2)),
+                 Vec4d(1, 2, 3, 4).angle(Vec4d(-4, 1, 0, 2)), 1e-14);
+
+    VecArray3f vecs;
+    for (int i = 0; i < 37; i++) {
+        vecs.push_back(Vec3f(static_cast<float>(i) - 18, 1, static_cast<float>(i % 5)));
+    }
+    const VecArray3f normalized = fast::normalize(execution::par, vecs);
+    float worst = 0;
+    for (std::size_t i = 0; i < vecs.size(); i++) {
+        worst = std::max(worst, (normalized[i] - vecs[i].normalize()).length());
+    }
+    assert_close(worst, 0.0f, 1e-6f);
+
+    const Quat<double> a = Quat<double>(1, 2, 3, 4).normalize();
+    const Quat<double> b = Quat<double>(-2, 1, 0.5, 3).normalize();
+    double quat_error = 0;
+    for (int i = 0; i <= 10; i++) {
+        const double t = i / 10.0;
+        const Quat<double> expected = slerp(a, b, t);
+        const Quat<double> fast_result = fast::slerp(a, b, t);
+        quat_error = std::max(quat_error, (expected - fast_result).length());
+    }
+    assert_close(quat_error, 0.0, 1e-14);
+    const Quat<float> q = fast::normalize(Quat<float>(1, 1, 1, 1));
+    assert_close(q.length(), 1.0f, 1e-6f);
+}
+
+TEST(CONSTEXPR) {
+    static_assert(fast::sin(0.5) > 0.479 && fast::sin(0.5) < 0.480);
+    static_assert(fast::onlerp_t(1.0, 0.0) == 0.0);
+    static_assert(fast::onlerp_t(1.0, 1.0) == 1.0);
+    assert_equal(fast::onlerp_t(0.5f, 0.5f), 0.5f);
+    static_assert(fast::cos(0.0) == 1.0);
+    static_assert(fast::sincos(0.0).sin == 0.0 && fast::sincos(0.0).cos == 1.0);
+    static_assert(fast::rsqrt(4.0f) == 0.5f);
+    static_assert(fast::atan2(1.0, 1.0) > 0.785 && fast::atan2(1.0, 1.0) < 0.786);
+}
+int main() { return TestRunner::instance().run("Fast Approximation"); }
@@ -0,0 +1,121 @@
+#include "frustum.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <numbers>
+#include <vector>
+
+using namespace smath;
+
+// 90 degree square frustum from z = -1 to z = -10 in view space.
+template <class T> static Frustum<T> view_frustum() {
+    return Frustum<T>::from_mat4(perspective(T(1), std::numbers::pi_v<T> / 2, T(1), T(10)));
+}
+
+TEST(PLANE_EXTRACTION) {
+    const Frustumd frustum = view_frustum<double>();
+    const double s = std::sqrt(0.5);
+    assert_close(frustum.plane(Frustumd::left), Vec4d(s, 0, -s, 0), Vec4d(1e-12));
+    assert_close(frustum.plane(Frustumd::top), Vec4d(0, -s, -s, 0), Vec4d(1e-12));
+    assert_close(frustum.plane(Frustumd::near_plane), Vec4d(0, 0, -1, -1), Vec4d(1e-12));
+    assert_close(frustum.plane(Frustumd::far_plane), Vec4d(0, 0, 1, 10), Vec4d(1e-12));
+    assert_close(frustum.distance(Frustumd::far_plane, Vec3d(0, 0, -4)), 6.0, 1e-12);
+
+    // Through a view matrix the planes live in world space.
+    const Frustumf world = Frustumf::from_mat4(
+        perspective(1.0f, std::numbers::pi_v<float> / 2, 1.0f, 10.0f)
+            .cross(look_at(Vec3f(0, 0, 5), Vec3f(0, 0, 0), Vec3f(0, 1, 0))));
+    assert_equal(world.contains(Vec3f(0, 0, 0)), true);
+    assert_equal(world.contains(Vec3f(0, 0, 6)), false);
+    assert_equal(world.contains(Vec3f(3.5f, 0, 0)), true);
+    assert_equal(world.contains(Vec3f(5.5f, 0, 0)), false);
+    assert_equal(world.contains(Vec3f(0, 0, -6)), false);
+}
+
+TEST(CLASSIFY) {
+    const Frustumf frustum = view_frustum<float>();
+    assert_equal(frustum.classify_sphere(Vec3f(0, 0, -5), 1.0f), Containment::inside);
+    assert_equal(frustum.classify_sphere(Vec3f(0, 0, -1), 0.5f), Containment::intersecting);
+    assert_equal(frustum.classify_sphere(Vec3f(0, 0, 1), 0.5f), Containment::outside);
+    assert_equal(frustum.classify_sphere(Vec3f(-20, 0, -5), 1.0f), Containment::outside);
+    assert_equal(frustum.classify_aabb(Vec3f(-1, -1, -6), Vec3f(1, 1, -4)),
+                 Containment::inside);
+    assert_equal(frustum.classify_aabb(Vec3f(-1, -1, -12), Vec3f(1, 1, -8)),
+                 Containment::intersecting);
+    assert_equal(frustum.classify_aabb(Vec3f(4, -1, -3), Vec3f(6, 1, -2)),
+                 Containment::outside);
+}
+
+// A grid of objects straddling every plane, the batch must match one by one.
+template <class T> static void check_batch() {
+    const Frustum<T> frustum = Frustum<T>::from_mat4(
+        perspective(T(1.5), T(1), T(1), T(30))
+            .cross(look_at(Vec<3, T>(1, 2, 3), Vec<3, T>(0, 0, -10), Vec<3, T>(0, 1, 0))));
+    std::vector<Vec<3, T>> centers;
+    std::vector<T> radii;
+    std::vector<Vec<3, T>> min;
+    std::vector<Vec<3, T>> max;
+    for (unsigned int i = 0; i < 1003; i++) {
+        const Vec<3, T> c(static_cast<T>(i % 17) * 2 - 16, static_cast<T>(i % 13) - 6,
+                          -static_cast<T>(i % 23) * 2 + 4);
+        const T r = static_cast<T>(i % 5) * T(0.75);
+        centers.push_back(c);
+        radii.push_back(r);
+        min.push_back(c - Vec<3, T>(r, r / 2, r));
+        max.push_back(c + Vec<3, T>(r, r, r / 3));
+    }
+    std::vector<Containment> spheres(centers.size());
+    std::vector<Containment> boxes(centers.size());
+    std::vector<Containment> soa(centers.size());
+    classify_spheres(frustum, centers, radii, spheres);
+    classify_aabbs(execution::par, frustum, min, max, boxes);
+    unsigned int counts[3] = {};
+    for (std::size_t i = 0; i < centers.size(); i++) {
+        assert_equal(spheres[i], frustum.classify_sphere(centers[i], radii[i]));
+        assert_equal(boxes[i], frustum.classify_aabb(min[i], max[i]));
+        counts[static_cast<unsigned int>(spheres[i])]++;
+    }
+    // Every outcome is exercised.
+    assert_equal(counts[0] > 0 && counts[1] > 0 && counts[2] > 0, true);
+
+    const VecArray<3, T> soa_centers{std::span<const Vec<3, T>>(centers)};
+    classify_spheres(execution::par, frustum, soa_centers, radii, soa);
+    assert_equal(soa == spheres, true);
+    const VecArray<3, T> soa_min{std::span<const Vec<3, T>>(min)};
+    const VecArray<3, T> soa_max{std::span<const Vec<3, T>>(max)};
+    classify_aabbs(frustum, soa_min, soa_max, soa);
+    assert_equal(soa == boxes, true);
+}
+
+TEST(BATCH_CLASSIFY) {
+    check_batch<float>();
+    check_batch<double>();
+}
+
+TEST(CULLING_ERRORS) {
+    const Frustumf frustum = view_frustum<float>();
+    const std::vector<Vec3f> centers(4);
+    const std::vector<float> radii(3);
+    std::vector<Containment> out(4);
+    bool thrown = false;
+    try {
+        classify_spheres(frustum, centers, radii, out);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+    thrown = false;
+    try {
+        classify_aabbs(frustum, centers, std::span<const Vec3f>(centers).first(2), out);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+    thrown = false;
+    try {
+        Frustumf::from_mat4(Mat4f{});
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+int main() { return TestRunner::instance().run("Frustum"); }
@@ -0,0 +1,195 @@
+#include "half.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace smath;
+
+// Floats over the whole bit range: every exponent, NaNs and infinities.
+static std::vector<float> every_kind_of_float(std::size_t n) {
+    std::vector<float> values(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < n; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values[i] = std::bit_cast<float>(static_cast<std::uint32_t>(state >> 32));
+    }
+    values[0] = 65504.0f;
+    values[1] = 65520.0f;
+    values[2] = -0.0f;
+    values[3] = std::numeric_limits<float>::infinity();
+    values[4] = std::numeric_limits<float>::quiet_NaN();
+    values[5] = 0x1p-25f;
+    return values;
+}
+
+TEST(HALF_CONVERSION) {
+    assert_equal(Half(1.0f).bits(), std::uint16_t(0x3C00));
+    assert_equal(Half(-2.0f).bits(), std::uint16_t(0xC000));
+    assert_equal(Half(65504.0f).bits(), std::uint16_t(0x7BFF));
+    assert_equal(Half(65519.0f).bits(), std::uint16_t(0x7BFF));
+    assert_equal(Half(65520.0f).bits(), std::uint16_t(0x7C00));
+    assert_equal(Half(-1e10f).bits(), std::uint16_t(0xFC00));
+    assert_equal(Half(-0.0f).bits(), std::uint16_t(0x8000));
+    // Ties round to even, also into the subnormals.
+    assert_equal(Half(1.0f + 0x1p-11f).bits(), std::uint16_t(0x3C00));
+    assert_equal(Half(1.0f + 3 * 0x1p-11f).bits(), std::uint16_t(0x3C02));
+    assert_equal(Half(0x1p-24f).bits(), std::uint16_t(0x0001));
+    assert_equal(Half(0x1p-25f).bits(), std::uint16_t(0x0000));
+    assert_equal(Half(0x1.8p-25f).bits(), std::uint16_t(0x0001));
+    assert_equal(Half(0x1.8p-24f).bits(), std::uint16_t(0x0002));
+    assert_equal(static_cast<float>(Half::from_bits(0x3555)), 0.333251953125f);
+    assert_equal(std::isnan(static_cast<float>(Half(std::nanf("")))), true);
+    static_assert(Half(0.5f).bits() == 0x3800);
+
+    // Every half survives the round trip through float.
+    int mismatched = 0;
+    for (std::uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+        const float value = simd::half_to_float(static_cast<std::uint16_t>(bits));
+        if (!std::isnan(value) && simd::half_from_float(value) != bits)
+            mismatched++;
+    }
+    assert_equal(mismatched, 0);
+}
+
+TEST(BFLOAT16_CONVERSION) {
+    assert_equal(BFloat16(1.0f).bits(), std::uint16_t(0x3F80));
+    assert_equal(BFloat16(-3.0f).bits(), std::uint16_t(0xC040));
+    assert_equal(BFloat16(1.0f + 0x1p-8f).bits(), std::uint16_t(0x3F80));
+    assert_equal(BFloat16(1.0f + 3 * 0x1p-8f).bits(), std::uint16_t(0x3F82));
+    assert_equal(BFloat16(std::numeric_limits<float>::max()).bits(), std::uint16_t(0x7F80));
+    assert_close(static_cast<float>(BFloat16(1e30f)) / 1e30f, 1.0f, 0x1p-9f);
+    assert_equal(std::isnan(static_cast<float>(BFloat16(std::nanf("")))), true);
+}
+
+// The packed kernels must give the bits of the scalar conversions.
+TEST(BULK_KERNELS) {
+    const std::vector<float> values = every_kind_of_float(10007);
+    std::vector<std::uint16_t> half(values.size());
+    std::vector<std::uint16_t> bfloat(values.size());
+    simd::float_to_half(values.data(), half.data(), values.size());
+    simd::float_to_bfloat16(values.data(), bfloat.data(), values.size());
+    int mismatched = 0;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        mismatched += half[i] != simd::half_from_float(values[i]);
+        mismatched += bfloat[i] != simd::bfloat16_from_float(values[i]);
+    }
+    assert_equal(mismatched, 0);
+
+    std::vector<std::uint16_t> every(0x10000);
+    for (std::uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+        every[bits] = static_cast<std::uint16_t>(bits);
+    }
+    std::vector<float> widened(every.size());
+    simd::half_to_float(every.data(), widened.data(), every.size());
+    for (std::uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+        mismatched += std::bit_cast<std::uint32_t>(widened[bits]) !=
+                      std::bit_cast<std::uint32_t>(simd::half_to_float(every[bits]));
+    }
+    simd::bfloat16_to_float(every.data(), widened.data(), every.size());
+    for (std::uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+        mismatched += std::bit_cast<std::uint32_t>(widened[bits]) != bits << 16;
+    }
+    assert_equal(mismatched, 0);
+}
+
+TEST(PACKED_TYPES) {
+    static_assert(sizeof(PackedVec3h) == 6);
+    static_assert(sizeof(PackedVec4bf) == 8);
+    static_assert(sizeof(PackedMat4h) == 32);
+    const PackedVec3h v(Vec3f(1, -0.5f, 1000.25f));
+    assert_equal(v.unpack(), Vec3f(1, -0.5f, 1000.0f));
+    assert_equal(static_cast<float>(v[1]), -0.5f);
+    const PackedVec4bf b(Vec4f(1, 2, 3, 257));
+    assert_equal(b.unpack(), Vec4f(1, 2, 3, 256));
+    const Mat4f m = translation3(1.0f, 2.0f, 3.0f);
+    assert_equal(PackedMat4h(m).unpack(), m);
+}
+
+TEST(BULK_PACK) {
+    std::vector<Vec3f> positions(1000);
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        const float t = static_cast<float>(i);
+        positions[i] = Vec3f(t * 0.37f - 100, std::sin(t), 1.0f / (t + 1));
+    }
+    std::vector<PackedVec3h> half(positions.size());
+    pack(positions, std::span<PackedVec3h>(half));
+    std::vector<Vec3f> back(positions.size());
+    unpack(std::span<const PackedVec3h>(half), back);
+    // Relative error of binary16 rounding is at most 2^-11, below the
+    // smallest normal 2^-14 the absolute error is at most 2^-25.
+    float worst = 0;
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        for (unsigned int c = 0; c < 3; c++) {
+            worst = std::max(worst, std::abs(back[i][c] - positions[i][c]) /
+                                        std::max(std::abs(positions[i][c]), 0x1p-14f));
+        }
+        if (!static_cast<bool>(back[i] == half[i].unpack()))
+            worst = 1;
+    }
+    assert_close(worst, 0.0f, 0x1.01p-11f);
+
+    // The SoA path and the parallel path agree with the AoS one.
+    const VecArray3f soa{std::span<const Vec3f>(positions)};
+    std::vector<PackedVec3h> from_soa(positions.size());
+    pack(execution::par, soa, std::span<PackedVec3h>(from_soa));
+    std::vector<PackedVec3h> parallel(positions.size());
+    pack(execution::par, positions, std::span<PackedVec3h>(parallel));
+    VecArray3f soa_back;
+    unpack(std::span<const PackedVec3h>(from_soa), soa_back);
+    int mismatched = 0;
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        for (unsigned int c = 0; c < 3; c++) {
+            mismatched += from_soa[i][c].bits() != half[i][c].bits();
+            mismatched += parallel[i][c].bits() != half[i][c].bits();
+        }
+        mismatched += !static_cast<bool>(soa_back[i] == back[i]);
+    }
+    assert_equal(mismatched, 0);
+
+    std::vector<Vec4f> weights{Vec4f(0.5f, 0.25f, 0.125f, 0.125f), Vec4f(1, 0, 0, 0)};
+    std::vector<PackedVec4bf> packed_weights(2);
+    pack(weights, std::span<PackedVec4bf>(packed_weights));
+    VecArray4f weight_array;
+    unpack(std::span<const PackedVec4bf>(packed_weights), weight_array);
+    assert_equal(weight_array[0], weights[0]);
+
+    const std::vector<Mat4f> palette{Mat4f::identity(), translation3(1.0f, 2.0f, 3.0f)};
+    std::vector<PackedMat4h> packed_palette(2);
+    pack(palette, std::span<PackedMat4h>(packed_palette));
+    std::vector<Mat4f> palette_back(2);
+    unpack(std::span<const PackedMat4h>(packed_palette), palette_back);
+    assert_equal(palette_back[0], palette[0]);
+    assert_equal(palette_back[1], palette[1]);
+
+    std::vector<float> scalars{0.1f, 2, 3};
+    std::vector<Half> packed_scalars(3);
+    pack(scalars, std::span<Half>(packed_scalars));
+    assert_equal(static_cast<float>(packed_scalars[0]), 0.0999755859375f);
+}
+
+TEST(PACK_ERRORS) {
+    const std::vector<Vec3f> positions(4);
+    std::vector<PackedVec3h> half(3);
+    bool thrown = false;
+    try {
+        pack(positions, std::span<PackedVec3h>(half));
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+#if SMATH_CHECKED
+    thrown = false;
+    try {
+        PackedVec3h v;
+        v[3] = Half(1.0f);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+#endif
+}
+int main() { return TestRunner::instance().run("Half"); }
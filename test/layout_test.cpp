@@ -0,0 +1,114 @@
+#include "layout.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+using namespace smath;
+
+template <class V> static bool aligned_to(const V &value, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(&value) % alignment == 0;
+}
+
+TEST(ALIGNED_TYPES) {
+    std::vector<AlignedVec3f> positions(5, AlignedVec3f(1, 2, 3));
+    assert_equal(aligned_to(positions[3], 16), true);
+    std::vector<AlignedMat4f> palette(3, translation3(1.0f, 2.0f, 3.0f));
+    assert_equal(aligned_to(palette[1], 64), true);
+    const AlignedVec<4, float, 32> wide(1, 2, 3, 4);
+    assert_equal(alignof(decltype(wide)), std::size_t(32));
+
+    // Used wherever a Vec / Mat is expected.
+    AlignedVec3f a(1, 0, 0);
+    const Vec3f b(0, 1, 0);
+    assert_equal(a.cross(b), Vec3f(0, 0, 1));
+    assert_equal(Vec3f(a + b), Vec3f(1, 1, 0));
+    a = Vec3f(4, 5, 6);
+    assert_equal(a[2], 6.0f);
+    const Vec4f p = palette[2].cross(Vec4f(0, 0, 0, 1));
+    assert_equal(p, Vec4f(1, 2, 3, 1));
+    assert_equal(palette[0].inverse(), translation3(-1.0f, -2.0f, -3.0f));
+}
+
+TEST(PADDED_VEC3) {
+    PaddedVec3f v(Vec3f(1, 2, 3));
+    assert_equal(v.padded(), Vec4f(1, 2, 3, 0));
+    v[1] = -2;
+    const Vec3f back = v;
+    assert_equal(back, Vec3f(1, -2, 3));
+    assert_equal(v.unchecked(3), 0.0f);
+    assert_equal(v == PaddedVec3f(1, -2, 3), true);
+
+    // Straight to a std140 vec3 array.
+    const std::vector<PaddedVec3f> normals{PaddedVec3f(0, 0, 1), PaddedVec3f(0, 1, 0)};
+    float buffer[8];
+    std::memcpy(buffer, normals.data(), sizeof(buffer));
+    assert_equal(buffer[2], 1.0f);
+    assert_equal(buffer[3], 0.0f);
+    assert_equal(buffer[5], 1.0f);
+
+#if SMATH_CHECKED
+    bool thrown = false;
+    try {
+        v[3] = 1;
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+#endif
+}
+
+// Padded spans must match the packed Vec3 path, pad lanes stay zero.
+template <class T> static void check_padded_transform() {
+    const Mat<4, 4, T> affine = translation3(T(1), T(-2), T(3))
+                                    .cross(rotation(T(0.7), Vec<3, T>(1, 2, -1)))
+                                    .cross(scale3(T(2), T(0.5), T(3)).to_homogeneous());
+    const Mat<4, 4, T> projection =
+        perspective(T(1.5), std::numbers::pi_v<T> / 3, T(0.1), T(100)).cross(affine);
+    std::vector<Vec<3, T>> packed;
+    std::vector<PaddedVec3<T>> padded;
+    for (unsigned int i = 0; i < 37; i++) {
+        const Vec<3, T> v(T(i) * T(0.25) - 4, T(i % 5) - 2, -T(i) - 1);
+        packed.push_back(v);
+        padded.push_back(v);
+    }
+    const Mat<4, 4, T> matrices[2] = {affine, projection};
+    T worst = 0;
+    T pad = 0;
+    for (const Mat<4, 4, T> &m : matrices) {
+        std::vector<Vec<3, T>> expected(packed.size());
+        std::vector<PaddedVec3<T>> result(padded.size());
+        transform_points(m, packed, expected);
+        transform_points(m, padded, result);
+        for (std::size_t i = 0; i < packed.size(); i++) {
+            worst = std::max(worst, (result[i].xyz() - expected[i]).length());
+            pad = std::max(pad, std::abs(result[i].padded()[3]));
+        }
+        transform_vectors(m, packed, expected);
+        std::vector<PaddedVec3<T>> in_place = padded;
+        transform_vectors(execution::par, m, std::span<PaddedVec3<T>>(in_place));
+        for (std::size_t i = 0; i < packed.size(); i++) {
+            worst = std::max(worst, (in_place[i].xyz() - expected[i]).length());
+            pad = std::max(pad, std::abs(in_place[i].padded()[3]));
+        }
+    }
+    assert_close(worst, T(0), T(1e-4));
+    assert_equal(pad, T(0));
+}
+
+TEST(PADDED_TRANSFORM) {
+    check_padded_transform<float>();
+    check_padded_transform<double>();
+    std::vector<PaddedVec3f> in(3);
+    std::vector<PaddedVec3f> out(2);
+    bool thrown = false;
+    try {
+        transform_points(Mat4f::identity(), in, out);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+int main() { return TestRunner::instance().run("Layout"); }
@@ -99,6 +99,52 @@ TEST(MULTIPLICATION) {
     auto r3 = Mat3f(3, -6, -21, -2, 0, 4, 24, 18, -33);
     assert_equal(mat30.cross(mat31), r3);
 }
+template <unsigned int M, unsigned int N, unsigned int K, class T>
+void check_blocked_cross() {
+    Mat<M, N, T> a{};
+    Mat<N, K, T> b{};
+    for (unsigned int i = 0; i < M * N; i++) {
+        a[i] = static_cast<T>(static_cast<int>(i % 7) - 3);
+    }
+    for (unsigned int i = 0; i < N * K; i++) {
+        b[i] = static_cast<T>(static_cast<int>(i % 5) - 2);
+    }
+    Mat<M, K, T> expected{};
+    for (unsigned int k = 0; k < K; k++) {
+        for (unsigned int m = 0; m < M; m++) {
+            for (unsigned int n = 0; n < N; n++) {
+                expected[k * M + m] += a[n * M + m] * b[k * N + n];
+            }
+        }
+    }
+    assert_equal(a.cross(b), expected);
+}
+TEST(BLOCKED_MULTIPLICATION) {
+    check_blocked_cross<16, 16, 16, float>();
+    check_blocked_cross<32, 32, 32, float>();
+    check_blocked_cross<13, 9, 6, float>();
+    check_blocked_cross<24, 5, 11, float>();
+    check_blocked_cross<32, 32, 32, double>();
+    check_blocked_cross<11, 5, 7, double>();
+    check_blocked_cross<4, 4, 4, float>();
+    check_blocked_cross<4, 4, 4, double>();
+
+    constexpr Mat<8, 8, float> identity = Mat<8, 8, float>::identity();
+    constexpr Mat<8, 8, float> doubled = identity * 2.0f;
+    static_assert(static_cast<bool>(identity.cross(doubled) == doubled));
+}
+TEST(MAT_VEC_PRODUCT) {
+    Mat4f mat00{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    assert_equal(mat00 * Vec4f(1, 0, 0, 0), Vec4f(1, 2, 3, 4));
+    assert_equal(mat00 * Vec4f(1, 1, 0, -1), Vec4f(-7, -6, -5, -4));
+    assert_equal(mat00.cross(Vec4f(0, 0, 2, 0)), Vec4f(18, 20, 22, 24));
+    Mat4d mat01 = translation3(1.0, 2.0, 3.0);
+    assert_equal(mat01 * Vec4d(1, 1, 1, 1), Vec4d(2, 3, 4, 1));
+    auto mat02 = Mat<3, 2, float>{0, 1, 2, 3, 4, 5};
+    assert_equal(mat02 * Vec2f(1, 2), Vec3f(6, 9, 12));
+    constexpr Mat4f mat03 = translation3(1.0f, 2.0f, 3.0f);
+    static_assert((mat03 * Vec4f(0, 0, 0, 1) == Vec4f(1, 2, 3, 1)).all());
+}
 TEST(MAT_TO_VEC) {
     auto mat00 = Mat3f(1, 2, 3, 4, 5, 6, 7, 8, 9);
     auto r00 = mat00.to_vectors()[0] == Vec3f(1, 2, 3);
@@ -115,8 +161,108 @@ TEST(INVERSION) {
     auto mat00 = Mat2f(1.0f, 2.0f, 3.0f, 4.0f);
     auto r00 = Mat2f(-2.0f, 1.0f, 1.5f, -0.5f);
     assert_equal(mat00.inverse(), r00);
+
+    auto mat10 = Mat3f(6.0f, 4.0f, 2.0f, 1.0f, -2.0f, 8.0f, 1.0f, 5.0f, 7.0f);
+    auto r10 = (1 / mat10.determinant()) * mat10.adjoint();
+    assert_close(mat10.inverse(), r10, Mat3f(1e-6f));
+    assert_close(mat10.cross(mat10.inverse()), Mat3f::identity(), Mat3f(1e-6f));
+
+    Mat4f mat20{2, 1, 0, 3, -1, 4, 2, 0, 0, 5, 1, -2, 3, 0, 2, 1};
+    auto r20 = (1 / mat20.determinant()) * mat20.adjoint();
+    assert_close(mat20.inverse(), r20, Mat4f(1e-6f));
+    assert_close(mat20.cross(mat20.inverse()), Mat4f::identity(), Mat4f(1e-5f));
+    Mat4d mat21{2, 1, 0, 3, -1, 4, 2, 0, 0, 5, 1, -2, 3, 0, 2, 1};
+    assert_close(mat21.inverse(), (1 / mat21.determinant()) * mat21.adjoint(),
+                 Mat4d(1e-12));
+
+    constexpr Mat4f translation = translation3(1.0f, 2.0f, 3.0f);
+    static_assert(static_cast<bool>(translation.inverse() ==
+                                    translation3(-1.0f, -2.0f, -3.0f)));
+    static_assert(translation.determinant() == 1.0f);
 };
 
+TEST(AFFINE_INVERSE) {
+    const Mat4f rotate = rotation(0.7f, Vec3f(1, 2, -1));
+    const Mat4f rigid = translation3(1.0f, -2.0f, 3.0f).cross(rotate);
+    const Mat4f affine = rigid.cross(scale3(2.0f, 0.5f, 4.0f).to_homogeneous());
+    assert_close(affine.inverse_affine(), affine.inverse(), Mat4f(1e-5f));
+    assert_close(rigid.inverse_rigid(), rigid.inverse(), Mat4f(1e-5f));
+    assert_close(rigid.inverse_affine(), rigid.inverse_rigid(), Mat4f(1e-5f));
+    const Mat4d view = look_at(Vec3d(3, 4, 5), Vec3d(0, 0, 0), Vec3d(0, 1, 0));
+    assert_close(view.inverse_rigid().cross(view), Mat4d::identity(),
+                 Mat4d(1e-12));
+    constexpr Mat4f translation = translation3(1.0f, 2.0f, 3.0f);
+    static_assert(static_cast<bool>(translation.inverse_rigid() ==
+                                    translation3(-1.0f, -2.0f, -3.0f)));
+}
+
+TEST(LU_DECOMPOSITION) {
+    using Mat5i = Mat<5, 5, int>;
+    using Mat5d = Mat<5, 5, double>;
+    Mat5i mat00{2, -1, 0, 3, 1, 4, 1, 2, 0, -2, 0, 3, -1, 2, 1,
+                1, 0, 5, -3, 2, -2, 1, 1, 4, 0};
+    auto lu00 = mat00.lu();
+    Mat5d permuted{};
+    for (unsigned int c = 0; c < 5; c++) {
+        for (unsigned int r = 0; r < 5; r++) {
+            permuted[c * 5 + r] = mat00[c * 5 + lu00.pivot[r]];
+        }
+    }
+    assert_close(lu00.lower().cross(lu00.upper()), permuted, Mat5d(1e-12));
+    assert_close(lu00.determinant(), static_cast<double>(mat00.determinant()),
+                 1e-9);
+    // Cofactor expansion along row 0 of the 5x5 through the 4x4 closed form.
+    int expanded = 0;
+    for (unsigned int n = 0; n < 5; n++) {
+        const int sign = (n % 2) ? -1 : 1;
+        expanded += sign * mat00[5 * n] * mat00.subMatrixAt(n, 0).determinant();
+    }
+    assert_equal(mat00.determinant(), expanded);
+    // A negative determinant of an unsigned matrix wraps as in the closed forms.
+    Mat<5, 5, unsigned int> swapped = Mat<5, 5, unsigned int>::identity();
+    swapped[0] = 0;
+    swapped[1] = 1;
+    swapped[5] = 1;
+    swapped[6] = 0;
+    assert_equal(swapped.determinant(), static_cast<unsigned int>(-1));
+    const unsigned int closed_form = swapped.subMatrixAt(4, 4).determinant();
+    assert_equal(closed_form, static_cast<unsigned int>(-1));
+
+    Mat<8, 8, double> mat10{};
+    for (unsigned int c = 0; c < 8; c++) {
+        for (unsigned int r = 0; r < 8; r++) {
+            mat10[c * 8 + r] = (r == c) ? 10.0 : 1.0 / (1 + r + 2 * c);
+        }
+    }
+    assert_close(mat10.cross(mat10.inverse()), (Mat<8, 8, double>::identity()),
+                 (Mat<8, 8, double>(1e-12)));
+    Vec<8, double> b(1, 2, 3, 4, 5, 6, 7, 8);
+    Vec<8, double> x = mat10.solve(b);
+    for (unsigned int r = 0; r < 8; r++) {
+        double sum = 0;
+        for (unsigned int c = 0; c < 8; c++) {
+            sum += mat10[c * 8 + r] * x[c];
+        }
+        assert_close(sum, b[r], 1e-12);
+    }
+
+    Mat<32, 32, float> mat20 = Mat<32, 32, float>::identity() * 2.0f;
+    assert_equal(mat20.determinant(), 4294967296.0f);
+
+    Mat5d singular{};
+    assert_equal(singular.determinant(), 0.0);
+    bool thrown = false;
+    try {
+        singular.inverse();
+    } catch (const std::domain_error &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+
+    constexpr Mat5d mat30 = Mat5d::identity() * 3.0;
+    static_assert(mat30.determinant() == 243.0);
+}
+
 TEST(DECOMPOSE) {
     Mat4f transform_without_rot0{2, 0, 0, 0, 0, 2, 0, 0, 0,
                      0, 2, 0, 1, 2, 3, 1
@@ -134,6 +280,65 @@ TEST(DECOMPOSE) {
 
 }
 
+TEST(EULER_COMPOSITION) {
+    const SinCos<double> sc = sincos(0.3);
+    assert_equal(sc.sin, std::sin(0.3));
+    assert_equal(sc.cos, std::cos(0.3));
+    assert_close((euler(0.3) * Vec2d(1, 0) - Vec2d(sc.cos, sc.sin)).length(), 0.0, 1e-15);
+
+    const double x = 0.4, y = -1.1, z = 2.3;
+    const Mat3d xyz = euler_x(x).cross(euler_y(y)).cross(euler_z(z));
+    const Mat3d zyx = euler_z(z).cross(euler_y(y)).cross(euler_x(x));
+    double worst = 0;
+    for (unsigned int i = 0; i < 9; i++) {
+        worst = std::max(worst, std::abs(euler_xyz(x, y, z)[i] - xyz[i]));
+        worst = std::max(worst, std::abs(euler_zyx(x, y, z)[i] - zyx[i]));
+    }
+    assert_close(worst, 0.0, 1e-15);
+    const Mat3f single = euler_zyx(0.4f, -1.1f, 2.3f);
+    assert_close(single.determinant(), 1.0f, 1e-6f);
+
+    // rotation() keeps its axis and matches the euler matrices on x and z.
+    const Vec3d axis = Vec3d(1, 2, -1).normalize();
+    const Vec4d kept = rotation(0.7, axis) * Vec4d(axis[0], axis[1], axis[2], 0);
+    assert_close((Vec3d(kept[0], kept[1], kept[2]) - axis).length(), 0.0, 1e-15);
+    const Vec4d about_x = rotation(0.7, Vec3d(1, 0, 0)) * Vec4d(0, 1, 0, 0);
+    const Vec3d expected_x = euler_x(0.7) * Vec3d(0, 1, 0);
+    assert_close((Vec3d(about_x[0], about_x[1], about_x[2]) - expected_x).length(), 0.0, 1e-15);
+    const Vec4d about_z = rotation(0.7, Vec3d(0, 0, 1)) * Vec4d(1, 0, 0, 0);
+    const Vec3d expected_z = euler_z(0.7) * Vec3d(1, 0, 0);
+    assert_close((Vec3d(about_z[0], about_z[1], about_z[2]) - expected_z).length(), 0.0, 1e-15);
+}
+
+TEST(OUTER_PRODUCT) {
+    // Column major: element (r, c) = left[r] * right[c].
+    assert_equal(outer_product(Vec3f(1, 2, 3), Vec3f(4, 5, 6)),
+                 (Mat3f{4, 8, 12, 5, 10, 15, 6, 12, 18}));
+}
+
+consteval Mat4f camera_projection() {
+    return perspective(16.0f / 9.0f, static_cast<float>(PI / 2), 0.1f, 100.0f);
+}
+TEST(CONSTEXPR) {
+    constexpr Mat4f identity = Mat4f::identity();
+    static_assert(identity[0] == 1.0f && identity[5] == 1.0f &&
+                  identity[1] == 0.0f);
+    constexpr Mat4f translation = translation3(1.0f, 2.0f, 3.0f);
+    static_assert(translation[12] == 1.0f && translation[14] == 3.0f);
+    static_assert(static_cast<bool>(translation.cross(identity) == translation));
+    static_assert(static_cast<bool>(Mat4f{Vec4f{1, 0, 0, 0}, Vec4f{0, 1, 0, 0},
+                                          Vec4f{0, 0, 1, 0},
+                                          Vec4f{0, 0, 0, 1}} == identity));
+    constexpr Mat4f ortho = orthgraphic(-1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 2.0f);
+    static_assert(ortho[0] == 1.0f && ortho[10] == -1.0f && ortho[14] == -1.0f);
+    constexpr Mat4f projection = camera_projection();
+    static_assert(projection[11] == -1.0f && projection[15] == 0.0f);
+    static_assert(Mat3f(6, 4, 2, 1, -2, 8, 1, 5, 7).determinant() == -306.0f);
+    static_assert(static_cast<bool>(Mat2f(1, 2, 3, 4).transpose() ==
+                                    Mat2f(1, 3, 2, 4)));
+    assert_equal(translation, translation3(1.0f, 2.0f, 3.0f));
+}
+
 TEST(BOOLEAN){
     Mat2f m0{0,0,0,0};
     Mat2f m1{1,0,0,0};
@@ -18,6 +18,21 @@ TEST(QUAT_BASIC_CONSTRUCTION) {
 
     Quat<float> q3 = q1; // copy
     assert_equal(q3, q1);
+
+    bool thrown = false;
+    try {
+        Quat<float> q4{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+    thrown = false;
+    try {
+        Quat<float> q5{1.0f, 2.0f};
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
 }
 
 
@@ -85,6 +100,27 @@ TEST(QUAT_TO_MATRIX) {
     // Similar matrix comparison
 }
 
+TEST(QUAT_ROTATE) {
+    // 90° around Z maps x onto y.
+    const Quat<float> z90 =
+        Quat<float>::from_axis_angle(static_cast<float>(PI / 2), Vec3f(0, 0, 1));
+    assert_close(z90.rotate(Vec3f(1, 0, 0)), Vec3f(0, 1, 0), Vec3f(1e-6f));
+
+    // Agrees with the rotation matrix, q v q* and to_mat3(), the axis need
+    // not be unit length.
+    const Vec3f axis(1, -2, 0.5f);
+    const Quat<float> q = Quat<float>::from_axis_angle(0.8f, axis);
+    const Mat3f r = rotation(0.8f, axis).to_mat3();
+    const Vec3f v(0.3f, 2.0f, -1.0f);
+    const Quat<float> sandwich = q.mul(Quat<float>(0, v)).mul(q.conjugate());
+    assert_close(q.rotate(v), r.cross(v), Vec3f(1e-5f));
+    assert_close(q.rotate(v), sandwich.vector(), Vec3f(1e-5f));
+    assert_close(q.to_mat3(), r, Mat3f(1e-6f));
+
+    constexpr Quat<double> x180(0, 1, 0, 0);
+    static_assert(static_cast<bool>(x180.rotate(Vec3d(1, 2, 3)) == Vec3d(1, -2, -3)));
+}
+
 TEST(QUAT_FROM_MATRIX) {
     // Identity rotation
     Mat<3,3,float> identity = Mat<3,3,float>::identity();
@@ -103,6 +139,17 @@ TEST(QUAT_SLERP) {
     assert_close(mid[1], static_cast<float>(std::sin(PI/4)), 1e-5f);
 }
 
+TEST(CONSTEXPR) {
+    constexpr Quat<float> identity = Quat<float>::identity();
+    static_assert(identity.mul(identity).scalar() == 1.0f);
+    static_assert(Quat<float>(1, 2, 3, 4).length2() == 30.0f);
+    static_assert(static_cast<bool>(Quat<float>{0.5f, 0.5f, 0.5f, 0.5f}.conjugate() ==
+                                    Quat<float>(0.5f, -0.5f, -0.5f, -0.5f)));
+    constexpr Mat3f basis = identity.to_mat3();
+    static_assert(static_cast<bool>(basis == Mat3f::identity()));
+    assert_equal(identity, Quat<float>(1, 0, 0, 0));
+}
+
 TEST(BOOLEAN){
     Quat<float> q0{1.0f, 0.0f, 0.0f, 0.0f}; // identity
     Quat<float> q1{0.0f, 0.0f, 0.0f, 0.0f}; // 180° around X
@@ -0,0 +1,164 @@
+#include "skinning.hpp"
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace smath;
+
+template <class T> struct Mesh {
+    std::vector<Vec<4, std::uint32_t>> bones;
+    std::vector<Vec<4, T>> weights;
+    std::vector<Vec<3, T>> positions;
+    std::vector<Vec<3, T>> normals;
+};
+// Four influences per vertex, one with zero weight every third vertex.
+template <class T> static Mesh<T> make_mesh(std::size_t count, std::uint32_t bones) {
+    Mesh<T> mesh;
+    for (std::size_t i = 0; i < count; i++) {
+        const std::uint32_t b = static_cast<std::uint32_t>(i);
+        mesh.bones.push_back(Vec<4, std::uint32_t>(b % bones, (b + 1) % bones,
+                                                   (b * 7) % bones, (b * 3 + 2) % bones));
+        const T w3 = (i % 3 == 0) ? T(0) : T(0.1);
+        mesh.weights.push_back(Vec<4, T>(T(0.5), T(0.3), T(0.2) - w3, w3));
+        mesh.positions.push_back(Vec<3, T>(static_cast<T>(i % 11) - 5,
+                                           static_cast<T>(i % 5), static_cast<T>(i % 3)));
+        mesh.normals.push_back(Vec<3, T>(1, static_cast<T>(i % 4), -1).normalize());
+    }
+    return mesh;
+}
+template <class T> static std::vector<DualQuat<T>> make_palette(std::uint32_t bones) {
+    std::vector<DualQuat<T>> palette;
+    for (std::uint32_t b = 0; b < bones; b++) {
+        const Quat<T> q =
+            Quat<T>::from_axis_angle(static_cast<T>(0.4) * b, Vec<3, T>(1, T(b % 3), 1));
+        const DualQuat<T> bone(q, Vec<3, T>(T(b), -T(b) / 2, 1));
+        // Odd bones stored on the other hemisphere, the blend must flip them.
+        palette.push_back(b % 2 ? -bone : bone);
+    }
+    return palette;
+}
+
+template <class T> static void check_dual_quat_skinning(T tolerance) {
+    constexpr std::uint32_t bone_count = 13;
+    const Mesh<T> mesh = make_mesh<T>(150, bone_count);
+    const std::vector<DualQuat<T>> palette = make_palette<T>(bone_count);
+    std::vector<Vec<3, T>> positions(mesh.positions.size());
+    std::vector<Vec<3, T>> normals(mesh.normals.size());
+    skin_dual_quat(palette,
+                   SkinStreams<T>{mesh.bones, mesh.weights, mesh.positions, mesh.normals},
+                   {positions, normals});
+    for (std::size_t i = 0; i < mesh.positions.size(); i++) {
+        const DualQuat<T> q[4] = {
+            palette[mesh.bones[i][0]], palette[mesh.bones[i][1]],
+            palette[mesh.bones[i][2]], palette[mesh.bones[i][3]]};
+        const T w[4] = {mesh.weights[i][0], mesh.weights[i][1], mesh.weights[i][2],
+                        mesh.weights[i][3]};
+        const DualQuat<T> blended =
+            blend(std::span<const DualQuat<T>>(q), std::span<const T>(w));
+        assert_close(positions[i], blended.transform_point(mesh.positions[i]),
+                     (Vec<3, T>(tolerance)));
+        assert_close(normals[i], blended.transform_vector(mesh.normals[i]),
+                     (Vec<3, T>(tolerance)));
+    }
+}
+
+TEST(DUAL_QUAT_SKINNING) {
+    check_dual_quat_skinning<float>(1e-5f);
+    check_dual_quat_skinning<double>(1e-12);
+
+    // Positions only, in parallel, matches the sequential result.
+    const Mesh<float> mesh = make_mesh<float>(1000, 5);
+    const std::vector<DualQuatf> palette = make_palette<float>(5);
+    const SkinStreams<float> streams{mesh.bones, mesh.weights, mesh.positions};
+    std::vector<Vec3f> seq(mesh.positions.size());
+    std::vector<Vec3f> par(mesh.positions.size());
+    skin_dual_quat(palette, streams, {seq});
+    skin_dual_quat(execution::par, palette, streams, {par});
+    assert_equal(seq[999], par[999]);
+}
+
+template <class T> static std::vector<Mat<4, 4, T>> make_matrices(std::uint32_t bones) {
+    std::vector<Mat<4, 4, T>> palette;
+    for (const DualQuat<T> &bone : make_palette<T>(bones)) {
+        palette.push_back(bone.to_mat4());
+    }
+    // One scaled bone, the normals must come out unit length anyway.
+    palette[0] = T(2) * palette[0];
+    return palette;
+}
+
+template <class T> static void check_linear_skinning(T tolerance) {
+    constexpr std::uint32_t bone_count = 13;
+    const Mesh<T> mesh = make_mesh<T>(150, bone_count);
+    const std::vector<Mat<4, 4, T>> palette = make_matrices<T>(bone_count);
+    std::vector<Vec<3, T>> positions(mesh.positions.size());
+    std::vector<Vec<3, T>> normals(mesh.normals.size());
+    skin_linear(palette,
+                SkinStreams<T>{mesh.bones, mesh.weights, mesh.positions, mesh.normals},
+                {positions, normals});
+    for (std::size_t i = 0; i < mesh.positions.size(); i++) {
+        Mat<4, 4, T> blended{};
+        for (unsigned int k = 0; k < 4; k++) {
+            blended += mesh.weights[i][k] * palette[mesh.bones[i][k]];
+        }
+        const Vec<4, T> p = blended * mesh.positions[i].expand(T(1));
+        const Vec<4, T> n = blended * mesh.normals[i].expand(T(0));
+        assert_close(positions[i], (Vec<3, T>(p[0], p[1], p[2])), (Vec<3, T>(tolerance)));
+        assert_close(normals[i], (Vec<3, T>(n[0], n[1], n[2]).normalize_or_zero()),
+                     (Vec<3, T>(tolerance)));
+    }
+}
+
+TEST(LINEAR_SKINNING) {
+    check_linear_skinning<float>(1e-4f);
+    check_linear_skinning<double>(1e-12);
+
+    // Positions only, in parallel, matches the sequential result.
+    const Mesh<float> mesh = make_mesh<float>(1000, 5);
+    const std::vector<Mat4f> palette = make_matrices<float>(5);
+    const SkinStreams<float> streams{mesh.bones, mesh.weights, mesh.positions};
+    std::vector<Vec3f> seq(mesh.positions.size());
+    std::vector<Vec3f> par(mesh.positions.size());
+    skin_linear(palette, streams, {seq});
+    skin_linear(execution::par, palette, streams, {par});
+    assert_equal(seq[999], par[999]);
+}
+
+TEST(SKINNING_ERRORS) {
+    const Mesh<float> mesh = make_mesh<float>(10, 4);
+    const std::vector<DualQuatf> palette = make_palette<float>(4);
+    std::vector<Vec3f> out(9);
+    bool thrown = false;
+    try {
+        skin_dual_quat(palette, SkinStreams<float>{mesh.bones, mesh.weights, mesh.positions},
+                       {out});
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+    thrown = false;
+    std::vector<Vec3f> positions(10);
+    std::vector<Vec3f> normals(10);
+    try {
+        // Normals out without normals in.
+        skin_linear(make_matrices<float>(4),
+                    SkinStreams<float>{mesh.bones, mesh.weights, mesh.positions},
+                    {positions, normals});
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+#if SMATH_CHECKED
+    out.resize(10);
+    thrown = false;
+    try {
+        skin_dual_quat(std::span<const DualQuatf>(palette).first(3),
+                       SkinStreams<float>{mesh.bones, mesh.weights, mesh.positions}, {out});
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+#endif
+}
+int main() { return TestRunner::instance().run("Skinning"); }
@@ -39,24 +39,21 @@ struct TestCase {
 };
 class Timer {
   private:
-    std::chrono::time_point<std::chrono::system_clock> start_time;
-    std::chrono::time_point<std::chrono::system_clock> stop_time;
+    // Monotonic, unlike system_clock which may jump while timing.
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point stop_time;
 
   public:
     Timer() = default;
-    void start() { start_time = std::chrono::high_resolution_clock::now(); }
-    void stop() { stop_time = std::chrono::high_resolution_clock::now(); }
+    void start() { start_time = std::chrono::steady_clock::now(); }
+    void stop() { stop_time = std::chrono::steady_clock::now(); }
+    /**
+     * @return Microseconds between start() and stop().
+     */
     const long get_duration() const {
-        auto start_in_milli =
-            std::chrono::time_point_cast<std::chrono::microseconds>(start_time)
-                .time_since_epoch()
-                .count();
-        auto end_in_milli =
-            std::chrono::time_point_cast<std::chrono::microseconds>(stop_time)
-                .time_since_epoch()
-                .count();
-        long duration = end_in_milli - start_in_milli;
-        return duration;
+        return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     stop_time - start_time)
+                                     .count());
     }
 };
 class TestRunner {
@@ -0,0 +1,125 @@
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include "transform.hpp"
+#include <vector>
+
+using namespace smath;
+
+static std::vector<Vec3f> make_points(unsigned int count) {
+    std::vector<Vec3f> points;
+    for (unsigned int i = 0; i < count; i++) {
+        points.push_back(Vec3f(static_cast<float>(i % 13) - 6.0f,
+                               static_cast<float>(i % 7) * 0.5f,
+                               static_cast<float>(i % 5) - 2.0f));
+    }
+    return points;
+}
+
+TEST(TRANSFORM_POINTS) {
+    const Mat4f m = translation3(1.0f, -2.0f, 3.0f)
+                        .cross(rotation(0.4f, Vec3f(0, 1, 1)))
+                        .cross(scale3(2.0f, 1.0f, 0.5f).to_homogeneous());
+    // 150 spans two full chunks, a partial one and a scalar tail.
+    const std::vector<Vec3f> points = make_points(150);
+    std::vector<Vec3f> out(points.size());
+    transform_points(m, points, out);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        const Vec4f expected = m * points[i].expand(1.0f);
+        assert_close(out[i], Vec3f(expected[0], expected[1], expected[2]),
+                     Vec3f(1e-5f));
+    }
+    std::vector<Vec3f> in_place = points;
+    transform_points(m, in_place);
+    assert_equal(in_place[149], out[149]);
+
+    bool thrown = false;
+    try {
+        std::vector<Vec3f> shorter(3);
+        transform_points(m, points, shorter);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+
+TEST(TRANSFORM_PROJECTED_POINTS) {
+    const Mat4d projection = perspective(1.5, PI / 2, 0.1, 100.0);
+    std::vector<Vec3d> points{Vec3d(1, 2, -5), Vec3d(-3, 0.5, -20),
+                              Vec3d(0, 0, -0.1)};
+    std::vector<Vec3d> out(points.size());
+    transform_points(projection, points, out);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        const Vec4d clip = projection * points[i].expand(1.0);
+        assert_close(out[i], Vec3d(clip[0], clip[1], clip[2]) / clip[3],
+                     Vec3d(1e-12));
+    }
+    assert_close(out[2][2], -1.0, 1e-12);
+}
+
+TEST(TRANSFORM_VECTORS_NORMALS) {
+    const Mat4f m = translation3(5.0f, 5.0f, 5.0f)
+                        .cross(scale3(2.0f, 1.0f, 1.0f).to_homogeneous());
+    std::vector<Vec3f> vectors{Vec3f(1, 1, 0), Vec3f(0, 0, 2)};
+    transform_vectors(m, vectors);
+    assert_equal(vectors[0], Vec3f(2, 1, 0));
+    assert_equal(vectors[1], Vec3f(0, 0, 2));
+
+    // The normal of the plane x = y must stay perpendicular to it.
+    std::vector<Vec3f> normals{Vec3f(1, -1, 0), Vec3f(0, 0, 0)};
+    transform_normals(m, normals);
+    assert_close(normals[0].dot(Vec3f(2, 1, 0)), 0.0f, 1e-6f);
+    assert_close(normals[0].length(), 1.0f, 1e-6f);
+    assert_equal(normals[1], Vec3f(0, 0, 0));
+}
+
+TEST(TRANSFORM_VEC_ARRAY) {
+    const Mat4f m = translation3(1.0f, 2.0f, 3.0f)
+                        .cross(rotation(1.2f, Vec3f(1, 0, 0)));
+    const std::vector<Vec3f> points = make_points(70);
+    std::vector<Vec3f> expected(points.size());
+    transform_points(m, points, expected);
+
+    VecArray3f soa{std::span<const Vec3f>(points)};
+    VecArray3f out;
+    transform_points(m, soa, out);
+    transform_points(m, soa, soa);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        assert_close(out[i], expected[i], Vec3f(1e-5f));
+        assert_equal(soa[i], out[i]);
+    }
+    transform_vectors(m, soa, out);
+    transform_normals(m, soa, out);
+    assert_close(out[3].length(), 1.0f, 1e-5f);
+}
+
+TEST(ROTATE_VECTORS) {
+    const std::vector<Vec3f> vectors = make_points(150);
+    std::vector<Quat<float>> rotations;
+    for (unsigned int i = 0; i < vectors.size(); i++) {
+        const float half = 0.05f * static_cast<float>(i);
+        const Vec3f axis = Vec3f(1, static_cast<float>(i % 3), -1).normalize();
+        rotations.push_back(Quat<float>(std::cos(half), axis * std::sin(half)));
+    }
+    std::vector<Vec3f> out(vectors.size());
+    rotate_vectors(rotations, vectors, out);
+    for (unsigned int i = 0; i < vectors.size(); i++) {
+        assert_close(out[i], rotations[i].rotate(vectors[i]), Vec3f(1e-5f));
+    }
+
+    // One quaternion for every vector, in place.
+    std::vector<Vec3f> inplace = vectors;
+    rotate_vectors(rotations[17], inplace);
+    assert_close(inplace[149], rotations[17].rotate(vectors[149]), Vec3f(1e-5f));
+
+    std::vector<Vec3f> short_out(3);
+    bool thrown = false;
+    try {
+        rotate_vectors(rotations, std::span<const Vec3f>(vectors).first(3),
+                       short_out);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+
+int main() { return TestRunner::instance().run("Transform Test"); }
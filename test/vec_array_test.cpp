@@ -0,0 +1,83 @@
+#include "smath.hpp"
+#include "test_tool.hpp"
+#include "vec_array.hpp"
+
+using namespace smath;
+
+TEST(AOS_CONVERSION) {
+    std::vector<Vec3f> aos{Vec3f(1, 2, 3), Vec3f(4, 5, 6), Vec3f(7, 8, 9)};
+    VecArray3f soa{std::span<const Vec3f>(aos)};
+    assert_equal(soa.size(), static_cast<std::size_t>(3));
+    assert_equal(soa[1], Vec3f(4, 5, 6));
+    assert_equal(soa.component(2)[2], 9.0f);
+
+    soa.set(0, Vec3f(-1, -2, -3));
+    std::vector<Vec3f> back = soa.to_aos();
+    assert_equal(back[0], Vec3f(-1, -2, -3));
+    assert_equal(back[2], Vec3f(7, 8, 9));
+
+    soa.push_back(Vec3f(0, 0, 1));
+    assert_equal(soa.size(), static_cast<std::size_t>(4));
+    assert_equal(soa[3], Vec3f(0, 0, 1));
+}
+
+TEST(ELEMENT_WISE) {
+    VecArray4f a(37, Vec4f(1, 2, 3, 4));
+    VecArray4f b(37, Vec4f(4, 3, 2, 1));
+    assert_equal((a + b)[36], Vec4f(5, 5, 5, 5));
+    assert_equal((a - b)[0], Vec4f(-3, -1, 1, 3));
+    assert_equal((a * b)[17], Vec4f(4, 6, 6, 4));
+    assert_equal((a * 2.0f)[5], Vec4f(2, 4, 6, 8));
+    assert_equal((a / 2.0f)[5], Vec4f(0.5f, 1, 1.5f, 2));
+    a += Vec4f(1, 1, 1, 1);
+    assert_equal(a[20], Vec4f(2, 3, 4, 5));
+}
+
+TEST(DOT_LENGTH_NORMALIZE) {
+    std::vector<Vec3f> aos;
+    for (unsigned int i = 0; i < 21; i++) {
+        aos.push_back(Vec3f(static_cast<float>(i), 4.0f, 3.0f));
+    }
+    VecArray3f soa{std::span<const Vec3f>(aos)};
+    std::vector<float> dots = soa.dot(soa);
+    std::vector<float> lengths = soa.length();
+    for (unsigned int i = 0; i < 21; i++) {
+        assert_equal(dots[i], aos[i].length2());
+        assert_close(lengths[i], aos[i].length(), 1e-5f);
+    }
+    assert_equal(lengths[0], 5.0f);
+
+    VecArray3f unit = soa.normalize();
+    for (unsigned int i = 0; i < 21; i++) {
+        assert_close(unit[i].length(), 1.0f, 1e-5f);
+    }
+    VecArray3f with_zero(2);
+    with_zero.set(1, Vec3f(0, 3, 4));
+    assert_equal(with_zero.normalize_or_zero()[0], Vec3f(0, 0, 0));
+    assert_equal(with_zero.normalize_or_zero()[1], Vec3f(0, 0.6f, 0.8f));
+    bool thrown = false;
+    try {
+        with_zero.normalize();
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+}
+
+TEST(CROSS_PRODUCT) {
+    VecArray3f a(9, Vec3f(1, 2, 3));
+    VecArray3f b(9, Vec3f(-1, 2, 0));
+    assert_equal(a.cross(b)[8], Vec3f(-6, -3, 4));
+}
+
+TEST(CLAMP_SATURATE_MIX) {
+    VecArray3f a(11, Vec3f(-1.0f, 0.5f, 2.0f));
+    VecArray3f b(11, Vec3f(1.0f, 1.5f, 4.0f));
+    assert_equal(saturate(a)[10], Vec3f(0.0f, 0.5f, 1.0f));
+    assert_equal(clamp(a, -0.5f, 1.0f)[3], Vec3f(-0.5f, 0.5f, 1.0f));
+    assert_equal(clamp(a, Vec3f(0, 0, 0), Vec3f(1, 0.25f, 3))[0],
+                 Vec3f(0.0f, 0.25f, 2.0f));
+    assert_equal(mix(a, b, 0.5f)[7], Vec3f(0.0f, 1.0f, 3.0f));
+}
+
+int main() { return TestRunner::instance().run("VecArray Test"); }
@@ -30,6 +30,38 @@ TEST(SWIZZLING){
     assert_equal(a1,b1);
     assert_equal(a2,b2);
 }
+template <class V> concept can_swizzle_w = requires(V v) { v.template swizzle<3>(); };
+template <class T> static void check_swizzle() {
+    using V2 = Vec<2, T>;
+    using V3 = Vec<3, T>;
+    using V4 = Vec<4, T>;
+    const V4 v(1, 2, 3, 4);
+    const V3 u(5, 6, 7);
+    const V4 reversed = v.template swizzle<3, 2, 1, 0>();
+    const V3 rotated = v.template swizzle<2, 0, 1>();
+    const V3 flipped = u.template swizzle<0, 2, 1>();
+    const V4 widened = u.template swizzle<2, 2, 0, 1>();
+    const V2 odd = v.template swizzle<1, 3>();
+    assert_equal(reversed, V4(4, 3, 2, 1));
+    assert_equal(rotated, V3(3, 1, 2));
+    assert_equal(flipped, V3(5, 7, 6));
+    assert_equal(widened, V4(7, 7, 5, 6));
+    assert_equal(odd, V2(2, 4));
+    assert_equal(v.xyz(), V3(1, 2, 3));
+    assert_equal(u.xy(), V2(5, 6));
+    assert_equal(v.w(), T(4));
+}
+TEST(COMPILE_TIME_SWIZZLING) {
+    check_swizzle<float>();
+    check_swizzle<double>();
+    check_swizzle<int>();
+    static_assert(static_cast<bool>(Vec3f(1, 2, 3).swizzle<2, 1, 0>() == Vec3f(3, 2, 1)));
+    static_assert(static_cast<bool>(Vec4d(1, 2, 3, 4).swizzle<0, 0, 3>() == Vec3d(1, 1, 4)));
+    static_assert(can_swizzle_w<Vec4f> && !can_swizzle_w<Vec3f>);
+    Vec3f p(1, 2, 3);
+    p.z() = 5;
+    assert_equal(p, Vec3f(1, 2, 5));
+}
 TEST(NORMALISE) {
     assert_equal(Vec3f(0, 0, 0).normalize_or_zero(), Vec3f(0, 0, 0)); // zero vector stays zero
     assert_close(Vec3f(3, 4, 0).normalize_or_zero().length(), 1.0f, 0.0001f);
@@ -110,6 +142,96 @@ TEST(NEGATION_AND_ASSIGNMENT) {
     assert_equal(v, Vec3f(1, -2, 3));
 }
 
+TEST(SIMD_WIDTHS) {
+    assert_equal(Vec4f(1, 2, 3, 4) + Vec4f(4, 3, 2, 1), Vec4f(5, 5, 5, 5));
+    assert_equal(Vec4f(1, 2, 3, 4) * Vec4f(2, 2, 2, 2), Vec4f(2, 4, 6, 8));
+    assert_equal(-Vec4f(1, -2, 3, -4), Vec4f(-1, 2, -3, 4));
+    assert_equal(Vec4f(1, 2, 3, 4).dot(Vec4f(1, 1, 1, 1)), 10.0f);
+    assert_equal(Vec4d(1, 2, 3, 4) - Vec4d(1, 1, 1, 1), Vec4d(0, 1, 2, 3));
+    assert_equal(Vec4d(2, 4, 6, 8) / 2.0, Vec4d(1, 2, 3, 4));
+    assert_equal(Vec4d(0, 3, 0, 4).length(), 5.0);
+    assert_equal(Vec3d(1, 2, 3) * 2.0, Vec3d(2, 4, 6));
+    assert_equal(Vec3d(1, 2, 3).dot(Vec3d(4, -5, 6)), 12.0);
+    assert_equal(Vec3d(1, 2, 3).cross(Vec3d(-1, 2, 0)), Vec3d(-6, -3, 4));
+    assert_close(Vec3d(3, 4, 0).normalize().length(), 1.0, 1e-12);
+
+    Vec4f v(1, 2, 3, 4);
+    v += Vec4f(1, 1, 1, 1);
+    v *= 2.0f;
+    assert_equal(v, Vec4f(4, 6, 8, 10));
+    Vec3f w(1, 2, 3);
+    w -= Vec3f(1, 1, 1);
+    assert_equal(w, Vec3f(0, 1, 2));
+}
+
+TEST(ELEMENT_ACCESS) {
+    Vec3f v(1, 2, 3);
+    v.unchecked(0) = 4.0f;
+    assert_equal(v.unchecked(0), 4.0f);
+    assert_equal(v[2], 3.0f);
+#if SMATH_CHECKED
+    bool thrown = false;
+    try {
+        v[3] = 0.0f;
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert_equal(thrown, true);
+#endif
+}
+
+TEST(CONSTEXPR) {
+    constexpr Vec3f a(1, 2, 3);
+    constexpr Vec3f b{4, -5, 6};
+    static_assert(a.dot(b) == 12.0f);
+    static_assert((a + b == Vec3f(5, -3, 9)).all());
+    static_assert((a.cross(Vec3f(-1, 2, 0)) == Vec3f(-6, -3, 4)).all());
+    static_assert((-a * 2.0f == Vec3f(-2, -4, -6)).all());
+    static_assert(Vec4f(0, 3, 0, 4).length() == 5.0f);
+    constexpr Vec4d lookup[] = {Vec4d(1.0), Vec4d(2.0)};
+    static_assert(lookup[1][3] == 2.0);
+    assert_equal(a.dot(b), 12.0f);
+}
+
+TEST(LAZY_EXPRESSION) {
+    Vec4f a(1, 2, 3, 4), b(4, 3, 2, 1), c(1, 1, 1, 1);
+    Vec4f r = lazy(a) * 2.0f + b - c;
+    assert_equal(r, a * 2.0f + b - c);
+    r = -lazy(a) / 2.0f + b * c;
+    assert_equal(r, Vec4f(3.5f, 2.0f, 0.5f, -1.0f));
+    r += lazy(a) * c;
+    assert_equal(r, Vec4f(4.5f, 4.0f, 3.5f, 3.0f));
+    r = lazy(r) - r;
+    assert_equal(r, Vec4f(0, 0, 0, 0));
+
+    // Temporaries are copied into the expression, named Vecs referenced.
+    auto kept = lazy(a) + (b + c);
+    static_assert(std::is_same_v<decltype(kept),
+                                 VecBinary<VecLeaf<4, float>, VecValue<4, float>, std::plus<>>>);
+    r = kept;
+    assert_equal(r, Vec4f(6, 6, 6, 6));
+
+    using Vec32d = Vec<32, double>;
+    Vec32d big(1.0);
+    Vec32d fused = 3.0 * lazy(big) - big / 2.0 + big;
+    assert_equal(fused, Vec32d(3.5));
+
+    constexpr Vec3f x(1, 2, 3);
+    constexpr Vec3f y = lazy(x) * 2.0f - x;
+    static_assert((y == x).all());
+
+    assert_equal(mix(Vec3f(0, 0, 0), Vec3f(2, 4, 6), 0.5f), Vec3f(1, 2, 3));
+    assert_equal(reflect(Vec3f(1, -1, 0), Vec3f(0, 1, 0)), Vec3f(1, 1, 0));
+    // Straight through at ratio 1, bent towards the normal entering water.
+    assert_close(refract(Vec3f(0.6f, -0.8f, 0), Vec3f(0, 1, 0), 1.0f),
+                 Vec3f(0.6f, -0.8f, 0), Vec3f(1e-6f));
+    const Vec3f bent = refract(Vec3f(0.6f, -0.8f, 0), Vec3f(0, 1, 0), 1.0f, 1.33f);
+    assert_close(bent[0], 0.6f / 1.33f, 1e-6f);
+    assert_close(bent.length(), 1.0f, 1e-6f);
+    // Total internal reflection leaving water at a grazing angle.
+    assert_equal(refract(Vec3f(0.8f, 0.6f, 0), Vec3f(0, -1, 0), 1.33f), Vec3f(0, 0, 0));
+}
+
 TEST(BOOLEAN){
     Vec3f v0(1.0f,0.0f,1.0f);
 